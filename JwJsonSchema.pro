@@ -1,4 +1,4 @@
-QT       += core
+QT       += core concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -8,14 +8,44 @@
 #include <QStringList>
 #include <QMap>
 #include <QVariant>
+#include <QCborValue>
+#include <QCborMap>
+#include <QCborArray>
 #include <QSet>
-#include <QScopedPointer>
 #include <QRegularExpression>
 #include <QtMath>
 #include <QUrl>
 #include <QFile>
+#include <QDir>
 #include <QByteArray>
+#include <QBitArray>
 #include <QJsonParseError>
+#include <QHash>
+#include <QCache>
+#include <QVector>
+#include <QVarLengthArray>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QScopedPointer>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QDeadlineTimer>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QThread>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#ifndef SWJSONSCHEMA_NO_CONCURRENT
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+#endif
+#include <algorithm>
 
 /**
  * @brief Forward declaration pour SwJsonSchema (utilisé par le registry).
@@ -42,13 +72,15 @@ public:
     // Constructeur de copie
     KeywordJsonValidator(const KeywordJsonValidator& other)
         : m_validator(other.m_validator),
-        m_jsonSchemaValidator(other.m_jsonSchemaValidator) {}
+        m_jsonSchemaValidator(other.m_jsonSchemaValidator),
+        m_keyword(other.m_keyword) {}
 
     // Opérateur d'affectation
     KeywordJsonValidator& operator=(const KeywordJsonValidator& other) {
         if (this != &other) {
             m_validator = other.m_validator;
             m_jsonSchemaValidator = other.m_jsonSchemaValidator;
+            m_keyword = other.m_keyword;
         }
         return *this;
     }
@@ -58,6 +90,20 @@ public:
         m_jsonSchemaValidator = rules;
     }
 
+    // Règles JSON du validateur
+    QJsonValue rules() const {
+        return m_jsonSchemaValidator;
+    }
+
+    // Mot-clé auquel le validateur est attaché
+    void setKeyword(const QString& keyword) {
+        m_keyword = keyword;
+    }
+
+    QString keyword() const {
+        return m_keyword;
+    }
+
     // Valide les données selon les règles et le validateur
     bool validate(const QJsonValue& data, QString* erreur) const {
         return m_validator(m_jsonSchemaValidator, data, erreur);
@@ -74,1492 +120,7922 @@ public:
 private:
     Validator m_validator;          ///< Fonction de validation
     QJsonValue m_jsonSchemaValidator; ///< Règles JSON du validateur
+    QString m_keyword;                ///< Mot-clé personnalisé
 };
 
 
 /**
- * @brief Classe de registre pour les schémas JSON.
+ * @brief Compteurs de profilage attachés à un noeud de schéma.
  *
- * Permet de stocker et de retrouver des SwJsonSchema par leur $id et/ou $anchor.
- * Gère également la résolution basique de $ref du style "<id>#anchor" ou "#anchor".
+ * Un noeud est identifié par son "keyword location" : l'URI de base du document
+ * suivie d'un JSON Pointer vers le sous-schéma (ex: "main.json#/properties/age").
  */
-class SwJsonSchemaRegistry
+struct SwJsonSchemaProfileEntry
+{
+    QString keywordLocation;
+    QAtomicInteger<quint64> invocations;  ///< Nombre d'évaluations du noeud
+    QAtomicInteger<quint64> failures;     ///< Nombre d'évaluations en échec
+    QAtomicInteger<quint64> totalNs;      ///< Temps cumulé, sous-schémas inclus
+    QAtomicInteger<quint64> selfNs;       ///< Temps cumulé, sous-schémas exclus
+    QAtomicInteger<quint64> allocations;  ///< Allocations effectuées par le validateur pour ce noeud
+};
+
+
+/**
+ * @brief Profileur global des validations SwJsonSchema.
+ *
+ * Désactivé par défaut : le coût se limite alors à un test de booléen (branche prédite)
+ * à l'entrée de chaque noeud. Définir SWJSONSCHEMA_NO_PROFILING à la compilation
+ * supprime totalement l'instrumentation.
+ *
+ * Les "allocations" comptées sont celles que le validateur effectue lui-même
+ * (compilations d'expressions régulières).
+ */
+class SwJsonSchemaProfiler
 {
 public:
-    SwJsonSchemaRegistry() = default;
-    ~SwJsonSchemaRegistry() = default;
+    struct HotSpot {
+        QString keywordLocation;
+        quint64 invocations = 0;
+        quint64 failures    = 0;
+        quint64 totalNs     = 0;
+        quint64 selfNs      = 0;
+        quint64 allocations = 0;
+    };
 
-    void registerSchemaByAnchor(const QString &fullAnchor, SwJsonSchema *schema)
+    static SwJsonSchemaProfiler &instance()
     {
-        if (!fullAnchor.isEmpty()) {
-            m_schemasByAnchor[fullAnchor] = schema;
-        }
+        static SwJsonSchemaProfiler profiler;
+        return profiler;
     }
 
-    void registerSchemaByRef(const QString &path, SwJsonSchema *schema)
+#ifdef SWJSONSCHEMA_NO_PROFILING
+    static constexpr bool isEnabled() { return false; }
+    static void setEnabled(bool) {}
+#else
+    static bool isEnabled() { return enabledFlag().loadRelaxed() != 0; }
+    static void setEnabled(bool enabled) { enabledFlag().storeRelaxed(enabled ? 1 : 0); }
+#endif
+
+    /**
+     * @brief Retourne (en le créant si besoin) l'entrée associée à un keyword location.
+     *        Le pointeur reste valide pendant toute la durée du programme.
+     */
+    SwJsonSchemaProfileEntry *entry(const QString &keywordLocation)
     {
-        if (!path.isEmpty()) {
-            m_schemasByRef[path] = schema;
+        QMutexLocker locker(&m_mutex);
+        QSharedPointer<SwJsonSchemaProfileEntry> &e = m_entries[keywordLocation];
+        if (!e) {
+            e.reset(new SwJsonSchemaProfileEntry());
+            e->keywordLocation = keywordLocation;
         }
+        return e.data();
     }
 
     /**
-     * @brief Tente de résoudre une référence "$ref".
-     *        ex: "https://example.com/sch1#someAnchor"
-     *            "#/defs/foo"
-     *            "#myAnchor"
-     * @return Le schéma pointé, ou nullptr si introuvable.
+     * @brief Remet tous les compteurs à zéro (les entrées sont conservées).
      */
-    SwJsonSchema* resolveRef(const QString &ref, const QString &baseUri, bool &found) const
+    void reset()
     {
-        found = true;
-        // Résolution simplifiée : on coupe autour du '#'
-        QString localBaseURI = baseUri.split("/").last();
-        QString localRef = ref;
-        if (localRef.startsWith(baseUri)) {
-            localRef.remove(0, baseUri.length()); // Supprime uniquement la première occurrence au début
-        }
-        if (localRef.startsWith(localBaseURI)) {
-            localRef.remove(0, localBaseURI.length()); // Supprime uniquement la première occurrence au début
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            it.value()->invocations.storeRelaxed(0);
+            it.value()->failures.storeRelaxed(0);
+            it.value()->totalNs.storeRelaxed(0);
+            it.value()->selfNs.storeRelaxed(0);
+            it.value()->allocations.storeRelaxed(0);
         }
+    }
 
-
-        if(m_schemasByAnchor.contains(localRef)){
-            return m_schemasByAnchor.value(localRef);
-        }
-        QString anchor;
-        QString idPart = ref;
-        if (ref.contains('#')) {
-            int idx = ref.indexOf('#');
-            idPart = ref.left(idx).trimmed();
-            anchor = ref.mid(idx + 1).trimmed(); // sans le '#'
-        }
-
-        // 1) Si idPart est vide => on cherche "#anchor" direct
-        if (idPart.isEmpty()) {
-            QString fullAnchor = "#" + anchor;
-            QString fullLocalAnchor = baseUri + "#" + anchor;
-            if(m_schemasByAnchor.contains(fullAnchor)){
-                return m_schemasByAnchor.value(fullAnchor);
-            }
-
-            if(m_schemasByAnchor.contains(fullLocalAnchor)){
-                return m_schemasByAnchor.value(fullLocalAnchor);
+    /**
+     * @brief Noeuds classés par temps propre décroissant.
+     * @param limit Nombre maximal d'entrées (-1 = toutes)
+     */
+    QList<HotSpot> hotSpots(int limit = -1) const
+    {
+        QList<HotSpot> spots;
+        {
+            QMutexLocker locker(&m_mutex);
+            for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+                const SwJsonSchemaProfileEntry *e = it.value().data();
+                if (e->invocations.loadRelaxed() == 0) {
+                    continue;
+                }
+                HotSpot spot;
+                spot.keywordLocation = e->keywordLocation;
+                spot.invocations = e->invocations.loadRelaxed();
+                spot.failures    = e->failures.loadRelaxed();
+                spot.totalNs     = e->totalNs.loadRelaxed();
+                spot.selfNs      = e->selfNs.loadRelaxed();
+                spot.allocations = e->allocations.loadRelaxed();
+                spots.append(spot);
             }
         }
+        std::sort(spots.begin(), spots.end(), [](const HotSpot &a, const HotSpot &b) {
+            return a.selfNs > b.selfNs;
+        });
+        if (limit >= 0 && spots.size() > limit) {
+            spots = spots.mid(0, limit);
+        }
+        return spots;
+    }
 
-        // 4) Sinon, on teste "idPart#anchor"
-        QString fullAnchor = baseUri + "#" + anchor;
-        if (m_schemasByAnchor.contains(fullAnchor)) {
-            return m_schemasByAnchor.value(fullAnchor);
+    /**
+     * @brief Rapport texte des points chauds, un noeud par ligne.
+     */
+    QString report(int limit = 20) const
+    {
+        QStringList lines;
+        lines << QString("%1 %2 %3 %4 %5  %6")
+                     .arg("self(us)", 10).arg("total(us)", 10).arg("calls", 8)
+                     .arg("fails", 8).arg("allocs", 8).arg("keywordLocation");
+        for (const HotSpot &spot : hotSpots(limit)) {
+            lines << QString("%1 %2 %3 %4 %5  %6")
+                         .arg(QString::number(spot.selfNs / 1000.0, 'f', 1), 10)
+                         .arg(QString::number(spot.totalNs / 1000.0, 'f', 1), 10)
+                         .arg(QString::number(spot.invocations), 8)
+                         .arg(QString::number(spot.failures), 8)
+                         .arg(QString::number(spot.allocations), 8)
+                         .arg(spot.keywordLocation);
         }
+        return lines.join("\n");
+    }
 
-        foreach(auto key, m_schemasByRef.keys()){
-            if(idPart != "" && key.endsWith(idPart)){
-                found = false;
-                return m_schemasByRef.value(key);
+    /**
+     * @brief Comptabilise une allocation sur le noeud en cours d'évaluation (thread courant).
+     */
+    static void countAllocation(int count = 1)
+    {
+        if (Q_UNLIKELY(isEnabled())) {
+            SwJsonSchemaProfileEntry *current = currentEntry();
+            if (current) {
+                current->allocations.fetchAndAddRelaxed(count);
             }
         }
+    }
 
-        return nullptr;
+    /// Noeud en cours d'évaluation sur le thread courant.
+    static SwJsonSchemaProfileEntry *&currentEntry()
+    {
+        static thread_local SwJsonSchemaProfileEntry *current = nullptr;
+        return current;
+    }
+
+    /// Temps passé dans les sous-noeuds du noeud courant (thread courant).
+    static quint64 &childNs()
+    {
+        static thread_local quint64 ns = 0;
+        return ns;
     }
 
 private:
-    QMap<QString, SwJsonSchema*> m_schemasByAnchor;  ///< Map "id#anchor" ou "#anchor" -> schéma
-    QMap<QString, SwJsonSchema*> m_schemasByRef;     ///< Map "path" -> schéma
+    SwJsonSchemaProfiler() = default;
+
+#ifndef SWJSONSCHEMA_NO_PROFILING
+    static QAtomicInt &enabledFlag()
+    {
+        static QAtomicInt flag(0);
+        return flag;
+    }
+#endif
+
+    mutable QMutex m_mutex;
+    QHash<QString, QSharedPointer<SwJsonSchemaProfileEntry>> m_entries;
 };
 
 
 /**
- * @brief Classe SwJsonSchema : représente un schéma JSON, capable de valider un QJsonValue.
+ * @brief Trace complète d'une validation : un événement par noeud de schéma évalué.
  *
- * - Un **seul** constructeur public : prend un chemin (ou URL) vers un fichier JSON Schema.
- * - Lit le fichier local, parse le JSON, et charge récursivement les sous-schemas.
- * - Gère $id, $anchor, $ref (résolution via un registry, si fourni).
- * - Gère if/then/else, allOf/anyOf/oneOf, etc.
- * - Évite les boucles de référence via un set de "visited".
+ * Chaque événement porte le keyword location du noeud (ou du combinateur allOf / anyOf /
+ * oneOf / if), le JSON Pointer de l'instance évaluée, l'horodatage et le résultat.
+ * Exports disponibles :
+ *  - toChromeTraceJson() : format "Trace Event" (chrome://tracing, Perfetto, speedscope) ;
+ *  - toFoldedStacks()    : format "folded stacks" (flamegraph.pl, inferno), temps propre en ns.
+ *
+ * Une trace n'est pas partagée entre threads : une instance par validation.
  */
-class SwJsonSchema
+class SwJsonSchemaTrace
 {
 public:
-
-    enum class SchemaType {
-        Invalid,
-        String,
-        Number,
-        Integer,
-        Boolean,
-        Object,
-        Array,
-        Null
+    struct Event {
+        QString name;              ///< Keyword location du noeud évalué
+        QString instanceLocation;  ///< JSON Pointer de l'instance ("" = racine)
+        qint64  startNs    = 0;    ///< Début, relatif au démarrage de la trace
+        qint64  durationNs = 0;
+        bool    valid      = true;
+        int     parent     = -1;   ///< Index de l'événement englobant (-1 = racine)
     };
 
+    SwJsonSchemaTrace()
+    {
+        m_timer.start();
+    }
+
+    void clear()
+    {
+        m_events.clear();
+        m_open = -1;
+        m_timer.restart();
+    }
+
+    const QList<Event> &events() const
+    {
+        return m_events;
+    }
+
     /**
-     * @brief Constructeur unique : charge le schéma depuis un chemin (ou URL) `schemaPath`.
-     * @param schemaPath  Chemin local ou URL
-     * @param registry    Pointeur vers un registre de schémas (optionnel)
+     * @brief Ouvre un événement, imbriqué dans l'événement courant.
+     * @return Index de l'événement, à passer à end()
      */
-    explicit SwJsonSchema(const QString &schemaPath, SwJsonSchema *parent = nullptr)
-        : m_parent(parent), m_baseUri(schemaPath)
+    int begin(const QString &name, const QString &instanceLocation)
     {
-        if(parent){
-            m_baseUri = resolveUri(parent, schemaPath);
-        }
-        // Tente d’ouvrir le fichier local
-        // (si vous gérez des URLs http(s), adapter ici)
-        QUrl url(schemaPath);
-        QString localFile = url.isLocalFile() ? url.toLocalFile() : schemaPath;
-
-        QFile f(localFile);
-        if (!f.open(QIODevice::ReadOnly)) {
-            // Erreur : on pourrait stocker un message d’erreur ou laisser un schéma "vide".
-            return;
-        }
+        Event e;
+        e.name = name;
+        e.instanceLocation = instanceLocation;
+        e.startNs = m_timer.nsecsElapsed();
+        e.parent = m_open;
+        m_events.append(e);
+        m_open = m_events.size() - 1;
+        return m_open;
+    }
 
-        QByteArray data = f.readAll();
-        f.close();
+    void end(int index, bool valid)
+    {
+        Event &e = m_events[index];
+        e.durationNs = m_timer.nsecsElapsed() - e.startNs;
+        e.valid = valid;
+        m_open = e.parent;
+    }
 
-        QJsonParseError jerr;
-        QJsonDocument doc = QJsonDocument::fromJson(data, &jerr);
-        if (jerr.error != QJsonParseError::NoError) {
-            // Erreur de parsing JSON
-            return;
-        }
-        if (!doc.isObject()) {
-            // Pas un objet JSON => schéma invalide
-            return;
-        }
-        QJsonObject rootObj = doc.object();
-        m_isValide = !rootObj.isEmpty();
-        if(m_isValide){
-            loadSchema(rootObj, parent);
+    /**
+     * @brief Export au format Chrome "Trace Event" (événements complets, ph = "X").
+     */
+    QByteArray toChromeTraceJson() const
+    {
+        QJsonArray traceEvents;
+        for (const Event &e : m_events) {
+            QJsonObject args;
+            args.insert("instanceLocation", e.instanceLocation);
+            args.insert("valid", e.valid);
+
+            QJsonObject event;
+            event.insert("name", e.name);
+            event.insert("cat", e.valid ? "valid" : "invalid");
+            event.insert("ph", "X");
+            event.insert("ts", e.startNs / 1000.0);
+            event.insert("dur", e.durationNs / 1000.0);
+            event.insert("pid", 1);
+            event.insert("tid", 1);
+            event.insert("args", args);
+            traceEvents.append(event);
         }
+        QJsonObject root;
+        root.insert("traceEvents", traceEvents);
+        root.insert("displayTimeUnit", "ns");
+        return QJsonDocument(root).toJson(QJsonDocument::Compact);
     }
 
-
     /**
-     * @brief Constructeur unique : charge le schéma depuis un chemin (ou URL) `schemaPath`.
-     * @param schemaPath  Chemin local ou URL
-     * @param registry    Pointeur vers un registre de schémas (optionnel)
+     * @brief Export "folded stacks" : une ligne "racine;...;feuille tempsPropreNs" par pile.
      */
-    explicit SwJsonSchema(const QJsonObject &data, SwJsonSchema *parent = nullptr)
-        : m_parent(parent)
+    QByteArray toFoldedStacks() const
     {
-        m_isValide = !data.isEmpty();
-        if(m_isValide){
-            loadSchema(data, parent);
+        QVector<qint64> childNs(m_events.size(), 0);
+        for (const Event &e : m_events) {
+            if (e.parent >= 0) {
+                childNs[e.parent] += e.durationNs;
+            }
+        }
+
+        // Le parent précède toujours l'enfant : les piles se construisent en un passage.
+        QVector<QString> stacks(m_events.size());
+        QMap<QString, qint64> folded;
+        for (int i = 0; i < m_events.size(); ++i) {
+            const Event &e = m_events.at(i);
+            QString frame = e.name;
+            frame.replace(';', ':');
+            stacks[i] = e.parent >= 0 ? stacks.at(e.parent) + ";" + frame : frame;
+            folded[stacks.at(i)] += qMax<qint64>(0, e.durationNs - childNs.at(i));
+        }
+
+        QByteArray out;
+        for (auto it = folded.cbegin(); it != folded.cend(); ++it) {
+            out += it.key().toUtf8() + ' ' + QByteArray::number(it.value()) + '\n';
         }
+        return out;
     }
 
-    // Copie
-    SwJsonSchema(const SwJsonSchema &other)
+private:
+    QList<Event>  m_events;
+    int           m_open = -1;
+    QElapsedTimer m_timer;
+};
+
+
+/**
+ * @brief Demande d'annulation coopérative d'une validation (ValidationOptions::cancelToken).
+ *
+ * cancel() peut être appelé depuis n'importe quel thread ; la validation en cours s'arrête
+ * au prochain point de contrôle et rend un résultat "Canceled". Le jeton doit survivre à
+ * la validation et peut être réarmé par reset().
+ */
+class SwJsonSchemaCancelToken
+{
+public:
+    void cancel()
     {
-        copyFrom(other);
+        m_canceled.storeRelaxed(1);
     }
 
-    SwJsonSchema &operator=(const SwJsonSchema &other)
+    void reset()
     {
-        if (this == &other) return *this;
-        copyFrom(other);
-        return *this;
+        m_canceled.storeRelaxed(0);
     }
 
-    /**
-     * @brief Destructeur
-     */
-    ~SwJsonSchema()
+    bool isCanceled() const
     {
-        // Nettoyage
-        qDeleteAll(m_prefixItemsSchemas);
-        m_prefixItemsSchemas.clear();
+        return m_canceled.loadRelaxed() != 0;
     }
 
+private:
+    QAtomicInt m_canceled;
+};
+
+
+/**
+ * @brief Cache LRU borné des résultats de validation d'un schéma (SwJsonSchema::setResultCache()).
+ *
+ * Indexé par le contenu du document : octets JSON bruts (validateBytes()) ou forme
+ * canonique d'une QJsonValue (JSON compact, clés triées). Un document identique à un
+ * document déjà validé reçoit le même résultat sans réévaluation. Réparti en segments
+ * protégés chacun par un mutex : utilisable depuis plusieurs threads à la fois.
+ */
+class SwJsonSchemaResultCache
+{
+public:
+    struct Statistics {
+        quint64 hits      = 0;  ///< Résultats servis par le cache
+        quint64 misses    = 0;  ///< Documents validés faute d'entrée (ou d'entrée avec motif d'erreur)
+        quint64 evictions = 0;  ///< Entrées retirées pour faire place (les moins récemment utilisées)
+        int     entries   = 0;
+        int     maxEntries = 0;
+
+        double hitRate() const
+        {
+            return (hits + misses) ? double(hits) / double(hits + misses) : 0.0;
+        }
+    };
+
     /**
-     * @brief Valide une QJsonValue contre ce schéma
-     * @param value         Valeur à valider
-     * @param errorMessage  Optionnel, reçoit le motif d’erreur
-     * @return true si la valeur est valide, false sinon
+     * @param maxEntries       Nombre maximal de résultats conservés
+     * @param maxPayloadBytes  Documents plus grands jamais mis en cache (leur clé coûterait trop)
      */
-    bool validate(const QJsonValue &value, QString *errorMessage = nullptr) const
+    SwJsonSchemaResultCache(int maxEntries, int maxPayloadBytes)
+        : m_maxEntries(qMax(1, maxEntries)), m_maxPayloadBytes(maxPayloadBytes),
+          m_shards(qBound(1, m_maxEntries / 64, 16))
     {
-        QSet<const SwJsonSchema*> visited;
-        return validateInternal(value, visited, errorMessage);
+        for (int i = 0; i < m_shards.size(); ++i) {
+            m_shards[i].reset(new Shard);
+            // Capacités réparties pour totaliser maxEntries
+            m_shards[i]->entries.setMaxCost(m_maxEntries / m_shards.size() + (i < m_maxEntries % m_shards.size() ? 1 : 0));
+        }
     }
 
-    bool isValide() {
-        return m_isValide;
+    int maxPayloadBytes() const
+    {
+        return m_maxPayloadBytes;
     }
 
     /**
-     * @brief Enregistre une lambda pour un mot-clé personnalisé
-     * @param keyWord Mot-clé
-     * @param validator Lambda prenant un QJsonValue et QString& pour l'erreur
+     * @brief Résultat mémorisé pour `key` ; faux (absence) si l'entrée n'existe pas ou si
+     *        `errorMessage` est demandé et que l'entrée a été produite sans motif d'erreur.
      */
-    static void registerCustomKeyword(const QString& keyWord, Validator validator) {
-        getCustomKeywordRegistry()[keyWord] = validator;
+    bool find(const QByteArray &key, QString *errorMessage, bool &valid)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        const Entry *entry = shard.entries.object(key);
+        if (!entry || (errorMessage && !entry->valid && !entry->hasMessage)) {
+            ++shard.misses;
+            return false;
+        }
+        ++shard.hits;
+        valid = entry->valid;
+        if (errorMessage && !valid) {
+            *errorMessage = entry->message;
+        }
+        return true;
     }
 
-private:
-    // -----------------------------------------------------------------------
-    //                   Méthodes de chargement
-    // -----------------------------------------------------------------------
-    void loadSchema(const QJsonObject &schemaObject, const SwJsonSchema *parent)
+    void insert(const QByteArray &key, bool valid, const QString *errorMessage)
     {
-        // 1) Lire $schema (optionnel)
-        if (schemaObject.contains("$schema") && schemaObject.value("$schema").isString()) {
-            m_dollarSchema = schemaObject.value("$schema").toString();
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        if (!shard.entries.contains(key) && shard.entries.size() >= shard.entries.maxCost()) {
+            ++shard.evictions;
         }
+        Entry *entry = new Entry;
+        entry->valid = valid;
+        entry->hasMessage = errorMessage != nullptr;
+        if (errorMessage && !valid) {
+            entry->message = *errorMessage;
+        }
+        shard.entries.insert(key, entry);
+    }
 
-        // 2) Lire $id
-        if (schemaObject.contains("$id") && schemaObject.value("$id").isString()) {
-            m_baseUri = schemaObject.value("$id").toString().trimmed();
+    void clear()
+    {
+        for (const QSharedPointer<Shard> &shard : m_shards) {
+            QMutexLocker locker(&shard->mutex);
+            shard->entries.clear();
         }
+    }
 
-        // 3) Calcul du m_baseUri
-        m_baseUri = resolveUri(parent, m_baseUri);
+    Statistics statistics() const
+    {
+        Statistics statistics;
+        statistics.maxEntries = m_maxEntries;
+        for (const QSharedPointer<Shard> &shard : m_shards) {
+            QMutexLocker locker(&shard->mutex);
+            statistics.hits += shard->hits;
+            statistics.misses += shard->misses;
+            statistics.evictions += shard->evictions;
+            statistics.entries += int(shard->entries.size());
+        }
+        return statistics;
+    }
 
-        // 5) Lire $anchor
-        //        getRegistry(m_baseUri)->registerSchemaByAnchor("#", this);
-        if (schemaObject.contains("$anchor") && schemaObject.value("$anchor").isString()) {
-            m_dollarAnchor = schemaObject.value("$anchor").toString().trimmed();
-            if (!m_dollarAnchor.isEmpty()) {
-                QString fullAnchor = m_baseUri + "#" + m_dollarAnchor;
-                getRegistry(m_baseUri)->registerSchemaByAnchor(fullAnchor, this);
+    /// Octets retenus : clés, plus une entrée estimée à trois pointeurs et un Entry.
+    qint64 memoryUsage() const
+    {
+        qint64 bytes = 0;
+        for (const QSharedPointer<Shard> &shard : m_shards) {
+            QMutexLocker locker(&shard->mutex);
+            for (const QByteArray &key : shard->entries.keys()) {
+                bytes += key.capacity() + 3 * qint64(sizeof(void*)) + qint64(sizeof(Entry));
             }
         }
+        return bytes;
+    }
 
-        // 6) Lire $ref
-        if (schemaObject.contains("$ref") && schemaObject.value("$ref").isString()) {
-            m_dollarRef = schemaObject.value("$ref").toString().trimmed();
-            if(!m_dollarRef.contains("$def")){
-                if(!m_dollarRef.trimmed().startsWith("#")){
-                    QStringList tmpLst = m_baseUri.split("/");
-                    tmpLst.removeLast();
-                    tmpLst.append(m_dollarRef.split("#").first());
-                    SwJsonSchema *ref = new SwJsonSchema(tmpLst.join("/"), this);
-                    if(ref->m_isValide){
-                        getRegistry(m_baseUri)->registerSchemaByRef(tmpLst.join("/"), ref);
-                    } else {
-                        delete ref;
-                        m_dollarRef = "";
-                    }
-                } else if(m_dollarRef.trimmed() == "#"){
-                    //recursive reference
-                    m_recursiveSchema = findMainSchema();
-                }
-            }
-        }
+private:
+    struct Entry {
+        bool    valid = false;
+        bool    hasMessage = false;  ///< Produite avec un motif d'erreur (sinon il reste à calculer)
+        QString message;
+    };
 
-        // 7.1) Charger $defs
-        if (schemaObject.contains("$defs") && schemaObject.value("$defs").isObject()) {
-            QJsonObject defsObj = schemaObject.value("$defs").toObject();
-            for (auto it = defsObj.begin(); it != defsObj.end(); ++it) {
-                if (it.value().isObject()) {
-                    SwJsonSchema *def = new SwJsonSchema(it.value().toObject(), this);
-                    getRegistry(m_baseUri)->registerSchemaByAnchor("#/$defs/"+it.key(), def);
-                }
-            }
+    struct Shard {
+        mutable QMutex mutex;
+        QCache<QByteArray, Entry> entries;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    Shard &shardFor(const QByteArray &key)
+    {
+        return *m_shards.at(int(qHash(key) % uint(m_shards.size())));
+    }
+
+    int m_maxEntries;
+    int m_maxPayloadBytes;
+    QVector<QSharedPointer<Shard>> m_shards;
+};
+
+
+/**
+ * @brief État conservé d'une validation : document validé et résultats mémorisés.
+ *
+ * Chaque résultat est indexé par couple (noeud de schéma, JSON Pointer de l'instance).
+ * SwJsonSchema::revalidate() applique un JSON Patch (RFC 6902) au document, n'invalide
+ * que les résultats des sous-arbres modifiés et de leurs ancêtres, puis revalide : les
+ * sous-arbres intacts sont servis par le cache. Le coût suit la taille du patch et des
+ * conteneurs traversés (required, uniqueItems, contains, ... des ancêtres sont réévalués),
+ * non celle du document.
+ *
+ * Sert aussi de cache éphémère à SwJsonSchema::ValidationOptions::memoize. L'état référence
+ * les noeuds du schéma qui l'a produit : il doit lui survivre. Pas de partage entre threads.
+ */
+class SwJsonSchemaValidationState
+{
+public:
+    SwJsonSchemaValidationState() = default;
+
+    /// Un document a été validé avec cet état (ValidationOptions::state)
+    bool hasDocument() const { return m_schema != nullptr; }
+
+    /// Document validé, patchs éventuels appliqués
+    const QJsonValue &document() const { return m_document; }
+
+    /// Résultat de la dernière validation
+    bool isValid() const { return m_valid; }
+
+    int     entryCount() const { return m_entries.size(); }
+    quint64 hits() const { return m_hits; }      ///< Évaluations servies par le cache (dernière validation)
+    quint64 misses() const { return m_misses; }  ///< Évaluations calculées (dernière validation)
+
+    void clear()
+    {
+        m_schema = nullptr;
+        m_document = QJsonValue();
+        m_valid = false;
+        m_entries.clear();
+        m_index.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+private:
+    friend class SwJsonSchema;
+
+    /// Résultat mémorisé d'un couple (noeud, position dans l'instance).
+    struct Entry {
+        bool    valid    = true;
+        bool    hasError = false;  ///< error renseigné (évaluation faite avec message d'erreur)
+        QString error;
+    };
+
+    using Key = QPair<const SwJsonSchema*, QString>;
+
+    /// Position de l'instance : noeuds mémorisés et positions enfants connues.
+    struct PointerNode {
+        QVector<const SwJsonSchema*> schemas;
+        QSet<QString> children;  ///< JSON Pointers complets des enfants
+    };
+
+    /// Une modification du document : sous-arbre remplacé, ou décalage d'un tableau à partir de shiftFrom.
+    struct Change {
+        QString pointer;
+        int     shiftFrom = -1;
+    };
+
+    enum class Operation { Add, Remove, Replace };
+
+    void insert(const Key &key, const Entry &entry)
+    {
+        const bool known = m_entries.contains(key);
+        m_entries.insert(key, entry);
+        if (!m_indexed || known) {
+            return;
         }
-        // 7.2) Charger $defs
-        if (schemaObject.contains("definitions") && schemaObject.value("definitions").isObject()) {
-            QJsonObject defsObj = schemaObject.value("definitions").toObject();
-            for (auto it = defsObj.begin(); it != defsObj.end(); ++it) {
-                if (it.value().isObject()) {
-                    SwJsonSchema *def = new SwJsonSchema(it.value().toObject(), this);
-                    getRegistry(m_baseUri)->registerSchemaByAnchor("#/definitions/"+it.key(), def);
+        if (!m_index.contains(key.second)) {
+            // Rattache la position (et ses ancêtres inconnus) à l'arbre
+            QString child = key.second;
+            while (!child.isEmpty()) {
+                QString parent = child.left(child.lastIndexOf('/'));
+                bool known = m_index.contains(parent);
+                m_index[parent].children.insert(child);
+                if (known) {
+                    break;
                 }
+                child = parent;
             }
         }
+        m_index[key.second].schemas.append(key.first);
+    }
 
-        // 8) Lire "type"
-        if (schemaObject.contains("type")) {
-            m_type = parseType(schemaObject.value("type"));
-        }
-
-        // 9) enum / const
-        if (schemaObject.contains("enum") && schemaObject.value("enum").isArray()) {
-            QJsonArray arr = schemaObject.value("enum").toArray();
-            for (const auto &v : arr) {
-                m_enumValues.append(v);
-            }
+    // -----------------------------------------------------------------------
+    //                   Invalidation
+    // -----------------------------------------------------------------------
+    /// Résultats mémorisés à une position (les enfants restent valables).
+    void dropResults(const QString &pointer)
+    {
+        auto it = m_index.find(pointer);
+        if (it == m_index.end()) {
+            return;
         }
-        if (schemaObject.contains("const")) {
-            m_constValue = schemaObject.value("const");
+        for (const SwJsonSchema *schema : it.value().schemas) {
+            m_entries.remove(Key(schema, pointer));
         }
+        it.value().schemas.clear();
+    }
 
-        // 10) multipleOf, minimum, maximum, ...
-        if (schemaObject.contains("multipleOf")) {
-            m_multipleOf = schemaObject.value("multipleOf").toDouble(0.0);
-            m_hasMultipleOf = true;
-        }
-        if (schemaObject.contains("minimum")) {
-            m_minimum = schemaObject.value("minimum").toDouble(0.0);
-            m_hasMinimum = true;
-        }
-        if (schemaObject.contains("maximum")) {
-            m_maximum = schemaObject.value("maximum").toDouble(0.0);
-            m_hasMaximum = true;
+    /// Résultats d'une position et de tous ses descendants.
+    void dropSubtree(const QString &pointer)
+    {
+        if (!m_index.contains(pointer)) {
+            return;
         }
-        if (schemaObject.contains("exclusiveMinimum")) {
-            const QJsonValue exMin = schemaObject.value("exclusiveMinimum");
-            if (exMin.isBool()) {
-                m_exclusiveMinimum = exMin.toBool(false);
-            } else {
-                m_minimum = exMin.toDouble(0.0);
-                m_hasMinimum = true;
-                m_exclusiveMinimum = true;
-            }
+        const PointerNode node = m_index.take(pointer);
+        for (const SwJsonSchema *schema : node.schemas) {
+            m_entries.remove(Key(schema, pointer));
         }
-        if (schemaObject.contains("exclusiveMaximum")) {
-            const QJsonValue exMax = schemaObject.value("exclusiveMaximum");
-            if (exMax.isBool()) {
-                m_exclusiveMaximum = exMax.toBool(false);
-            } else {
-                m_maximum = exMax.toDouble(0.0);
-                m_hasMaximum = true;
-                m_exclusiveMaximum = true;
-            }
+        for (const QString &child : node.children) {
+            dropSubtree(child);
         }
+    }
 
-        // 11) minLength / maxLength / pattern / format
-        if (schemaObject.contains("minLength")) {
-            m_minLength = schemaObject.value("minLength").toInt(-1);
+    void dropAncestors(QString pointer)
+    {
+        while (!pointer.isEmpty()) {
+            pointer = pointer.left(pointer.lastIndexOf('/'));
+            dropResults(pointer);
         }
-        if (schemaObject.contains("maxLength")) {
-            m_maxLength = schemaObject.value("maxLength").toInt(-1);
+    }
+
+    void invalidate(const Change &change)
+    {
+        if (change.pointer.isEmpty() && change.shiftFrom < 0) {
+            // Document remplacé
+            m_entries.clear();
+            m_index.clear();
+            return;
         }
-        if (schemaObject.contains("pattern")) {
-            m_pattern = schemaObject.value("pattern").toString();
-            m_hasPattern = true;
+        if (change.shiftFrom < 0) {
+            dropSubtree(change.pointer);
+            QString parent = change.pointer.left(change.pointer.lastIndexOf('/'));
+            auto it = m_index.find(parent);
+            if (it != m_index.end()) {
+                it.value().children.remove(change.pointer);
+            }
+            dropAncestors(change.pointer);
+            return;
         }
-        if (schemaObject.contains("format")) {
-            m_format = schemaObject.value("format").toString();
+        // Insertion / suppression dans un tableau : les éléments suivants changent de position
+        auto it = m_index.find(change.pointer);
+        if (it != m_index.end()) {
+            const QSet<QString> children = it.value().children;
+            for (const QString &child : children) {
+                if (child.mid(change.pointer.size() + 1).toInt() >= change.shiftFrom) {
+                    dropSubtree(child);
+                    m_index[change.pointer].children.remove(child);
+                }
+            }
         }
+        dropResults(change.pointer);
+        dropAncestors(change.pointer);
+    }
 
-        // 12) items / prefixItems / additionalItems
-        if (schemaObject.contains("items")) {
-            QJsonValue val = schemaObject.value("items");
-            if (val.isObject()) {
-                m_itemsSchema.reset(new SwJsonSchema(val.toObject(), this));
-            } else if (val.isArray()) {
-                QJsonArray arr = val.toArray();
-                for (const auto &item : arr) {
-                    if (item.isObject()) {
-                        SwJsonSchema *sub = new SwJsonSchema(item.toObject(), this);
-                        m_prefixItemsSchemas.append(sub);
-                    }
+    // -----------------------------------------------------------------------
+    //                   JSON Patch (RFC 6902)
+    // -----------------------------------------------------------------------
+    /**
+     * @brief Applique un patch au document puis invalide les résultats concernés.
+     *        Le patch est atomique : en cas d'échec, l'état est inchangé.
+     */
+    bool applyPatch(const QJsonArray &patch, QString *errorMessage)
+    {
+        QJsonValue document = m_document;
+        QList<Change> changes;
+        for (int i = 0; i < patch.size(); ++i) {
+            QString error;
+            if (!applyOperation(document, patch.at(i).toObject(), changes, &error)) {
+                if (errorMessage) {
+                    *errorMessage = QString("Opération %1 du patch invalide : %2").arg(i).arg(error);
                 }
+                return false;
             }
         }
-        if (schemaObject.contains("additionalItems") && schemaObject.value("additionalItems").isObject()) {
-            m_additionalItemsSchema.reset(new SwJsonSchema(schemaObject.value("additionalItems").toObject(), this));
-        }
-        if (schemaObject.contains("minItems")) {
-            m_minItems = schemaObject.value("minItems").toInt(-1);
-        }
-        if (schemaObject.contains("maxItems")) {
-            m_maxItems = schemaObject.value("maxItems").toInt(-1);
-        }
-        if (schemaObject.contains("uniqueItems")) {
-            m_uniqueItems = schemaObject.value("uniqueItems").toBool(false);
+        m_document = document;
+        for (const Change &change : changes) {
+            invalidate(change);
         }
+        return true;
+    }
 
-        // 13) contains / minContains / maxContains
-        if (schemaObject.contains("contains") && schemaObject.value("contains").isObject()) {
-            m_containsSchema.reset(new SwJsonSchema(schemaObject.value("contains").toObject(), this));
-        }
-        if (schemaObject.contains("minContains")) {
-            m_minContains = schemaObject.value("minContains").toInt(-1);
-        }
-        if (schemaObject.contains("maxContains")) {
-            m_maxContains = schemaObject.value("maxContains").toInt(-1);
+    static bool applyOperation(QJsonValue &document, const QJsonObject &operation,
+                               QList<Change> &changes, QString *error)
+    {
+        const QString op = operation.value("op").toString();
+        const QString path = operation.value("path").toString();
+        QStringList tokens;
+        if (!operation.value("path").isString() || !parsePointer(path, tokens)) {
+            *error = QString("chemin '%1' invalide.").arg(path);
+            return false;
         }
 
-        // 14) properties / patternProperties / additionalProperties
-        if (schemaObject.contains("properties") && schemaObject.value("properties").isObject()) {
-            QJsonObject props = schemaObject.value("properties").toObject();
-            for (auto it = props.begin(); it != props.end(); ++it) {
-                if (it.value().isObject()) {
-                    SwJsonSchema sub(it.value().toObject(), this);
-                    m_properties.insert(it.key(), sub);
-                }
+        if (op == "add" || op == "replace") {
+            if (!operation.contains("value")) {
+                *error = QString("'%1' sans \"value\".").arg(op);
+                return false;
             }
+            return update(document, path, tokens, op == "add" ? Operation::Add : Operation::Replace,
+                          operation.value("value"), changes, error);
         }
-        if (schemaObject.contains("patternProperties") && schemaObject.value("patternProperties").isObject()) {
-            QJsonObject pprops = schemaObject.value("patternProperties").toObject();
-            for (auto it = pprops.begin(); it != pprops.end(); ++it) {
-                if (it.value().isObject()) {
-                    SwJsonSchema sub(it.value().toObject(), this);
-                    m_patternProperties.insert(it.key(), sub);
-                }
+        if (op == "remove") {
+            return update(document, path, tokens, Operation::Remove, QJsonValue(), changes, error);
+        }
+        if (op == "test") {
+            QJsonValue current;
+            if (!valueAt(document, tokens, current)) {
+                *error = QString("'%1' introuvable.").arg(path);
+                return false;
             }
+            if (current != operation.value("value")) {
+                *error = QString("test échoué sur '%1'.").arg(path);
+                return false;
+            }
+            return true;
         }
-        if (schemaObject.contains("additionalProperties")) {
-            QJsonValue apVal = schemaObject.value("additionalProperties");
-            if (apVal.isBool()) {
-                if (!apVal.toBool()) {
-                    m_additionalPropertiesIsFalse = true;
+        if (op == "move" || op == "copy") {
+            const QString from = operation.value("from").toString();
+            QStringList fromTokens;
+            QJsonValue moved;
+            if (!parsePointer(from, fromTokens) || !valueAt(document, fromTokens, moved)) {
+                *error = QString("source '%1' introuvable.").arg(from);
+                return false;
+            }
+            if (op == "move") {
+                if (path.startsWith(from + "/")) {
+                    *error = QString("'%1' ne peut être déplacé dans l'un de ses descendants.").arg(from);
+                    return false;
+                }
+                if (!update(document, from, fromTokens, Operation::Remove, QJsonValue(), changes, error)) {
+                    return false;
                 }
-            } else if (apVal.isObject()) {
-                m_additionalPropertiesSchema.reset(new SwJsonSchema(apVal.toObject(), this));
             }
+            return update(document, path, tokens, Operation::Add, moved, changes, error);
         }
+        *error = QString("opération '%1' inconnue.").arg(op);
+        return false;
+    }
 
-        // 15) required / dependentRequired
-        if (schemaObject.contains("required") && schemaObject.value("required").isArray()) {
-            QJsonArray reqArr = schemaObject.value("required").toArray();
-            for (const auto &r : reqArr) {
-                if (r.isString()) {
-                    m_required.insert(r.toString());
-                }
+    /// Modifie la valeur désignée par `tokens` et enregistre le changement correspondant.
+    static bool update(QJsonValue &document, const QString &path, const QStringList &tokens,
+                       Operation operation, const QJsonValue &value,
+                       QList<Change> &changes, QString *error)
+    {
+        if (tokens.isEmpty()) {
+            if (operation == Operation::Remove) {
+                *error = "le document racine ne peut être supprimé.";
+                return false;
             }
+            document = value;
+            changes << Change();
+            return true;
         }
-        if (schemaObject.contains("dependentRequired") && schemaObject.value("dependentRequired").isObject()) {
-            QJsonObject drObj = schemaObject.value("dependentRequired").toObject();
-            for (auto it = drObj.begin(); it != drObj.end(); ++it) {
-                if (it.value().isArray()) {
-                    QStringList deps;
-                    for (const auto &d : it.value().toArray()) {
-                        deps << d.toString();
-                    }
-                    m_dependentRequired.insert(it.key(), deps);
-                }
-            }
+        int shiftFrom = -1;
+        if (!updateAt(document, tokens, 0, operation, value, &shiftFrom, error)) {
+            return false;
+        }
+        Change change;
+        if (shiftFrom >= 0) {
+            change.pointer = path.left(path.lastIndexOf('/'));
+            change.shiftFrom = shiftFrom;
+        } else {
+            change.pointer = path;
         }
+        changes << change;
+        return true;
+    }
 
-        // 16) allOf / anyOf / oneOf / not
-        if (schemaObject.contains("allOf") && schemaObject.value("allOf").isArray()) {
-            QJsonArray arr = schemaObject.value("allOf").toArray();
-            for (const auto &sch : arr) {
-                if (sch.isObject()) {
-                    SwJsonSchema sub(sch.toObject(), this);
-                    m_allOf.append(sub);
+    static bool updateAt(QJsonValue &target, const QStringList &tokens, int depth,
+                         Operation operation, const QJsonValue &value,
+                         int *shiftFrom, QString *error)
+    {
+        const QString &token = tokens.at(depth);
+        const bool last = (depth == tokens.size() - 1);
+
+        if (target.isObject()) {
+            QJsonObject obj = target.toObject();
+            if (!last) {
+                auto it = obj.find(token);
+                if (it == obj.end()) {
+                    *error = QString("propriété '%1' introuvable.").arg(token);
+                    return false;
                 }
-            }
-        }
-        if (schemaObject.contains("anyOf") && schemaObject.value("anyOf").isArray()) {
-            QJsonArray arr = schemaObject.value("anyOf").toArray();
-            for (const auto &sch : arr) {
-                if (sch.isObject()) {
-                    SwJsonSchema sub(sch.toObject(), this);
-                    m_anyOf.append(sub);
+                QJsonValue child = it.value();
+                if (!updateAt(child, tokens, depth + 1, operation, value, shiftFrom, error)) {
+                    return false;
                 }
+                it.value() = child;
+            } else if (operation == Operation::Add) {
+                obj.insert(token, value);
+            } else if (!obj.contains(token)) {
+                *error = QString("propriété '%1' introuvable.").arg(token);
+                return false;
+            } else if (operation == Operation::Replace) {
+                obj.insert(token, value);
+            } else {
+                obj.remove(token);
             }
+            target = obj;
+            return true;
         }
-        if (schemaObject.contains("oneOf") && schemaObject.value("oneOf").isArray()) {
-            QJsonArray arr = schemaObject.value("oneOf").toArray();
-            for (const auto &sch : arr) {
-                if (sch.isObject()) {
-                    SwJsonSchema sub(sch.toObject(), this);
-                    m_oneOf.append(sub);
+
+        if (target.isArray()) {
+            QJsonArray arr = target.toArray();
+            int index = (last && operation == Operation::Add && token == "-") ? arr.size() : arrayIndex(token);
+            int bound = (last && operation == Operation::Add) ? arr.size() : arr.size() - 1;
+            if (index < 0 || index > bound) {
+                *error = QString("indice '%1' hors du tableau.").arg(token);
+                return false;
+            }
+            if (!last) {
+                QJsonValue child = arr.at(index);
+                if (!updateAt(child, tokens, depth + 1, operation, value, shiftFrom, error)) {
+                    return false;
                 }
+                arr.replace(index, child);
+            } else if (operation == Operation::Add) {
+                arr.insert(index, value);
+                *shiftFrom = index;
+            } else if (operation == Operation::Replace) {
+                arr.replace(index, value);
+            } else {
+                arr.removeAt(index);
+                *shiftFrom = index;
             }
-        }
-        if (schemaObject.contains("not") && schemaObject.value("not").isObject()) {
-            m_notSchema.reset(new SwJsonSchema(schemaObject.value("not").toObject(), this));
-        }
-        // 17) if / then / else
-        if (schemaObject.contains("if") && schemaObject.value("if").isObject()) {
-            m_ifSchema.reset(new SwJsonSchema(schemaObject.value("if").toObject(), this));
-        }
-        if (schemaObject.contains("then") && schemaObject.value("then").isObject()) {
-            m_thenSchema.reset(new SwJsonSchema(schemaObject.value("then").toObject(), this));
-        }
-        if (schemaObject.contains("else") && schemaObject.value("else").isObject()) {
-            m_elseSchema.reset(new SwJsonSchema(schemaObject.value("else").toObject(), this));
+            target = arr;
+            return true;
         }
 
-        // 18) Si type pas défini => tenter deduceTypeFromConstraints()
-        if (m_type == SchemaType::Invalid) {
-            deduceTypeFromConstraints();
-        }
+        *error = QString("'%1' ne désigne pas un conteneur.").arg(token);
+        return false;
+    }
 
-        const auto& customKeywords = getCustomKeywordRegistry();
-        foreach(const QString &key, schemaObject.keys()){
-            if(customKeywords.contains(key)) {
-                KeywordJsonValidator userKey(customKeywords.value(key));
-                userKey.setRules(schemaObject.value(key));
-                m_internalCustomKeywordValidator.append(userKey);
+    static bool valueAt(const QJsonValue &document, const QStringList &tokens, QJsonValue &out)
+    {
+        QJsonValue current = document;
+        for (const QString &token : tokens) {
+            if (current.isObject() && current.toObject().contains(token)) {
+                current = current.toObject().value(token);
+            } else if (current.isArray()) {
+                int index = arrayIndex(token);
+                if (index < 0 || index >= current.toArray().size()) {
+                    return false;
+                }
+                current = current.toArray().at(index);
+            } else {
+                return false;
             }
         }
+        out = current;
+        return true;
     }
 
-    // -----------------------------------------------------------------------
-    //                   Validation (interne)
-    // -----------------------------------------------------------------------
-    bool validateInternal(const QJsonValue &value,
-                          QSet<const SwJsonSchema*> &visited,
-                          QString *errorMessage) const
+    /// Indice de tableau (RFC 6901 : chiffres sans zéro initial), -1 sinon.
+    static int arrayIndex(const QString &token)
     {
-        if (visited.contains(this)) {
-            return setError(errorMessage, "Récursion de schémas détectée.");
+        if (token.isEmpty() || (token.size() > 1 && token.startsWith('0'))) {
+            return -1;
         }
-        visited.insert(this);
+        bool ok = false;
+        int index = token.toInt(&ok);
+        return (ok && index >= 0 && token.at(0).isDigit()) ? index : -1;
+    }
 
-        // Gérer $ref
-        if (!m_dollarRef.isEmpty() && m_dollarRef != "#") {
-            bool isFound = false;
-            SwJsonSchema *refSchema = const_cast<SwJsonSchema *>(this);
-            while(!isFound && refSchema != nullptr){
-                refSchema = getRegistry(refSchema->m_baseUri)->resolveRef(m_dollarRef, refSchema->m_baseUri, isFound);
-            }
-            if (!refSchema) {
-                return setError(errorMessage,
-                                QString("Impossible de résoudre la référence '%1'.").arg(m_dollarRef));
-            }
-            return refSchema->validateInternal(value, visited, errorMessage);
+    /// Découpe un JSON Pointer en jetons déséchappés ("~1" -> "/", "~0" -> "~").
+    static bool parsePointer(const QString &pointer, QStringList &tokens)
+    {
+        tokens.clear();
+        if (pointer.isEmpty()) {
+            return true;
         }
-
-        // if/then/else
-        if (!applyConditional(value, visited, errorMessage)) {
+        if (!pointer.startsWith('/')) {
             return false;
         }
-
-        // not
-        if (m_notSchema) {
-            if (m_notSchema->validateInternal(value, visited, nullptr)) {
-                return setError(errorMessage, "Le schéma 'not' est satisfait, ce qui est interdit.");
-            }
+        const QStringList raw = pointer.mid(1).split('/');
+        for (QString token : raw) {
+            token.replace("~1", "/");
+            token.replace("~0", "~");
+            tokens << token;
         }
+        return true;
+    }
 
-        // allOf / anyOf / oneOf
-        if (!checkAllOf(value, visited, errorMessage)) return false;
-        if (!checkAnyOf(value, visited, errorMessage)) return false;
-        if (!checkOneOf(value, visited, errorMessage)) return false;
+    const SwJsonSchema   *m_schema = nullptr;  ///< Schéma ayant produit l'état
+    QJsonValue            m_document;
+    bool                  m_valid   = false;
+    bool                  m_indexed = false;   ///< Index par position tenu (état conservé pour revalidate)
+    QHash<Key, Entry>     m_entries;
+    QHash<QString, PointerNode> m_index;
+    quint64               m_hits   = 0;
+    quint64               m_misses = 0;
+};
 
-        // enum / const
-        if (!m_enumValues.isEmpty()) {
-            bool found = false;
-            for (auto &ev : m_enumValues) {
-                if (ev == value) {
-                    found = true;
-                    break;
+
+/**
+ * @brief Accès en lecture à un document à valider (SwJsonSchema::validateDocument()).
+ *
+ * Le validateur ne manipule l'instance qu'à travers cette classe de traits : le document
+ * est parcouru en place, sans copie en QJsonValue. Spécialisations fournies : QJsonValue
+ * (chemin de validate(), sans surcoût), QVariant et QCborValue. Pour un autre type
+ * (nlohmann::json, ...), spécialiser SwJsonSchemaDocument<T> avec :
+ *  - Value, Object, Array, ObjectIterator : types de valeur, d'objet, de tableau et
+ *    d'itérateur sur les propriétés ;
+ *  - type(v) : type JSON de la valeur (QJsonValue::Type, Double pour tout nombre) ;
+ *  - toBool(v), toDouble(v), toString(v), toObject(v), toArray(v) : accès aux scalaires
+ *    et aux conteneurs ;
+ *  - size(o), begin(o), end(o), find(o, clé), contains(o, clé), key(it) et value(it) :
+ *    propriétés d'un objet (les annotations de unevaluatedProperties repèrent une propriété
+ *    par son rang dans l'ordre de parcours de begin()) ;
+ *  - size(a), at(a, i) : éléments d'un tableau ;
+ *  - toJsonValue(v) : conversion d'une valeur, limitée aux mots-clés qui comparent ou
+ *    transmettent une valeur entière (enum, const, uniqueItems, discriminant de oneOf /
+ *    anyOf, mots-clés personnalisés) et au document d'un état conservé
+ *    (ValidationOptions::state).
+ */
+template <typename T>
+struct SwJsonSchemaDocument;
+
+template <>
+struct SwJsonSchemaDocument<QJsonValue>
+{
+    using Value = QJsonValue;
+    using Object = QJsonObject;
+    using Array = QJsonArray;
+    using ObjectIterator = QJsonObject::const_iterator;
+
+    static QJsonValue::Type type(const QJsonValue &v) { return v.type(); }
+    static bool toBool(const QJsonValue &v) { return v.toBool(); }
+    static double toDouble(const QJsonValue &v) { return v.toDouble(); }
+    static QString toString(const QJsonValue &v) { return v.toString(); }
+    static QJsonObject toObject(const QJsonValue &v) { return v.toObject(); }
+    static QJsonArray toArray(const QJsonValue &v) { return v.toArray(); }
+    static const QJsonValue &toJsonValue(const QJsonValue &v) { return v; }
+
+    static int size(const QJsonObject &o) { return int(o.size()); }
+    static ObjectIterator begin(const QJsonObject &o) { return o.constBegin(); }
+    static ObjectIterator end(const QJsonObject &o) { return o.constEnd(); }
+    static ObjectIterator find(const QJsonObject &o, const QString &key) { return o.constFind(key); }
+    static bool contains(const QJsonObject &o, const QString &key) { return o.contains(key); }
+    static QString key(const ObjectIterator &it) { return it.key(); }
+    static QJsonValue value(const ObjectIterator &it) { return it.value(); }
+
+    static int size(const QJsonArray &a) { return int(a.size()); }
+    static QJsonValue at(const QJsonArray &a, int i) { return a.at(i); }
+};
+
+/**
+ * @brief QVariant : QVariantMap (ou QVariantHash, converti) pour les objets, QVariantList
+ *        ou QStringList pour les tableaux, types numériques pour les nombres, QVariant nul
+ *        ou invalide pour null. Les autres types suivent QJsonValue::fromVariant().
+ */
+template <>
+struct SwJsonSchemaDocument<QVariant>
+{
+    using Value = QVariant;
+    using Object = QVariantMap;
+    using Array = QVariantList;
+    using ObjectIterator = QVariantMap::const_iterator;
+
+    static QJsonValue::Type type(const QVariant &v)
+    {
+        switch (v.userType()) {
+        case QMetaType::UnknownType:
+        case QMetaType::Nullptr:      return QJsonValue::Null;
+        case QMetaType::Bool:         return QJsonValue::Bool;
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:       return QJsonValue::Double;
+        case QMetaType::QString:      return QJsonValue::String;
+        case QMetaType::QVariantList:
+        case QMetaType::QStringList:  return QJsonValue::Array;
+        case QMetaType::QVariantMap:
+        case QMetaType::QVariantHash: return QJsonValue::Object;
+        default:                      return QJsonValue::fromVariant(v).type();
+        }
+    }
+    static bool toBool(const QVariant &v) { return v.toBool(); }
+    static double toDouble(const QVariant &v) { return v.toDouble(); }
+    static QString toString(const QVariant &v) { return v.toString(); }
+    static QVariantMap toObject(const QVariant &v) { return v.toMap(); }
+    static QVariantList toArray(const QVariant &v) { return v.toList(); }
+    static QJsonValue toJsonValue(const QVariant &v) { return QJsonValue::fromVariant(v); }
+
+    static int size(const QVariantMap &o) { return int(o.size()); }
+    static ObjectIterator begin(const QVariantMap &o) { return o.constBegin(); }
+    static ObjectIterator end(const QVariantMap &o) { return o.constEnd(); }
+    static ObjectIterator find(const QVariantMap &o, const QString &key) { return o.constFind(key); }
+    static bool contains(const QVariantMap &o, const QString &key) { return o.contains(key); }
+    static QString key(const ObjectIterator &it) { return it.key(); }
+    static QVariant value(const ObjectIterator &it) { return it.value(); }
+
+    static int size(const QVariantList &a) { return int(a.size()); }
+    static QVariant at(const QVariantList &a, int i) { return a.at(i); }
+};
+
+/**
+ * @brief QCborValue : entiers et doubles sont des nombres, les clés non textuelles d'une
+ *        map sont lues en notation de diagnostic. Les autres types (octets, étiquettes,
+ *        dates, ...) suivent QCborValue::toJsonValue().
+ */
+template <>
+struct SwJsonSchemaDocument<QCborValue>
+{
+    using Value = QCborValue;
+    using Object = QCborMap;
+    using Array = QCborArray;
+    using ObjectIterator = QCborMap::ConstIterator;
+
+    static QJsonValue::Type type(const QCborValue &v)
+    {
+        switch (v.type()) {
+        case QCborValue::Null:    return QJsonValue::Null;
+        case QCborValue::False:
+        case QCborValue::True:    return QJsonValue::Bool;
+        case QCborValue::Integer:
+        case QCborValue::Double:  return QJsonValue::Double;
+        case QCborValue::String:  return QJsonValue::String;
+        case QCborValue::Array:   return QJsonValue::Array;
+        case QCborValue::Map:     return QJsonValue::Object;
+        default:                  return v.toJsonValue().type();
+        }
+    }
+    static bool toBool(const QCborValue &v) { return v.isBool() ? v.toBool() : v.toJsonValue().toBool(); }
+    static double toDouble(const QCborValue &v)
+    {
+        return (v.isInteger() || v.isDouble()) ? v.toDouble() : v.toJsonValue().toDouble();
+    }
+    static QString toString(const QCborValue &v) { return v.isString() ? v.toString() : v.toJsonValue().toString(); }
+    static QCborMap toObject(const QCborValue &v) { return v.toMap(); }
+    static QCborArray toArray(const QCborValue &v) { return v.toArray(); }
+    static QJsonValue toJsonValue(const QCborValue &v) { return v.toJsonValue(); }
+
+    static int size(const QCborMap &o) { return int(o.size()); }
+    static ObjectIterator begin(const QCborMap &o) { return o.constBegin(); }
+    static ObjectIterator end(const QCborMap &o) { return o.constEnd(); }
+    static ObjectIterator find(const QCborMap &o, const QString &key) { return o.constFind(key); }
+    static bool contains(const QCborMap &o, const QString &key) { return o.contains(key); }
+    static QString key(const ObjectIterator &it)
+    {
+        const QCborValue k = it.key();
+        return k.isString() ? k.toString() : k.toDiagnosticNotation();
+    }
+    static QCborValue value(const ObjectIterator &it) { return it.value(); }
+
+    static int size(const QCborArray &a) { return int(a.size()); }
+    static QCborValue at(const QCborArray &a, int i) { return a.at(i); }
+};
+
+
+/**
+ * @brief Expression régulière compilée une fois (pattern, patternProperties, format).
+ *
+ * Deux moteurs :
+ *  - Backtracking : QRegularExpression (PCRE2), syntaxe complète, mais un motif malheureux
+ *    peut prendre un temps exponentiel sur un texte choisi (ReDoS) ;
+ *  - Linear : automate de Thompson, temps linéaire en la longueur du texte quel que soit
+ *    le motif. Couvre le sous-ensemble ECMA-262 recommandé par JSON Schema : littéraux,
+ *    ".", classes [...] et \d \w \s, groupes (capturants, nommés ou non), alternatives,
+ *    quantificateurs * + ? {n,m} (gourmands ou non), ancres ^ $ et \b \B. Les références
+ *    arrière, assertions avant / arrière, propriétés \p{...} et options en ligne sont
+ *    refusées (isValid() faux, errorString() en donne la raison).
+ *
+ * Le moteur linéaire suit la sémantique ECMA-262 : "$" ne correspond qu'en fin de texte,
+ * "." exclut les fins de ligne, \s inclut les espaces Unicode et le texte est lu par unités
+ * UTF-16. Sans assertion \b, l'automate est déterminisé au chargement (borné en taille) :
+ * un caractère coûte alors une lecture de table. Sinon, la simulation de l'automate non
+ * déterministe coûte au plus la taille du motif par caractère.
+ *
+ * Immuable une fois construite : partageable entre threads.
+ */
+class SwJsonSchemaRegex
+{
+public:
+    enum Engine { Backtracking, Linear };
+
+    SwJsonSchemaRegex() = default;
+
+    SwJsonSchemaRegex(const QString &pattern, Engine engine)
+        : m_pattern(pattern), m_engine(engine)
+    {
+        if (engine == Backtracking) {
+            m_backtracking = QRegularExpression(pattern);
+            if (!m_backtracking.isValid()) {
+                m_error = m_backtracking.errorString();
+            }
+            return;
+        }
+        QSharedPointer<Program> program(new Program);
+        Parser parser(pattern, *program);
+        if (!parser.compile(&m_error)) {
+            return;
+        }
+        program->buildDfa();
+        m_program = program;
+    }
+
+    bool isValid() const
+    {
+        return m_error.isEmpty();
+    }
+
+    QString errorString() const
+    {
+        return m_error;
+    }
+
+    QString pattern() const
+    {
+        return m_pattern;
+    }
+
+    Engine engine() const
+    {
+        return m_engine;
+    }
+
+    /// Vrai si l'automate linéaire est déterminisé (un accès table par caractère).
+    bool isDeterministic() const
+    {
+        return m_program && m_program->hasDfa;
+    }
+
+    /**
+     * @brief Octets alloués par l'automate linéaire, partagé entre copies : compté une seule
+     *        fois par `counted`. 0 avec QRegularExpression, dont PCRE2 n'expose pas la taille.
+     */
+    qint64 memoryUsage(QSet<const void*> &counted) const
+    {
+        if (!m_program || counted.contains(m_program.data())) {
+            return 0;
+        }
+        counted.insert(m_program.data());
+        const Program &program = *m_program;
+        qint64 bytes = sizeof(Program);
+        bytes += program.insts.capacity() * qint64(sizeof(Inst));
+        bytes += program.boundaries.capacity() * qint64(sizeof(ushort));
+        bytes += program.membership.capacity() + program.stateFlags.capacity();
+        bytes += program.transitions.capacity() * qint64(sizeof(int));
+        for (const Ranges &ranges : program.sets) {
+            bytes += sizeof(Ranges) + ranges.capacity() * qint64(sizeof(QPair<ushort, ushort>));
+        }
+        return bytes;
+    }
+
+    /// Risque de retour arrière catastrophique d'un motif avec le moteur Backtracking.
+    enum class BacktrackingRisk {
+        None,
+        Polynomial,   ///< Répétitions adjacentes qui se recouvrent (\w+\s*\w+, .*.*) : O(n^k)
+        Ambiguous,    ///< Alternative répétée dont des branches commencent pareil ((a|ab)*)
+        Exponential   ///< Répétition d'un groupe terminé par une répétition ((a+)+, (\w+\s?)*)
+    };
+
+    /**
+     * @brief Analyse syntaxique (heuristique) des constructions connues pour faire exploser
+     *        le retour arrière. Ne compile pas le motif ; les classes [...] ne sont comparées
+     *        que textuellement.
+     */
+    static BacktrackingRisk backtrackingRisk(const QString &pattern)
+    {
+        struct Group {
+            int         open = -1;           // Position de "("
+            bool        unbounded = false;   // Contient une répétition non bornée
+            bool        trailing = false;    // Une alternative se termine par une répétition non bornée
+            QStringList pending;             // Répétitions non bornées depuis le dernier atome obligatoire
+            QStringList firsts;              // Premier atome de chaque alternative
+            bool        atStart = true;      // Aucun atome lu dans l'alternative courante
+            bool        emptyAlternative = false;
+        };
+        BacktrackingRisk risk = BacktrackingRisk::None;
+        auto raise = [&risk](BacktrackingRisk level) {
+            if (int(level) > int(risk)) {
+                risk = level;
+            }
+        };
+        QVector<Group> groups(1);
+        const int n = int(pattern.size());
+        int i = 0;
+        while (i < n) {
+            const QChar c = pattern.at(i);
+            int atomStart = i;
+            Group closed;
+            bool isGroup = false;
+            if (c == '\\') {
+                i = qMin(n, i + 2);
+            } else if (c == '[') {
+                ++i;
+                if (i < n && pattern.at(i) == '^') ++i;
+                if (i < n && pattern.at(i) == ']') ++i;
+                while (i < n && pattern.at(i) != ']') {
+                    i += pattern.at(i) == '\\' ? 2 : 1;
+                }
+                i = qMin(n, i + 1);
+            } else if (c == '(') {
+                Group group;
+                group.open = i++;
+                if (i < n && pattern.at(i) == '?') {
+                    ++i;
+                    if (i + 1 < n && pattern.at(i) == '<' && pattern.at(i + 1) != '=' && pattern.at(i + 1) != '!') {
+                        while (i < n && pattern.at(i) != '>') ++i;
+                        ++i;
+                    } else {
+                        while (i < n && QString(":=!<").contains(pattern.at(i))) ++i;
+                    }
+                }
+                groups.append(group);
+                continue;
+            } else if (c == ')' && groups.size() > 1) {
+                closed = groups.takeLast();
+                closed.trailing = closed.trailing || !closed.pending.isEmpty();
+                closed.emptyAlternative = closed.emptyAlternative || closed.atStart;
+                atomStart = closed.open;
+                isGroup = true;
+                ++i;
+            } else if (c == '|') {
+                Group &current = groups.last();
+                current.trailing = current.trailing || !current.pending.isEmpty();
+                current.emptyAlternative = current.emptyAlternative || current.atStart;
+                current.pending.clear();
+                current.atStart = true;
+                ++i;
+                continue;
+            } else if (c == '^' || c == '$') {
+                ++i;
+                continue;
+            } else {
+                ++i;
+            }
+            const QString atom = pattern.mid(atomStart, i - atomStart);
+
+            // Quantificateur éventuel
+            bool unbounded = false;
+            bool repeated = false;
+            bool optional = false;
+            if (i < n) {
+                const QChar q = pattern.at(i);
+                if (q == '*' || q == '+') {
+                    unbounded = repeated = true;
+                    optional = (q == '*');
+                    ++i;
+                } else if (q == '?') {
+                    optional = true;
+                    ++i;
+                } else if (q == '{') {
+                    const int close = int(pattern.indexOf('}', i));
+                    const QStringList bounds = close > i ? pattern.mid(i + 1, close - i - 1).split(',') : QStringList();
+                    bool ok = false;
+                    const int min = bounds.isEmpty() ? 0 : bounds.first().toInt(&ok);
+                    if (ok && bounds.size() <= 2) {
+                        unbounded = bounds.size() == 2 && bounds.at(1).trimmed().isEmpty();
+                        repeated = unbounded || (bounds.size() == 2 ? bounds.at(1).toInt() : min) > 1;
+                        optional = (min == 0);
+                        i = close + 1;
+                    }
+                }
+                if ((repeated || optional) && i < n && pattern.at(i) == '?') {
+                    ++i;  // Quantificateur paresseux
                 }
             }
-            if (!found) {
-                return setError(errorMessage, "Valeur non listée dans 'enum'.");
+
+            Group &current = groups.last();
+            if (current.atStart) {
+                current.firsts << atom;
+                current.atStart = false;
             }
-        }
-        if (!m_constValue.isUndefined()) {
-            if (m_constValue != value) {
-                return setError(errorMessage, "Valeur différente de 'const'.");
+            if (isGroup && repeated) {
+                if (closed.trailing) {
+                    raise(BacktrackingRisk::Exponential);
+                } else if (unbounded && closed.emptyAlternative && closed.firsts.size() > 0) {
+                    raise(BacktrackingRisk::Ambiguous);
+                } else if (unbounded && closed.firsts.size() > 1) {
+                    for (int a = 0; a < closed.firsts.size(); ++a) {
+                        for (int b = a + 1; b < closed.firsts.size(); ++b) {
+                            if (atomsOverlap(closed.firsts.at(a), closed.firsts.at(b))) {
+                                raise(BacktrackingRisk::Ambiguous);
+                            }
+                        }
+                    }
+                }
+            }
+            if (unbounded || (isGroup && closed.unbounded)) {
+                current.unbounded = true;
+            }
+            if (unbounded) {
+                for (const QString &previous : current.pending) {
+                    if (atomsOverlap(previous, atom)) {
+                        raise(BacktrackingRisk::Polynomial);
+                    }
+                }
+                if (!optional) {
+                    current.pending.clear();
+                }
+                current.pending << atom;
+            } else if (!optional) {
+                current.pending.clear();
             }
         }
+        return risk;
+    }
 
-        // Vérifier le type
-        if (m_type != SchemaType::Invalid) {
-            if (!checkType(value)) {
-                return setError(errorMessage,
-                                QString("Type invalide. Attendu: %1, reçu: %2")
-                                    .arg(toString(m_type))
-                                    .arg(toString(value)));
+    /// Vrai si `subject` contient une correspondance (recherche non ancrée, comme "pattern").
+    bool match(const QString &subject) const
+    {
+        if (m_engine == Backtracking) {
+            return m_backtracking.match(subject).hasMatch();
+        }
+        return m_program && m_program->search(subject);
+    }
+
+private:
+    /// Deux atomes répétés peuvent-ils lire le même caractère (comparaison textuelle prudente) ?
+    static bool atomsOverlap(const QString &a, const QString &b)
+    {
+        if (a == b || a == "." || b == "." || a == "\\S" || b == "\\S") {
+            return true;
+        }
+        const QStringList word = {"\\w", "\\d"};
+        return word.contains(a) && word.contains(b);
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Programme (automate de Thompson)
+    // -----------------------------------------------------------------------
+    struct Inst {
+        enum Op : quint8 { Char, Split, Jump, AssertBegin, AssertEnd, WordBoundary, NotWordBoundary, Match };
+        Op  op;
+        int x = -1;  ///< Char : ensemble ; Split / Jump : cible
+        int y = -1;  ///< Split : seconde cible
+    };
+
+    using Ranges = QVector<QPair<ushort, ushort>>;  ///< Intervalles triés, disjoints
+
+    /// Contexte d'une position du texte pour les assertions.
+    struct Position {
+        bool atStart = false;
+        bool atEnd = false;
+        bool wordBefore = false;
+        bool wordAfter = false;
+        bool deferEnd = false;  ///< Fin de texte inconnue (déterminisation) : "$" reste en attente
+    };
+
+    struct Program {
+        static constexpr int MaxInstructions = 20000;
+        static constexpr int MaxDfaStates = 4096;
+        static constexpr int MaxDfaCells = 1 << 21;
+        static constexpr qint64 MaxDfaWork = 1 << 24;  ///< Instructions parcourues au plus par buildDfa()
+
+        enum StateFlag : quint8 { Matched = 1, MatchedAtEnd = 2, Dead = 4 };
+
+        QVector<Inst>   insts;
+        QVector<Ranges> sets;
+        bool            hasWordBoundary = false;
+
+        // Classes de caractères : deux caractères d'une même classe appartiennent aux mêmes ensembles
+        QVector<ushort> boundaries;
+        int             classCount = 1;
+        int             asciiClass[128] = {};
+        QVector<quint8> membership;  ///< sets.size() x classCount
+
+        // Automate déterminisé (état initial : 0)
+        bool            hasDfa = false;
+        QVector<int>    transitions;  ///< état x classCount
+        QVector<quint8> stateFlags;
+
+        int classOf(ushort c) const
+        {
+            if (c < 128) {
+                return asciiClass[c];
             }
+            return int(std::upper_bound(boundaries.cbegin(), boundaries.cend(), c) - boundaries.cbegin());
         }
 
-        // Validation détaillée
-        SchemaType currentType = m_type;
-        if(currentType == SchemaType::Invalid){
-            currentType = getType(value);
+        static bool isWordChar(ushort c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
         }
 
-        switch (currentType) {
-        case SchemaType::String:
-            if (!validateString(value, errorMessage)) return false;
-            break;
-        case SchemaType::Number:
-            if (!validateNumber(value, errorMessage)) return false;
-            break;
-        case SchemaType::Integer:
-            if (!validateNumber(value, errorMessage)) return false;
-            break;
-        case SchemaType::Boolean:
-            // rien de spécial
-            break;
-        case SchemaType::Object:
-            if (!validateObject(value, visited, errorMessage)) return false;
-            break;
-        case SchemaType::Array:
-            if (!validateArray(value, visited, errorMessage)) return false;
-            break;
-        case SchemaType::Null:
-            // rien
-            break;
-        case SchemaType::Invalid:
-        default:
-            // pas de type imposé
-            break;
+        void buildClasses()
+        {
+            for (const Ranges &ranges : sets) {
+                for (const auto &range : ranges) {
+                    boundaries << range.first;
+                    if (range.second < 0xFFFF) {
+                        boundaries << ushort(range.second + 1);
+                    }
+                }
+            }
+            std::sort(boundaries.begin(), boundaries.end());
+            boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+            classCount = boundaries.size() + 1;
+            for (int c = 0; c < 128; ++c) {
+                asciiClass[c] = int(std::upper_bound(boundaries.cbegin(), boundaries.cend(), ushort(c)) - boundaries.cbegin());
+            }
+            membership.fill(0, sets.size() * classCount);
+            for (int s = 0; s < sets.size(); ++s) {
+                for (int k = 0; k < classCount; ++k) {
+                    const ushort c = k == 0 ? 0 : boundaries.at(k - 1);
+                    for (const auto &range : sets.at(s)) {
+                        if (c >= range.first && c <= range.second) {
+                            membership[s * classCount + k] = 1;
+                            break;
+                        }
+                    }
+                }
+            }
         }
 
-        foreach(KeywordJsonValidator customValidator, m_internalCustomKeywordValidator){
-            if (!customValidator.validate(value, errorMessage)) return setError(errorMessage,
-                                       QString("Validation failed with error: %1")
-                                           .arg(*errorMessage));
+        /// Fermeture epsilon de `pc` : instructions Char / Match (et "$" en attente) atteintes.
+        void closure(int pc, const Position &at, QVector<int> &list, QVector<quint8> &seen) const
+        {
+            QVarLengthArray<int, 32> stack;
+            stack.append(pc);
+            while (!stack.isEmpty()) {
+                const int p = stack.back();
+                stack.removeLast();
+                if (seen[p]) {
+                    continue;
+                }
+                seen[p] = 1;
+                const Inst &inst = insts.at(p);
+                switch (inst.op) {
+                case Inst::Jump:            stack.append(inst.x); break;
+                case Inst::Split:           stack.append(inst.y); stack.append(inst.x); break;
+                case Inst::AssertBegin:     if (at.atStart) stack.append(p + 1); break;
+                case Inst::WordBoundary:    if (at.wordBefore != at.wordAfter) stack.append(p + 1); break;
+                case Inst::NotWordBoundary: if (at.wordBefore == at.wordAfter) stack.append(p + 1); break;
+                case Inst::AssertEnd:
+                    if (at.deferEnd) {
+                        list.append(p);
+                    } else if (at.atEnd) {
+                        stack.append(p + 1);
+                    }
+                    break;
+                case Inst::Char:
+                case Inst::Match:           list.append(p); break;
+                }
+            }
         }
 
-        return true;
-    }
+        /// Vrai si un "$" en attente dans `state` mène à Match en fin de texte.
+        bool matchesAtEnd(const QVector<int> &state, bool atStart) const
+        {
+            QVector<int> list;
+            QVector<quint8> seen(insts.size(), 0);
+            Position at;
+            at.atStart = atStart;
+            at.atEnd = true;
+            for (int pc : state) {
+                if (insts.at(pc).op == Inst::Match) {
+                    return true;
+                }
+                if (insts.at(pc).op == Inst::AssertEnd) {
+                    closure(pc + 1, at, list, seen);
+                }
+            }
+            for (int pc : list) {
+                if (insts.at(pc).op == Inst::Match) {
+                    return true;
+                }
+            }
+            return false;
+        }
 
-    // -- if/then/else, allOf, anyOf, oneOf --
-    bool applyConditional(const QJsonValue &value,
-                          QSet<const SwJsonSchema*> &visited,
-                          QString *errorMessage) const
-    {
-        m_ifThenElsePropertyValidated.clear();
-        if (!m_ifSchema) {
-            return true;
+        /**
+         * @brief Déterminisation par sous-ensembles, abandonnée au-delà de MaxDfaStates états
+         *        ou de MaxDfaWork instructions parcourues (la simulation non déterministe reste
+         *        linéaire) : un motif hostile ne peut pas bloquer le chargement.
+         */
+        void buildDfa()
+        {
+            buildClasses();
+            if (hasWordBoundary) {
+                return;
+            }
+            // Une correspondance peut commencer à toute position : l'entrée est réinjectée à chaque pas
+            QVector<int> injected;
+            {
+                QVector<quint8> seen(insts.size(), 0);
+                Position at;
+                at.deferEnd = true;
+                closure(0, at, injected, seen);
+            }
+            QVector<int> initial;
+            {
+                QVector<quint8> seen(insts.size(), 0);
+                Position at;
+                at.atStart = true;
+                at.deferEnd = true;
+                closure(0, at, initial, seen);
+            }
+            QHash<QByteArray, int> ids;
+            QVector<QVector<int>> states;
+            // L'état initial (début de texte) n'est jamais fusionné avec un état de même contenu
+            auto intern = [&](QVector<int> state) {
+                std::sort(state.begin(), state.end());
+                QByteArray key(reinterpret_cast<const char *>(state.constData()), int(state.size() * sizeof(int)));
+                key.append(states.isEmpty() ? 'i' : 'n');
+                auto it = ids.constFind(key);
+                if (it != ids.constEnd()) {
+                    return it.value();
+                }
+                const int id = states.size();
+                ids.insert(key, id);
+                states << state;
+                quint8 flags = matchesAtEnd(state, id == 0) ? MatchedAtEnd : 0;
+                for (int pc : state) {
+                    if (insts.at(pc).op == Inst::Match) {
+                        flags |= Matched;
+                    }
+                }
+                if (state.isEmpty() && injected.isEmpty()) {
+                    flags |= Dead;
+                }
+                stateFlags << flags;
+                return id;
+            };
+            intern(initial);
+            QVector<quint8> seen(insts.size(), 0);
+            qint64 work = 0;
+            for (int s = 0; s < states.size(); ++s) {
+                // Chaque transition remet "seen" à zéro et parcourt l'état puis les fermetures
+                work += qint64(classCount) * (insts.size() + states.at(s).size() + injected.size());
+                if (states.size() > MaxDfaStates || (s + 1) * classCount > MaxDfaCells || work > MaxDfaWork) {
+                    transitions.clear();
+                    stateFlags.clear();
+                    return;
+                }
+                for (int k = 0; k < classCount; ++k) {
+                    QVector<int> next;
+                    seen.fill(0);
+                    Position at;
+                    at.deferEnd = true;
+                    for (int pc : states.at(s)) {
+                        const Inst &inst = insts.at(pc);
+                        if (inst.op == Inst::Char && membership.at(inst.x * classCount + k)) {
+                            closure(pc + 1, at, next, seen);
+                        }
+                    }
+                    for (int pc : injected) {
+                        if (!seen[pc]) {
+                            seen[pc] = 1;
+                            next << pc;
+                        }
+                    }
+                    transitions << intern(next);
+                }
+            }
+            hasDfa = true;
         }
-        // si ifSchema satisfait
-        if (m_ifSchema->validateInternal(value, visited, nullptr)) {
-            // then
-            if (m_thenSchema && !m_thenSchema->validateInternal(value, visited, errorMessage)) {
-                return false;
+
+        bool search(const QString &subject) const
+        {
+            const QChar *text = subject.constData();
+            const int length = int(subject.size());
+            if (hasDfa) {
+                int state = 0;
+                for (int i = 0; i < length; ++i) {
+                    const quint8 flags = stateFlags.at(state);
+                    if (flags & (Matched | Dead)) {
+                        return flags & Matched;
+                    }
+                    state = transitions.at(state * classCount + classOf(text[i].unicode()));
+                }
+                return stateFlags.at(state) & (Matched | MatchedAtEnd);
+            }
+            // Simulation non déterministe (Pike) : une liste d'états par position
+            QVector<int> current, next;
+            QVector<quint8> seen(insts.size(), 0);
+            current.reserve(insts.size());
+            next.reserve(insts.size());
+            for (int i = 0; i <= length; ++i) {
+                Position at;
+                at.atStart = (i == 0);
+                at.atEnd = (i == length);
+                at.wordBefore = i > 0 && isWordChar(text[i - 1].unicode());
+                at.wordAfter = i < length && isWordChar(text[i].unicode());
+                // Les fils issus du pas précédent sont déjà marqués dans "seen"
+                closure(0, at, current, seen);
+                for (int pc : current) {
+                    if (insts.at(pc).op == Inst::Match) {
+                        return true;
+                    }
+                }
+                if (i == length) {
+                    break;
+                }
+                const int cls = classOf(text[i].unicode());
+                Position after;
+                after.atEnd = (i + 1 == length);
+                after.wordBefore = at.wordAfter;
+                after.wordAfter = i + 1 < length && isWordChar(text[i + 1].unicode());
+                next.clear();
+                seen.fill(0);
+                for (int pc : current) {
+                    const Inst &inst = insts.at(pc);
+                    if (inst.op == Inst::Char && membership.at(inst.x * classCount + cls)) {
+                        closure(pc + 1, after, next, seen);
+                    }
+                }
+                current.swap(next);
             }
-            if (m_thenSchema) {
-                m_ifThenElsePropertyValidated.unite(m_thenSchema->m_required);
+            return false;
+        }
+    };
+
+    // -----------------------------------------------------------------------
+    //                   Analyse du motif (sous-ensemble ECMA-262)
+    // -----------------------------------------------------------------------
+    class Parser {
+    public:
+        Parser(const QString &pattern, Program &program)
+            : m_text(pattern), m_program(program)
+        {
+        }
+
+        bool compile(QString *error)
+        {
+            const int root = parseDisjunction();
+            if (root >= 0 && m_pos < m_text.size()) {
+                fail("parenthèse fermante inattendue");
             }
-        } else {
-            // else
-            if (m_elseSchema && !m_elseSchema->validateInternal(value, visited, errorMessage)) {
+            if (root < 0 || !m_error.isEmpty()) {
+                *error = m_error;
                 return false;
             }
-            if (m_elseSchema) {
-                m_ifThenElsePropertyValidated.unite(m_elseSchema->m_required);
+            if (!emit(root)) {
+                *error = m_error;
+                return false;
             }
+            m_program.insts << Inst{Inst::Match, -1, -1};
+            return true;
         }
-        return true;
-    }
 
-    bool checkAllOf(const QJsonValue &value,
-                    QSet<const SwJsonSchema*> &visited,
-                    QString *errorMessage) const
-    {
-        for (int i = 0; i < m_allOf.size(); ++i) {
-            if (!m_allOf[i].validateInternal(value, visited, errorMessage)) {
-                return setError(errorMessage, QString("Echec de allOf[%1]. %2")
-                                    .arg(i)
-                                    .arg(errorMessage ? *errorMessage : ""));
+    private:
+        struct Node {
+            enum Kind : quint8 { Empty, Set, Concat, Alternation, Repeat, Begin, End, WordBoundary, NotWordBoundary };
+            Kind kind = Empty;
+            int set = -1;
+            int min = 0;
+            int max = -1;  ///< -1 : illimité
+            QVector<int> children;
+        };
+
+        int fail(const QString &reason)
+        {
+            if (m_error.isEmpty()) {
+                m_error = QString("%1 (position %2)").arg(reason).arg(m_pos);
             }
+            return -1;
         }
-        return true;
-    }
 
-    bool checkAnyOf(const QJsonValue &value,
-                    QSet<const SwJsonSchema*> &visited,
-                    QString *errorMessage) const
-    {
-        if (m_anyOf.isEmpty()) return true;
-        for (int i = 0; i < m_anyOf.size(); ++i) {
-            QString localErr;
-            QSet<const SwJsonSchema*> visitedCopy(visited);
-            if (m_anyOf[i].validateInternal(value, visitedCopy, &localErr)) {
-                return true;  // au moins un match => OK
+        int add(Node node)
+        {
+            m_nodes << node;
+            return m_nodes.size() - 1;
+        }
+
+        int addSet(const Ranges &ranges)
+        {
+            Node node;
+            node.kind = Node::Set;
+            node.set = m_program.sets.size();
+            m_program.sets << ranges;
+            return add(node);
+        }
+
+        bool atEnd() const
+        {
+            return m_pos >= m_text.size();
+        }
+
+        ushort peek(int offset = 0) const
+        {
+            return m_pos + offset < m_text.size() ? m_text.at(m_pos + offset).unicode() : 0;
+        }
+
+        static Ranges normalized(Ranges ranges)
+        {
+            std::sort(ranges.begin(), ranges.end());
+            Ranges out;
+            for (const auto &range : ranges) {
+                if (!out.isEmpty() && int(range.first) <= int(out.last().second) + 1) {
+                    out.last().second = qMax(out.last().second, range.second);
+                } else {
+                    out << range;
+                }
             }
+            return out;
         }
-        return setError(errorMessage, "Aucun schéma dans 'anyOf' n'est satisfait.");
-    }
 
-    bool checkOneOf(const QJsonValue &value,
-                    QSet<const SwJsonSchema*> &visited,
-                    QString *errorMessage) const
-    {
-        if (m_oneOf.isEmpty()) return true;
-        int countValid = 0;
-        QString lastError;
-        for (int i = 0; i < m_oneOf.size(); ++i) {
-            QString localErr;
-            QSet<const SwJsonSchema*> visitedCopy(visited);
-            if (m_oneOf[i].validateInternal(value, visitedCopy, &localErr)) {
-                countValid++;
-                if (countValid > 1) {
-                    return setError(errorMessage, "Plus d'un schéma dans 'oneOf' est satisfait.");
+        static Ranges complement(const Ranges &ranges)
+        {
+            Ranges out;
+            int next = 0;
+            for (const auto &range : ranges) {
+                if (range.first > next) {
+                    out << qMakePair(ushort(next), ushort(range.first - 1));
                 }
-            } else {
-                lastError = localErr;
+                next = range.second + 1;
+            }
+            if (next <= 0xFFFF) {
+                out << qMakePair(ushort(next), ushort(0xFFFF));
             }
+            return out;
         }
-        if (countValid == 1) {
-            return true;
-        } else {
-            return setError(errorMessage,
-                            QString("Aucun schéma dans 'oneOf' n'est satisfait. Dernière erreur: %1").arg(lastError));
+
+        static Ranges single(ushort c)
+        {
+            return Ranges{qMakePair(c, c)};
         }
-    }
 
-    // -- validations de type --
-    bool validateString(const QJsonValue &value, QString *errorMessage) const
-    {
-        QString str = value.toString();
-        if (m_minLength >= 0 && str.size() < m_minLength) {
-            return setError(errorMessage, QString("Longueur trop petite: %1 < %2").arg(str.size()).arg(m_minLength));
+        static Ranges classEscape(ushort c)
+        {
+            static const Ranges digits{{'0', '9'}};
+            static const Ranges word{{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+            static const Ranges space{{0x09, 0x0D}, {0x20, 0x20}, {0xA0, 0xA0}, {0x1680, 0x1680}, {0x2000, 0x200A},
+                                      {0x2028, 0x2029}, {0x202F, 0x202F}, {0x205F, 0x205F}, {0x3000, 0x3000},
+                                      {0xFEFF, 0xFEFF}};
+            switch (c) {
+            case 'd': return digits;
+            case 'D': return complement(digits);
+            case 'w': return word;
+            case 'W': return complement(word);
+            case 's': return space;
+            default:  return complement(space);
+            }
         }
-        if (m_maxLength >= 0 && str.size() > m_maxLength) {
-            return setError(errorMessage, QString("Longueur trop grande: %1 > %2").arg(str.size()).arg(m_maxLength));
+
+        static bool isClassEscape(ushort c)
+        {
+            return c == 'd' || c == 'D' || c == 'w' || c == 'W' || c == 's' || c == 'S';
+        }
+
+        static int hexValue(ushort c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
         }
-        if (m_hasPattern) {
-            QRegularExpression re(m_pattern);
-            if (!re.match(str).hasMatch()) {
-                return setError(errorMessage, QString("Ne correspond pas au pattern: %1").arg(m_pattern));
+
+        /// Lit `count` chiffres hexadécimaux ; -1 (position inchangée) s'ils manquent.
+        int readHex(int count)
+        {
+            int value = 0;
+            for (int i = 0; i < count; ++i) {
+                const int digit = hexValue(peek(i));
+                if (digit < 0) {
+                    return -1;
+                }
+                value = value * 16 + digit;
             }
+            m_pos += count;
+            return value;
         }
-        if (!m_format.isEmpty()) {
-            if (!checkFormat(str, m_format, errorMessage)) {
-                return false;
+
+        /**
+         * @brief Caractère désigné par l'échappement courant (après "\"), ou -1 en cas d'erreur.
+         * @param inClass  \b désigne le retour arrière dans une classe
+         */
+        int escapedChar(bool inClass)
+        {
+            const ushort c = peek();
+            ++m_pos;
+            switch (c) {
+            case 't': return '\t';
+            case 'n': return '\n';
+            case 'v': return '\v';
+            case 'f': return '\f';
+            case 'r': return '\r';
+            case 'b': return inClass ? '\b' : fail("\\b inattendu");
+            case '0':
+                if (peek() >= '0' && peek() <= '9') {
+                    return fail("échappement octal non pris en charge");
+                }
+                return 0;
+            case 'c':
+                if ((peek() >= 'a' && peek() <= 'z') || (peek() >= 'A' && peek() <= 'Z')) {
+                    return m_text.at(m_pos++).unicode() % 32;
+                }
+                return fail("\\c sans lettre de contrôle");
+            case 'x': {
+                if (peek() == '{') {
+                    ++m_pos;
+                    int value = 0;
+                    int digits = 0;
+                    while (hexValue(peek()) >= 0 && value <= 0xFFFF) {
+                        value = value * 16 + hexValue(peek());
+                        ++m_pos;
+                        ++digits;
+                    }
+                    if (peek() != '}' || digits == 0 || value > 0xFFFF) {
+                        return fail("\\x{...} invalide ou hors du plan multilingue de base");
+                    }
+                    ++m_pos;
+                    return value;
+                }
+                const int value = readHex(2);
+                return value >= 0 ? value : 'x';
+            }
+            case 'u': {
+                const int value = readHex(4);
+                return value >= 0 ? value : 'u';
+            }
+            case 'p':
+            case 'P':
+                return fail("propriété Unicode \\p{...} non prise en charge");
+            case 'k':
+                return fail("référence arrière nommée non prise en charge");
+            case 0:
+                return fail("échappement en fin de motif");
+            default:
+                if (c >= '1' && c <= '9') {
+                    return fail("référence arrière non prise en charge");
+                }
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+                    // \A, \z, \h, \R... : sens propre à PCRE
+                    return fail(QString("échappement \\%1 non pris en charge").arg(QChar(c)));
+                }
+                return c;  // échappement d'identité : \. \/ \- \\ ...
             }
         }
-        return true;
+
+        int parseDisjunction()
+        {
+            QVector<int> alternatives;
+            const int first = parseAlternative();
+            if (first < 0) {
+                return -1;
+            }
+            alternatives << first;
+            while (peek() == '|' && !atEnd()) {
+                ++m_pos;
+                const int next = parseAlternative();
+                if (next < 0) {
+                    return -1;
+                }
+                alternatives << next;
+            }
+            if (alternatives.size() == 1) {
+                return alternatives.first();
+            }
+            Node node;
+            node.kind = Node::Alternation;
+            node.children = alternatives;
+            return add(node);
+        }
+
+        int parseAlternative()
+        {
+            Node node;
+            node.kind = Node::Concat;
+            while (!atEnd() && peek() != '|' && peek() != ')') {
+                const int term = parseTerm();
+                if (term < 0) {
+                    return -1;
+                }
+                node.children << term;
+            }
+            return add(node);
+        }
+
+        int parseTerm()
+        {
+            const ushort c = peek();
+            Node assertion;
+            if (c == '^') {
+                assertion.kind = Node::Begin;
+            } else if (c == '$') {
+                assertion.kind = Node::End;
+            } else if (c == '\\' && (peek(1) == 'b' || peek(1) == 'B')) {
+                assertion.kind = peek(1) == 'b' ? Node::WordBoundary : Node::NotWordBoundary;
+                m_program.hasWordBoundary = true;
+                ++m_pos;
+            }
+            if (assertion.kind != Node::Empty) {
+                ++m_pos;
+                if (isQuantifier()) {
+                    return fail("quantificateur appliqué à une assertion");
+                }
+                return add(assertion);
+            }
+            const int atom = parseAtom();
+            if (atom < 0) {
+                return -1;
+            }
+            return parseQuantifier(atom);
+        }
+
+        /// Vrai si un quantificateur commence à la position courante.
+        bool isQuantifier()
+        {
+            const ushort c = peek();
+            if (c == '*' || c == '+' || c == '?') {
+                return true;
+            }
+            if (c != '{') {
+                return false;
+            }
+            const int save = m_pos;
+            int min = 0;
+            int max = 0;
+            const bool ok = readBraces(min, max);
+            m_pos = save;
+            return ok;
+        }
+
+        /// Lit "{n}", "{n,}" ou "{n,m}" ; faux (position indéterminée) si ce n'en est pas un.
+        bool readBraces(int &min, int &max)
+        {
+            ++m_pos;
+            auto number = [this](int &value) {
+                const int start = m_pos;
+                qint64 parsed = 0;
+                while (peek() >= '0' && peek() <= '9' && m_pos < m_text.size()) {
+                    parsed = qMin<qint64>(parsed * 10 + (peek() - '0'), Program::MaxInstructions + 1);
+                    ++m_pos;
+                }
+                value = int(parsed);
+                return m_pos > start;
+            };
+            if (!number(min)) {
+                return false;
+            }
+            max = min;
+            if (peek() == ',') {
+                ++m_pos;
+                if (!number(max)) {
+                    max = -1;
+                }
+            }
+            if (peek() != '}') {
+                return false;
+            }
+            ++m_pos;
+            return true;
+        }
+
+        int parseQuantifier(int atom)
+        {
+            const ushort c = peek();
+            Node node;
+            node.kind = Node::Repeat;
+            node.children << atom;
+            if (c == '*' || c == '+' || c == '?') {
+                ++m_pos;
+                node.min = (c == '+') ? 1 : 0;
+                node.max = (c == '?') ? 1 : -1;
+            } else if (c == '{' && isQuantifier()) {
+                readBraces(node.min, node.max);
+                if (node.max >= 0 && node.max < node.min) {
+                    return fail("quantificateur {n,m} avec n > m");
+                }
+            } else {
+                return atom;
+            }
+            if (peek() == '?') {
+                ++m_pos;  // non gourmand : même ensemble de correspondances
+            }
+            if (isQuantifier()) {
+                return fail("quantificateur répété");
+            }
+            return add(node);
+        }
+
+        int parseAtom()
+        {
+            const ushort c = peek();
+            switch (c) {
+            case '(':
+                return parseGroup();
+            case '[':
+                return parseClass();
+            case '.':
+                ++m_pos;
+                return addSet(complement(Ranges{{'\n', '\n'}, {'\r', '\r'}, {0x2028, 0x2029}}));
+            case '*':
+            case '+':
+            case '?':
+                return fail("quantificateur sans objet");
+            case '{':
+                if (isQuantifier()) {
+                    return fail("quantificateur sans objet");
+                }
+                ++m_pos;
+                return addSet(single('{'));
+            case '\\': {
+                ++m_pos;
+                if (isClassEscape(peek())) {
+                    return addSet(classEscape(m_text.at(m_pos++).unicode()));
+                }
+                const int value = escapedChar(false);
+                return value < 0 ? -1 : addSet(single(ushort(value)));
+            }
+            default:
+                ++m_pos;
+                return addSet(single(c));
+            }
+        }
+
+        int parseGroup()
+        {
+            ++m_pos;
+            if (peek() == '?') {
+                if (peek(1) == ':') {
+                    m_pos += 2;
+                } else if (peek(1) == '=' || peek(1) == '!') {
+                    return fail("assertion avant (?= / ?!) non prise en charge");
+                } else if (peek(1) == '<' && (peek(2) == '=' || peek(2) == '!')) {
+                    return fail("assertion arrière (?<= / ?<!) non prise en charge");
+                } else if (peek(1) == '<' || (peek(1) == 'P' && peek(2) == '<')) {
+                    // groupe nommé : (?<nom>...) ou (?P<nom>...)
+                    const int close = m_text.indexOf('>', m_pos);
+                    if (close < 0) {
+                        return fail("nom de groupe non terminé");
+                    }
+                    m_pos = close + 1;
+                } else {
+                    return fail("construction (?...) non prise en charge");
+                }
+            }
+            const int inner = parseDisjunction();
+            if (inner < 0) {
+                return -1;
+            }
+            if (peek() != ')' || atEnd()) {
+                return fail("parenthèse non fermée");
+            }
+            ++m_pos;
+            return inner;
+        }
+
+        int parseClass()
+        {
+            ++m_pos;
+            bool negated = false;
+            if (peek() == '^') {
+                negated = true;
+                ++m_pos;
+            }
+            if (peek() == ']') {
+                // [] et [^] : sens différents en ECMA-262 et en PCRE
+                return fail("classe commençant par ']' non prise en charge");
+            }
+            Ranges ranges;
+            while (true) {
+                if (atEnd()) {
+                    return fail("classe [...] non fermée");
+                }
+                if (peek() == ']') {
+                    ++m_pos;
+                    break;
+                }
+                if (peek() == '[' && (peek(1) == ':' || peek(1) == '.' || peek(1) == '=')) {
+                    return fail("classe POSIX [:...:] non prise en charge");
+                }
+                Ranges atomSet;
+                const int low = classAtom(atomSet);
+                if (low == -2) {
+                    return -1;
+                }
+                if (peek() == '-' && peek(1) != ']' && m_pos + 1 < m_text.size()) {
+                    const int save = m_pos;
+                    ++m_pos;
+                    Ranges highSet;
+                    const int high = classAtom(highSet);
+                    if (high == -2) {
+                        return -1;
+                    }
+                    if (low >= 0 && high >= 0) {
+                        if (high < low) {
+                            return fail("intervalle de classe inversé");
+                        }
+                        ranges << qMakePair(ushort(low), ushort(high));
+                        continue;
+                    }
+                    // intervalle avec \d, \w... : "-" littéral (ECMA-262, annexe B)
+                    m_pos = save;
+                }
+                if (low >= 0) {
+                    ranges << qMakePair(ushort(low), ushort(low));
+                } else {
+                    ranges += atomSet;
+                }
+            }
+            ranges = normalized(ranges);
+            return addSet(negated ? complement(ranges) : ranges);
+        }
+
+        /// Élément de classe : caractère (>= 0), ensemble (-1, dans `set`) ou erreur (-2).
+        int classAtom(Ranges &set)
+        {
+            const ushort c = peek();
+            ++m_pos;
+            if (c != '\\') {
+                return c;
+            }
+            if (isClassEscape(peek())) {
+                set = classEscape(m_text.at(m_pos++).unicode());
+                return -1;
+            }
+            if (peek() == '-') {
+                ++m_pos;
+                return '-';
+            }
+            const int value = escapedChar(true);
+            return value < 0 ? -2 : value;
+        }
+
+        // -------------------------------------------------------------------
+        //          Émission des instructions (construction de Thompson)
+        // -------------------------------------------------------------------
+        int emitInst(Inst::Op op)
+        {
+            m_program.insts << Inst{op, -1, -1};
+            return m_program.insts.size() - 1;
+        }
+
+        bool emit(int index)
+        {
+            if (m_program.insts.size() > Program::MaxInstructions) {
+                m_error = QString("motif trop grand pour le moteur linéaire (plus de %1 instructions)")
+                              .arg(Program::MaxInstructions);
+                return false;
+            }
+            const Node node = m_nodes.at(index);
+            switch (node.kind) {
+            case Node::Empty:
+                return true;
+            case Node::Set:
+                m_program.insts << Inst{Inst::Char, node.set, -1};
+                return true;
+            case Node::Begin:
+                emitInst(Inst::AssertBegin);
+                return true;
+            case Node::End:
+                emitInst(Inst::AssertEnd);
+                return true;
+            case Node::WordBoundary:
+                emitInst(Inst::WordBoundary);
+                return true;
+            case Node::NotWordBoundary:
+                emitInst(Inst::NotWordBoundary);
+                return true;
+            case Node::Concat:
+                for (int child : node.children) {
+                    if (!emit(child)) {
+                        return false;
+                    }
+                }
+                return true;
+            case Node::Alternation: {
+                QVector<int> jumps;
+                for (int i = 0; i < node.children.size(); ++i) {
+                    if (i + 1 == node.children.size()) {
+                        if (!emit(node.children.at(i))) {
+                            return false;
+                        }
+                        break;
+                    }
+                    const int split = emitInst(Inst::Split);
+                    m_program.insts[split].x = split + 1;
+                    if (!emit(node.children.at(i))) {
+                        return false;
+                    }
+                    jumps << emitInst(Inst::Jump);
+                    m_program.insts[split].y = m_program.insts.size();
+                }
+                for (int jump : jumps) {
+                    m_program.insts[jump].x = m_program.insts.size();
+                }
+                return true;
+            }
+            case Node::Repeat: {
+                const int child = node.children.first();
+                for (int i = 0; i < node.min; ++i) {
+                    if (!emit(child)) {
+                        return false;
+                    }
+                }
+                if (node.max < 0) {
+                    const int split = emitInst(Inst::Split);
+                    m_program.insts[split].x = split + 1;
+                    if (!emit(child)) {
+                        return false;
+                    }
+                    const int jump = emitInst(Inst::Jump);
+                    m_program.insts[jump].x = split;
+                    m_program.insts[split].y = m_program.insts.size();
+                    return true;
+                }
+                QVector<int> splits;
+                for (int i = node.min; i < node.max; ++i) {
+                    const int split = emitInst(Inst::Split);
+                    m_program.insts[split].x = split + 1;
+                    splits << split;
+                    if (!emit(child)) {
+                        return false;
+                    }
+                }
+                for (int split : splits) {
+                    m_program.insts[split].y = m_program.insts.size();
+                }
+                return true;
+            }
+            }
+            return true;
+        }
+
+        const QString &m_text;
+        Program       &m_program;
+        QVector<Node>  m_nodes;
+        int            m_pos = 0;
+        QString        m_error;
+    };
+
+    QString m_pattern;
+    Engine m_engine = Backtracking;
+    QString m_error;
+    QRegularExpression m_backtracking;
+    QSharedPointer<const Program> m_program;
+};
+
+
+/**
+ * @brief Entrée de $defs / definitions compilée à sa première résolution.
+ *
+ * Les compilations différées sont sérialisées par compileMutex() : elles enregistrent
+ * leurs propres sous-définitions. Le schéma compilé tient ses motifs non supportés, il
+ * ne modifie aucun schéma déjà publié.
+ * Une fois compilée, la résolution ne coûte qu'une lecture atomique.
+ */
+class SwJsonSchemaLazyDefinition
+{
+public:
+    explicit SwJsonSchemaLazyDefinition(std::function<SwJsonSchema*()> compile)
+        : m_compile(std::move(compile))
+    {
+    }
+
+    SwJsonSchema *get()
+    {
+        SwJsonSchema *schema = m_schema.loadAcquire();
+        if (schema) {
+            return schema;
+        }
+        QMutexLocker locker(&compileMutex());
+        schema = m_schema.loadAcquire();
+        if (!schema) {
+            schema = m_compile();
+            m_compile = nullptr;
+            m_schema.storeRelease(schema);
+            compiledCount().ref();
+        }
+        return schema;
+    }
+
+    /// Schéma compilé, nul tant qu'aucune résolution ne l'a demandé
+    SwJsonSchema *compiled() const
+    {
+        return m_schema.loadAcquire();
+    }
+
+    static QMutex &compileMutex()
+    {
+        static QMutex mutex;
+        return mutex;
+    }
+
+    /// Définitions différées / compilées depuis le démarrage (tous registres confondus)
+    static QAtomicInt &deferredCount()
+    {
+        static QAtomicInt count(0);
+        return count;
+    }
+
+    static QAtomicInt &compiledCount()
+    {
+        static QAtomicInt count(0);
+        return count;
+    }
+
+private:
+    std::function<SwJsonSchema*()> m_compile;
+    QAtomicPointer<SwJsonSchema>   m_schema;
+};
+
+
+/**
+ * @brief Classe de registre pour les schémas JSON.
+ *
+ * Permet de stocker et de retrouver des SwJsonSchema par leur $id et/ou $anchor.
+ * Gère également la résolution basique de $ref du style "<id>#anchor" ou "#anchor".
+ */
+class SwJsonSchemaRegistry
+{
+public:
+    SwJsonSchemaRegistry() = default;
+    ~SwJsonSchemaRegistry() = default;
+
+    // Schémas chargés et validés depuis plusieurs threads : écritures au chargement,
+    // lectures à chaque $ref résolu.
+    void registerSchemaByAnchor(const QString &fullAnchor, SwJsonSchema *schema)
+    {
+        if (!fullAnchor.isEmpty()) {
+            QWriteLocker locker(&m_lock);
+            m_lazyByAnchor.remove(fullAnchor);
+            m_schemasByAnchor[fullAnchor] = schema;
+        }
+    }
+
+    void registerLazySchemaByAnchor(const QString &fullAnchor, const QSharedPointer<SwJsonSchemaLazyDefinition> &definition)
+    {
+        if (!fullAnchor.isEmpty()) {
+            QWriteLocker locker(&m_lock);
+            m_schemasByAnchor.remove(fullAnchor);
+            m_lazyByAnchor[fullAnchor] = definition;
+        }
+    }
+
+    void registerSchemaByRef(const QString &path, SwJsonSchema *schema)
+    {
+        if (!path.isEmpty()) {
+            QWriteLocker locker(&m_lock);
+            m_schemasByRef[path] = schema;
+        }
+    }
+
+    /**
+     * @brief Tente de résoudre une référence "$ref".
+     *        ex: "https://example.com/sch1#someAnchor"
+     *            "#/defs/foo"
+     *            "#myAnchor"
+     * @return Le schéma pointé, ou nullptr si introuvable.
+     */
+    SwJsonSchema* resolveRef(const QString &ref, const QString &baseUri, bool &found) const
+    {
+        QSharedPointer<SwJsonSchemaLazyDefinition> lazy;
+        SwJsonSchema *schema = lookupRef(ref, baseUri, found, lazy);
+        // Compilée hors du verrou : elle enregistre ses sous-définitions dans ce registre
+        return lazy ? lazy->get() : schema;
+    }
+
+    /// Schémas compilés de ce registre (ancres, définitions, documents référencés) ; `deferred`
+    /// reçoit le nombre de définitions encore différées.
+    void collectSchemas(QVector<const SwJsonSchema*> &schemas, int &deferred) const
+    {
+        QReadLocker locker(&m_lock);
+        for (SwJsonSchema *schema : m_schemasByAnchor) {
+            schemas << schema;
+        }
+        for (SwJsonSchema *schema : m_schemasByRef) {
+            schemas << schema;
+        }
+        for (const QSharedPointer<SwJsonSchemaLazyDefinition> &definition : m_lazyByAnchor) {
+            if (SwJsonSchema *schema = definition->compiled()) {
+                schemas << schema;
+            } else {
+                ++deferred;
+            }
+        }
+    }
+
+private:
+    /// Entrée "anchor" : schéma compilé ou définition différée (lazy)
+    bool findAnchor(const QString &anchor, SwJsonSchema *&schema, QSharedPointer<SwJsonSchemaLazyDefinition> &lazy) const
+    {
+        auto it = m_schemasByAnchor.constFind(anchor);
+        if (it != m_schemasByAnchor.constEnd()) {
+            schema = it.value();
+            return true;
+        }
+        auto lazyIt = m_lazyByAnchor.constFind(anchor);
+        if (lazyIt != m_lazyByAnchor.constEnd()) {
+            lazy = lazyIt.value();
+            return true;
+        }
+        return false;
+    }
+
+    SwJsonSchema* lookupRef(const QString &ref, const QString &baseUri, bool &found,
+                            QSharedPointer<SwJsonSchemaLazyDefinition> &lazy) const
+    {
+        QReadLocker locker(&m_lock);
+        found = true;
+        SwJsonSchema *schema = nullptr;
+        // Résolution simplifiée : on coupe autour du '#'
+        QString localBaseURI = baseUri.split("/").last();
+        QString localRef = ref;
+        if (localRef.startsWith(baseUri)) {
+            localRef.remove(0, baseUri.length()); // Supprime uniquement la première occurrence au début
+        }
+        if (localRef.startsWith(localBaseURI)) {
+            localRef.remove(0, localBaseURI.length()); // Supprime uniquement la première occurrence au début
+        }
+
+
+        if(findAnchor(localRef, schema, lazy)){
+            return schema;
+        }
+        QString anchor;
+        QString idPart = ref;
+        if (ref.contains('#')) {
+            int idx = ref.indexOf('#');
+            idPart = ref.left(idx).trimmed();
+            anchor = ref.mid(idx + 1).trimmed(); // sans le '#'
+        }
+
+        // 1) Si idPart est vide => on cherche "#anchor" direct
+        if (idPart.isEmpty()) {
+            QString fullAnchor = "#" + anchor;
+            QString fullLocalAnchor = baseUri + "#" + anchor;
+            if(findAnchor(fullAnchor, schema, lazy)){
+                return schema;
+            }
+
+            if(findAnchor(fullLocalAnchor, schema, lazy)){
+                return schema;
+            }
+        }
+
+        // 4) Sinon, on teste "idPart#anchor"
+        QString fullAnchor = baseUri + "#" + anchor;
+        if (findAnchor(fullAnchor, schema, lazy)) {
+            return schema;
+        }
+
+        foreach(auto key, m_schemasByRef.keys()){
+            if(idPart != "" && key.endsWith(idPart)){
+                found = false;
+                return m_schemasByRef.value(key);
+            }
+        }
+
+        return nullptr;
+    }
+
+    mutable QReadWriteLock       m_lock;
+    QMap<QString, SwJsonSchema*> m_schemasByAnchor;  ///< Map "id#anchor" ou "#anchor" -> schéma
+    QMap<QString, QSharedPointer<SwJsonSchemaLazyDefinition>> m_lazyByAnchor;  ///< Définitions pas encore compilées
+    QMap<QString, SwJsonSchema*> m_schemasByRef;     ///< Map "path" -> schéma
+};
+
+
+/**
+ * @brief Propriétaire des registres de $ref d'un ensemble de schémas et des noeuds qu'ils
+ *        référencent hors de l'arbre d'un document (définitions $defs, documents chargés
+ *        pour une $ref externe).
+ *
+ * Un schéma racine construit sans contexte (depuis un chemin ou un objet) crée le sien : ses
+ * $id, $anchor et documents externes ne sont visibles que de lui et de ses copies, et sont
+ * libérés avec la dernière d'entre elles.
+ *
+ * Un schéma racine construit avec un contexte ne voit que les registres de ce contexte : les
+ * schémas de même $id ou de même nom de fichier ne se mélangent pas d'un contexte à l'autre,
+ * et la destruction du contexte libère ses registres et ses noeuds. Le contexte doit survivre
+ * aux schémas qui l'utilisent.
+ *
+ * Le contexte global (global()) ne s'utilise que passé explicitement. Ses registres et les
+ * noeuds qu'ils référencent ne sont jamais libérés, et ils sont partagés par tout le
+ * processus : deux schémas de même $id ou de même nom de fichier y mélangent leurs entrées,
+ * même chargés à des moments différents.
+ */
+class SwJsonSchemaContext
+{
+public:
+    /// Registres et noeuds détenus
+    struct Statistics {
+        int registries = 0;
+        int nodes = 0;
+    };
+
+    SwJsonSchemaContext()
+        : m_global(false)
+    {
+    }
+
+    ~SwJsonSchemaContext();
+
+    SwJsonSchemaContext(const SwJsonSchemaContext &) = delete;
+    SwJsonSchemaContext &operator=(const SwJsonSchemaContext &) = delete;
+
+    /// Registre d'une URI de base (insensible à la casse), créé à la première demande
+    SwJsonSchemaRegistry *registry(const QString &baseUri)
+    {
+        const QString key = baseUri.toLower();
+        {
+            QReadLocker locker(&m_lock);
+            SwJsonSchemaRegistry *registry = m_registries.value(key);
+            if (registry) {
+                return registry;
+            }
+        }
+        QWriteLocker locker(&m_lock);
+        if (!m_registries.contains(key)) {
+            m_registries.insert(key, new SwJsonSchemaRegistry());
+            if (!m_global) {
+                liveCount(false).ref();
+            }
+        }
+        return m_registries.value(key);
+    }
+
+    /// Prend possession d'un noeud alloué hors de l'arbre d'un document (libéré avec le contexte).
+    void adopt(SwJsonSchema *node)
+    {
+        if (m_global) {
+            return;
+        }
+        QMutexLocker locker(&m_nodesMutex);
+        m_nodes << node;
+        liveCount(true).ref();
+    }
+
+    Statistics statistics() const
+    {
+        Statistics statistics;
+        {
+            QReadLocker locker(&m_lock);
+            statistics.registries = m_registries.size();
+        }
+        QMutexLocker locker(&m_nodesMutex);
+        statistics.nodes = m_nodes.size();
+        return statistics;
+    }
+
+    /// Registres et noeuds détenus par tous les contextes vivants, hors contexte global
+    static Statistics liveStatistics()
+    {
+        Statistics statistics;
+        statistics.registries = liveCount(false).loadRelaxed();
+        statistics.nodes = liveCount(true).loadRelaxed();
+        return statistics;
+    }
+
+    /// Contexte partagé par tout le processus, jamais détruit : SwJsonSchema(SwJsonSchemaContext::global(), ...)
+    static SwJsonSchemaContext &global()
+    {
+        static SwJsonSchemaContext *context = new SwJsonSchemaContext(true);
+        return *context;
+    }
+
+private:
+    explicit SwJsonSchemaContext(bool global)
+        : m_global(global)
+    {
+    }
+
+    static QAtomicInt &liveCount(bool nodes)
+    {
+        static QAtomicInt registries(0);
+        static QAtomicInt adopted(0);
+        return nodes ? adopted : registries;
+    }
+
+    const bool m_global;  ///< Contexte global : noeuds non suivis, comme avant les contextes
+    mutable QReadWriteLock m_lock;
+    QMap<QString, SwJsonSchemaRegistry *> m_registries;
+    mutable QMutex m_nodesMutex;
+    QVector<SwJsonSchema *> m_nodes;
+};
+
+
+/**
+ * @brief Classe SwJsonSchema : représente un schéma JSON, capable de valider un QJsonValue.
+ *
+ * - Un **seul** constructeur public : prend un chemin (ou URL) vers un fichier JSON Schema.
+ * - Lit le fichier local, parse le JSON, et charge récursivement les sous-schemas.
+ * - Gère $id, $anchor, $ref (résolution via un registry, si fourni).
+ * - Gère if/then/else, allOf/anyOf/oneOf, etc.
+ * - Évite les boucles de référence via un set de "visited".
+ */
+class SwJsonSchema
+{
+    // Générateur de validateurs C++ (tools/SwJsonSchemaCodegen) : lit l'arbre compilé
+    friend class SwJsonSchemaCodeGenerator;
+    // Chargement parallèle : compile les documents à part et lie leurs $ref externes
+    friend class SwJsonSchemaLoader;
+    friend class SwJsonSchemaSet;
+
+public:
+
+    enum class SchemaType {
+        Invalid,
+        String,
+        Number,
+        Integer,
+        Boolean,
+        Object,
+        Array,
+        Null
+    };
+
+    /**
+     * @brief Ensemble de types admis par "type" ("string" ou ["string", "null"]) : un bit
+     *        par SchemaType. "number" admet aussi les entiers : son masque contient le bit
+     *        Integer. Masque nul = pas de contrainte de type.
+     */
+    using TypeMask = quint8;
+
+    static constexpr TypeMask typeBit(SchemaType type)
+    {
+        return type == SchemaType::Invalid ? TypeMask(0) : TypeMask(1u << int(type));
+    }
+
+    /// Type d'une instance JSON ; un nombre sans partie fractionnaire est "integer".
+    template <typename Value>
+    static SchemaType instanceType(const Value &v)
+    {
+        switch (SwJsonSchemaDocument<Value>::type(v)) {
+        case QJsonValue::String: return SchemaType::String;
+        case QJsonValue::Bool:   return SchemaType::Boolean;
+        case QJsonValue::Object: return SchemaType::Object;
+        case QJsonValue::Array:  return SchemaType::Array;
+        case QJsonValue::Null:   return SchemaType::Null;
+        case QJsonValue::Double: {
+            double value = SwJsonSchemaDocument<Value>::toDouble(v);
+            return std::floor(value) == value ? SchemaType::Integer : SchemaType::Number;
+        }
+        default:                 return SchemaType::Invalid;
+        }
+    }
+
+    /**
+     * @brief Statistiques du cache de résultats d'une validation (ValidationOptions::memoize).
+     */
+    struct MemoStatistics {
+        quint64 hits    = 0;  ///< Évaluations servies par le cache
+        quint64 misses  = 0;  ///< Évaluations effectivement calculées
+        quint64 entries = 0;  ///< Résultats mémorisés en fin de validation
+
+        double hitRate() const
+        {
+            return (hits + misses) ? double(hits) / double(hits + misses) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Bornes de ressources d'une validation (ValidationOptions::limits), -1 = illimité.
+     *
+     * Protègent contre les documents hostiles et les schémas pathologiques : pile épuisée
+     * par une imbrication profonde, combinateurs imbriqués, uniqueItems quadratique sur
+     * un très grand tableau. Un dépassement arrête la validation avec le statut
+     * ValidationResult::LimitExceeded.
+     */
+    struct ValidationLimits {
+        int    maxDepth            = -1;  ///< Profondeur d'imbrication de l'instance (racine = 0)
+        qint64 maxEvaluationSteps  = -1;  ///< Noeuds de schéma évalués au total
+        int    maxPatternLength    = -1;  ///< Longueur maximale d'une chaîne soumise à une expression : "pattern", clés de "patternProperties", "format"
+        int    maxArrayItems       = -1;  ///< Taille maximale d'un tableau validé
+        int    maxObjectProperties = -1;  ///< Nombre maximal de propriétés d'un objet validé
+
+        bool isUnlimited() const
+        {
+            return maxDepth < 0 && maxEvaluationSteps < 0 && maxPatternLength < 0
+                   && maxArrayItems < 0 && maxObjectProperties < 0;
+        }
+    };
+
+    /**
+     * @brief Options d'une validation (voir validate(value, options, errorMessage)).
+     */
+    struct ValidationOptions {
+        SwJsonSchemaTrace *trace = nullptr;  ///< Si non nul, reçoit la trace complète de l'évaluation
+        /**
+         * Mémorise le résultat de chaque couple (noeud de schéma, position dans l'instance)
+         * le temps de la validation : un sous-schéma atteint plusieurs fois au même endroit
+         * ($ref en losange, allOf, if puis then) n'est évalué qu'une fois.
+         */
+        bool memoize = false;
+        MemoStatistics *memoStatistics = nullptr;  ///< Si non nul, reçoit les statistiques du cache
+        /**
+         * Si non nul, conserve le document et le cache (implique memoize) pour une
+         * revalidation incrémentale par revalidate(). L'état précédent est remplacé.
+         */
+        SwJsonSchemaValidationState *state = nullptr;
+        /**
+         * Échéance de la validation (QDeadlineTimer(50) : 50 ms à partir de sa création).
+         * Vérifiée périodiquement à l'entrée des noeuds et dans les boucles sur les
+         * propriétés et les éléments ; une fois dépassée, la validation rend "TimedOut".
+         */
+        QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever);
+        SwJsonSchemaCancelToken *cancelToken = nullptr;  ///< Si non nul, permet d'annuler la validation
+        ValidationLimits limits;  ///< Bornes de ressources (aucune par défaut)
+    };
+
+    /**
+     * @brief Issue d'une validation pouvant être interrompue (validateWithResult, validateAsync).
+     */
+    struct ValidationResult {
+        enum Status {
+            Valid,
+            Invalid,
+            TimedOut,      ///< Échéance (ValidationOptions::deadline) dépassée : validité inconnue
+            Canceled,      ///< Annulée par ValidationOptions::cancelToken : validité inconnue
+            LimitExceeded  ///< Une borne de ValidationOptions::limits est dépassée : document refusé
+        };
+        Status  status = Invalid;
+        QString errorMessage;  ///< Motif de l'échec ou de l'interruption
+
+        bool isValid() const
+        {
+            return status == Valid;
+        }
+
+        bool isInterrupted() const
+        {
+            return status == TimedOut || status == Canceled || status == LimitExceeded;
+        }
+    };
+
+    /**
+     * @brief Constructeur unique : charge le schéma depuis un chemin (ou URL) `schemaPath`.
+     *        Sans parent, le schéma crée son propre contexte de registres (voir SwJsonSchemaContext).
+     * @param schemaPath  Chemin local ou URL
+     * @param registry    Pointeur vers un registre de schémas (optionnel)
+     */
+    explicit SwJsonSchema(const QString &schemaPath, SwJsonSchema *parent = nullptr)
+        : m_baseUri(schemaPath), m_keywordLocation("#"), m_parent(parent)
+    {
+        initRegistryContext(nullptr);
+        loadFile(schemaPath);
+    }
+
+    /**
+     * @brief Charge le schéma `schemaPath` dans les registres de `context` (voir SwJsonSchemaContext).
+     */
+    SwJsonSchema(SwJsonSchemaContext &context, const QString &schemaPath)
+        : m_baseUri(schemaPath), m_keywordLocation("#"), m_parent(nullptr)
+    {
+        initRegistryContext(&context);
+        loadFile(schemaPath);
+    }
+
+    /**
+     * @brief Charge le schéma `data` dans les registres de `context` (voir SwJsonSchemaContext).
+     */
+    SwJsonSchema(SwJsonSchemaContext &context, const QJsonObject &data)
+        : m_keywordLocation("#"), m_parent(nullptr)
+    {
+        initRegistryContext(&context);
+        m_isValide = !data.isEmpty();
+        if (m_isValide) {
+            loadSchema(data, nullptr);
+            rejectUnsupportedPatterns();
+        }
+    }
+
+
+    /**
+     * @brief Constructeur unique : charge le schéma depuis un chemin (ou URL) `schemaPath`.
+     *        Sans parent, le schéma crée son propre contexte de registres (voir SwJsonSchemaContext).
+     * @param schemaPath       Chemin local ou URL
+     * @param registry         Pointeur vers un registre de schémas (optionnel)
+     * @param keywordLocation  JSON Pointer du sous-schéma dans son document (ex: "#/properties/age")
+     */
+    explicit SwJsonSchema(const QJsonObject &data, SwJsonSchema *parent = nullptr,
+                          const QString &keywordLocation = QString("#"))
+        : m_keywordLocation(keywordLocation), m_parent(parent)
+    {
+        initRegistryContext(nullptr);
+        m_isValide = !data.isEmpty();
+        if(m_isValide){
+            loadSchema(data, parent);
+            rejectUnsupportedPatterns();
+        }
+    }
+
+    // Copie
+    SwJsonSchema(const SwJsonSchema &other)
+    {
+        copyFrom(other);
+    }
+
+    SwJsonSchema &operator=(const SwJsonSchema &other)
+    {
+        if (this == &other) return *this;
+        copyFrom(other);
+        return *this;
+    }
+
+    /**
+     * @brief Destructeur
+     */
+    ~SwJsonSchema()
+    {
+        delete m_pathCache.loadAcquire();
+    }
+
+    /**
+     * @brief Valide une QJsonValue contre ce schéma
+     * @param value         Valeur à valider
+     * @param errorMessage  Optionnel, reçoit le motif d’erreur
+     * @return true si la valeur est valide, false sinon
+     */
+    bool validate(const QJsonValue &value, QString *errorMessage = nullptr) const
+    {
+        if (Q_UNLIKELY(cold().resultCache)) {
+            return validate(value, ValidationOptions(), errorMessage);
+        }
+        QSet<const SwJsonSchema*> visited;
+        ValidationContext ctx;
+        return validateInternal(value, visited, ctx, errorMessage);
+    }
+
+    /**
+     * @brief Valide une QJsonValue avec des options (trace, ...)
+     * @param value         Valeur à valider
+     * @param options       Options de validation
+     * @param errorMessage  Optionnel, reçoit le motif d’erreur
+     */
+    bool validate(const QJsonValue &value, const ValidationOptions &options, QString *errorMessage = nullptr) const
+    {
+        Interruption interruption = Interruption::None;
+        return validateWithOptions(value, options, errorMessage, interruption);
+    }
+
+    /**
+     * @brief Valide une QJsonValue et distingue l'échec d'une interruption (échéance, annulation).
+     * @param value    Valeur à valider
+     * @param options  Options de validation (deadline, cancelToken, ...)
+     */
+    ValidationResult validateWithResult(const QJsonValue &value, const ValidationOptions &options) const
+    {
+        return validateDocumentWithResult(value, options);
+    }
+
+    /**
+     * @brief Valide un document d'un autre type que QJsonValue, parcouru en place.
+     *
+     * `Document` est tout type pour lequel SwJsonSchemaDocument est spécialisé (QVariant,
+     * QCborValue, ou un type tiers) : aucune copie du document en QJsonValue n'est faite.
+     * Le résultat est celui de validate() sur le document converti ; si le type parcourt
+     * les clés d'un objet dans un autre ordre, le motif d'erreur peut citer une autre propriété.
+     *
+     * @param value         Document à valider
+     * @param errorMessage  Optionnel, reçoit le motif d'erreur
+     */
+    template <typename Document>
+    bool validateDocument(const Document &value, QString *errorMessage = nullptr) const
+    {
+        QSet<const SwJsonSchema*> visited;
+        ValidationContext ctx;
+        return validateInternal(value, visited, ctx, errorMessage);
+    }
+
+    /**
+     * @brief validateDocument() avec des options. Avec ValidationOptions::state, le document
+     *        conservé pour revalidate() est converti en QJsonValue.
+     */
+    template <typename Document>
+    bool validateDocument(const Document &value, const ValidationOptions &options, QString *errorMessage = nullptr) const
+    {
+        Interruption interruption = Interruption::None;
+        return validateWithOptions(value, options, errorMessage, interruption);
+    }
+
+    /// validateWithResult() pour un document SwJsonSchemaDocument (voir validateDocument()).
+    template <typename Document>
+    ValidationResult validateDocumentWithResult(const Document &value, const ValidationOptions &options) const
+    {
+        ValidationResult result;
+        Interruption interruption = Interruption::None;
+        bool ok = validateWithOptions(value, options, &result.errorMessage, interruption);
+        result.status = resultStatus(ok, interruption);
+        return result;
+    }
+
+    /**
+     * @brief Valide un document JSON brut (objet ou tableau). Avec le cache de résultats
+     *        (setResultCache()), des octets identiques à un document déjà validé reçoivent
+     *        le même résultat sans être relus ni réévalués.
+     * @param json          Document JSON (UTF-8)
+     * @param errorMessage  Optionnel, reçoit le motif d'erreur (ou l'erreur de syntaxe JSON)
+     */
+    bool validateBytes(const QByteArray &json, QString *errorMessage = nullptr) const
+    {
+        Interruption interruption = Interruption::None;
+        return validateBytesWithOptions(json, ValidationOptions(), errorMessage, interruption);
+    }
+
+    bool validateBytes(const QByteArray &json, const ValidationOptions &options, QString *errorMessage = nullptr) const
+    {
+        Interruption interruption = Interruption::None;
+        return validateBytesWithOptions(json, options, errorMessage, interruption);
+    }
+
+    ValidationResult validateBytesWithResult(const QByteArray &json, const ValidationOptions &options) const
+    {
+        ValidationResult result;
+        Interruption interruption = Interruption::None;
+        bool ok = validateBytesWithOptions(json, options, &result.errorMessage, interruption);
+        result.status = resultStatus(ok, interruption);
+        return result;
+    }
+
+    /**
+     * @brief Active un cache LRU des résultats de validation de ce schéma (désactivé par défaut).
+     *
+     * Utile quand une part du trafic est faite de documents identiques (battements de coeur,
+     * requêtes rejouées, doublons) : validate(), validateWithResult() et validateBytes()
+     * rendent le résultat déjà calculé pour le même contenu, motif d'erreur compris. La clé
+     * est la forme canonique d'une QJsonValue ou les octets bruts de validateBytes() ; les
+     * documents d'autres types (validateDocument()) ne passent pas par le cache. Les
+     * validations interrompues (échéance, annulation) ne sont pas mémorisées ; une
+     * validation avec ValidationOptions::trace, ::state ou des bornes (::limits) ne lit ni
+     * n'alimente le cache. La taille d'une QJsonValue est minorée avant toute sérialisation :
+     * un document trop grand ne coûte pas de forme canonique.
+     * Le cache suppose des mots-clés personnalisés déterministes.
+     *
+     * À configurer avant de valider depuis plusieurs threads ; le cache lui-même est sûr en
+     * accès concurrent et partagé par les copies du schéma.
+     *
+     * @param maxEntries       Nombre de résultats conservés, 0 = désactivé
+     * @param maxPayloadBytes  Documents plus grands (octets bruts ou forme canonique) non mis en cache
+     */
+    void setResultCache(int maxEntries, int maxPayloadBytes = 64 * 1024)
+    {
+        if (maxEntries <= 0) {
+            if (cold().resultCache) {
+                mutableCold().resultCache.reset();
+            }
+            return;
+        }
+        mutableCold().resultCache.reset(new SwJsonSchemaResultCache(maxEntries, maxPayloadBytes));
+    }
+
+    /// Succès, absences et évictions du cache de résultats (tout à zéro s'il est désactivé).
+    SwJsonSchemaResultCache::Statistics resultCacheStatistics() const
+    {
+        return cold().resultCache ? cold().resultCache->statistics() : SwJsonSchemaResultCache::Statistics();
+    }
+
+    /// Vide le cache de résultats (ses compteurs sont conservés).
+    void clearResultCache() const
+    {
+        if (cold().resultCache) {
+            cold().resultCache->clear();
+        }
+    }
+
+#ifndef SWJSONSCHEMA_NO_CONCURRENT
+    /**
+     * @brief Valide une QJsonValue dans un thread de `pool` (QThreadPool::globalInstance() par défaut).
+     *
+     * Le schéma, ainsi que la trace, l'état et le jeton d'annulation référencés par `options`,
+     * doivent survivre à la validation. L'échéance court depuis la création de
+     * options.deadline, attente dans le pool comprise.
+     */
+    QFuture<ValidationResult> validateAsync(const QJsonValue &value, const ValidationOptions &options,
+                                            QThreadPool *pool = nullptr) const
+    {
+        return QtConcurrent::run(pool ? pool : QThreadPool::globalInstance(), [this, value, options]() {
+            return validateWithResult(value, options);
+        });
+    }
+
+    QFuture<ValidationResult> validateAsync(const QJsonValue &value, QThreadPool *pool = nullptr) const
+    {
+        return validateAsync(value, ValidationOptions(), pool);
+    }
+#endif
+
+    /**
+     * @brief Applique un JSON Patch (RFC 6902) au document d'un état conservé, puis le revalide.
+     *
+     * Seuls les sous-arbres modifiés et leurs ancêtres sont réévalués ; le reste est servi par
+     * les résultats conservés. Le résultat est identique à une validation complète du document
+     * patché (state.document()).
+     *
+     * @param state         État produit par validate() avec ValidationOptions::state, mis à jour
+     * @param patch         Opérations add / remove / replace / move / copy / test
+     * @param errorMessage  Optionnel, reçoit le motif d'erreur (validation ou patch)
+     * @return Validité du document patché ; false si le patch ne s'applique pas (état inchangé).
+     */
+    bool revalidate(SwJsonSchemaValidationState &state, const QJsonArray &patch,
+                    QString *errorMessage = nullptr) const
+    {
+        if (state.m_schema != this) {
+            return setError(errorMessage, "L'état de validation n'a pas été produit par ce schéma.");
+        }
+        if (!state.applyPatch(patch, errorMessage)) {
+            return false;
+        }
+        QSet<const SwJsonSchema*> visited;
+        ValidationContext ctx;
+        ctx.memo = &state;
+        ctx.trackInstancePath = true;
+        state.m_hits = 0;
+        state.m_misses = 0;
+        state.m_valid = validateInternal(state.m_document, visited, ctx, errorMessage);
+        return state.m_valid;
+    }
+
+    /**
+     * @brief Valide une valeur isolée à la position `instancePointer` d'un document.
+     *
+     * Les sous-schémas applicables sont trouvés en descendant le long du pointeur par
+     * properties, patternProperties, additionalProperties, prefixItems et items (à travers
+     * $ref et allOf), puis la valeur est validée contre chacun. Les sous-schémas atteints
+     * par anyOf / oneOf / if-then-else dépendent du reste du document et ne sont pas
+     * appliqués. Une position non contrainte accepte toute valeur. Une propriété (ou un
+     * élément) qu'aucun mot-clé n'évalue reçoit unevaluatedProperties / unevaluatedItems,
+     * sauf si un anyOf / oneOf / if du même noeud pourrait l'évaluer. Une $ref
+     * introuvable sur le chemin est une erreur, comme pour validate().
+     *
+     * Le résultat de la navigation est mis en cache par pointeur (thread-safe, les
+     * pathCacheCapacity pointeurs les plus récents) : les validations répétées d'un même
+     * champ ne paient que la validation de la valeur.
+     *
+     * @param instancePointer  JSON Pointer de la valeur dans le document (ex: "/user/age")
+     * @param value            Valeur à valider
+     * @param errorMessage     Optionnel, reçoit le motif d'erreur
+     */
+    bool validateAt(const QString &instancePointer, const QJsonValue &value, QString *errorMessage = nullptr) const
+    {
+        PathLookup lookup;
+        {
+            PathCache &cache = pathCache();
+            QMutexLocker locker(&cache.mutex);
+            if (const PathLookup *cached = cache.entries.object(instancePointer)) {
+                lookup = *cached;
+            } else {
+                QStringList tokens;
+                if (!SwJsonSchemaValidationState::parsePointer(instancePointer, tokens)) {
+                    return setError(errorMessage, QString("JSON Pointer '%1' invalide.").arg(instancePointer));
+                }
+                lookup = lookupPath(tokens);
+                cache.entries.insert(instancePointer, new PathLookup(lookup));
+            }
+        }
+        if (!lookup.forbidden.isEmpty()) {
+            return setError(errorMessage, lookup.forbidden);
+        }
+        for (const SwJsonSchema *schema : lookup.schemas) {
+            QSet<const SwJsonSchema*> visited;
+            ValidationContext ctx;
+            if (!schema->validateInternal(value, visited, ctx, errorMessage)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isValide() {
+        return m_isValide;
+    }
+
+    /**
+     * @brief Ordre d'évaluation des mots-clés de ce noeud, calculé au chargement.
+     *
+     * Lorsqu'aucun message d'erreur n'est demandé (validate(value) ou sous-schémas dont
+     * l'erreur est ignorée), les mots-clés sont évalués par coût estimé / sélectivité
+     * croissants : type, const et enum d'abord, puis les contraintes propres au type
+     * (longueurs, required, properties, ...), les combinateurs et les expressions
+     * régulières en dernier. Le résultat (valide / invalide) est identique.
+     *
+     * Lorsqu'un message d'erreur est demandé, l'ordre historique est conservé afin que
+     * le premier motif d'erreur signalé reste le même.
+     *
+     * @param collectErrors true : ordre utilisé avec message d'erreur ; false : ordre par coût
+     */
+    QStringList evaluationOrder(bool collectErrors = false) const
+    {
+        if (isReference()) {
+            return QStringList() << "$ref";
+        }
+        QStringList names;
+        for (EvaluationStep step : (collectErrors ? m_steps : m_costOrderedSteps)) {
+            names << stepName(step);
+        }
+        return names;
+    }
+
+    /**
+     * @brief Moteur des expressions régulières "pattern" et "patternProperties" (SwJsonSchemaRegex).
+     */
+    enum class RegexEngine {
+        Backtracking,       ///< QRegularExpression (PCRE2), comportement historique
+        Linear,             ///< Temps linéaire ; un motif hors du sous-ensemble rend le schéma invalide
+        LinearWithFallback  ///< Temps linéaire ; un motif hors du sous-ensemble utilise QRegularExpression
+    };
+
+    /**
+     * @brief Choisit le moteur utilisé par les schémas chargés ensuite (les schémas déjà
+     *        chargés gardent le leur).
+     */
+    static void setRegexEngine(RegexEngine engine)
+    {
+        regexEngineSetting().storeRelaxed(int(engine));
+    }
+
+    static RegexEngine regexEngine()
+    {
+        return RegexEngine(regexEngineSetting().loadRelaxed());
+    }
+
+    /**
+     * @brief Motifs du document (et des documents référencés) hors du sous-ensemble du moteur
+     *        linéaire, sous la forme "<emplacement> : /<motif>/ : <raison>". Vide avec le
+     *        moteur Backtracking. Les définitions différées n'y figurent qu'une fois compilées.
+     */
+    QStringList unsupportedPatterns() const
+    {
+        // Chaque racine (document, définition différée) tient ses motifs, écrits une fois pour
+        // toutes à son chargement : les définitions différées pas encore compilées n'en
+        // signalent pas (prepare() les compile toutes)
+        QStringList patterns;
+        QSet<const SwJsonSchema*> seen;
+        QSet<QString> registries;
+        QVector<const SwJsonSchema*> stack;
+        stack << this;
+        int deferred = 0;
+        while (!stack.isEmpty()) {
+            const SwJsonSchema *node = stack.takeLast();
+            if (!node || node->m_constant != Constant::None || seen.contains(node)) {
+                continue;
+            }
+            seen.insert(node);
+            if (node == this || !node->m_parent) {
+                patterns << node->cold().unsupportedPatterns;
+            }
+            node->appendSubschemas(stack);
+            const QString registry = node->m_baseUri.toLower();
+            if (!registries.contains(registry)) {
+                registries.insert(registry);
+                node->getRegistry(node->m_baseUri)->collectSchemas(stack, deferred);
+            }
+        }
+        patterns.removeDuplicates();
+        return patterns;
+    }
+
+    /**
+     * @brief Compilation différée des entrées de $defs / definitions (activée par défaut) :
+     *        une définition n'est compilée qu'à la première résolution d'un $ref vers elle.
+     *        Concerne les schémas chargés ensuite. Les définitions qui déclarent un $id ou
+     *        un $anchor, ou qui chargent un $ref externe, restent compilées au chargement,
+     *        de même que toutes les définitions avec le moteur Linear strict.
+     */
+    static void setLazyDefinitions(bool lazy)
+    {
+        lazyDefinitionsSetting().storeRelaxed(lazy ? 1 : 0);
+    }
+
+    static bool lazyDefinitions()
+    {
+        return lazyDefinitionsSetting().loadRelaxed() != 0;
+    }
+
+    /// Définitions différées depuis le démarrage, et combien ont été compilées depuis
+    struct DefinitionStatistics {
+        int deferred = 0;
+        int compiled = 0;
+    };
+
+    static DefinitionStatistics definitionStatistics()
+    {
+        DefinitionStatistics statistics;
+        statistics.deferred = SwJsonSchemaLazyDefinition::deferredCount().loadRelaxed();
+        statistics.compiled = SwJsonSchemaLazyDefinition::compiledCount().loadRelaxed();
+        return statistics;
+    }
+
+    /**
+     * @brief Partage des sous-schémas identiques au chargement (désactivé par défaut).
+     *
+     * Pendant le chargement d'un document, chaque sous-schéma est indexé par sa forme
+     * canonique (JSON compact, clés triées) et son URI de base : une occurrence identique
+     * réutilise le noeud déjà compilé au lieu d'en construire un autre. Les sous-schémas
+     * qui déclarent un $id / $anchor ou chargent un $ref externe ne sont pas partagés.
+     * Concerne les schémas chargés ensuite.
+     *
+     * Le résultat des validations ne change pas, mais les descendants d'un noeud partagé
+     * gardent l'emplacement de la première occurrence : profilage, traces, analyzeComplexity()
+     * et compteurs par noeud citent cet emplacement pour toutes les occurrences. À réserver
+     * aux schémas volumineux dont la mémoire compte plus que ces diagnostics.
+     */
+    static void setDeduplication(bool enabled)
+    {
+        deduplicationSetting().storeRelaxed(enabled ? 1 : 0);
+    }
+
+    static bool deduplication()
+    {
+        return deduplicationSetting().loadRelaxed() != 0;
+    }
+
+    /**
+     * @brief Instances de SwJsonSchema vivantes dans le processus : noeuds des arbres,
+     *        définitions, documents externes et copies. Après la destruction d'un schéma et
+     *        de son SwJsonSchemaContext, la valeur revient à celle d'avant son chargement ;
+     *        les noeuds détenus par le contexte global ne sont jamais libérés.
+     */
+    static int liveInstances()
+    {
+        return liveInstanceCount().loadRelaxed();
+    }
+
+    /// Sous-schémas chargés depuis le démarrage avec le partage actif, et combien réutilisaient un noeud existant
+    struct DeduplicationStatistics {
+        int subschemas = 0;
+        int shared = 0;
+    };
+
+    static DeduplicationStatistics deduplicationStatistics()
+    {
+        DeduplicationStatistics statistics;
+        statistics.subschemas = deduplicationCount(false).loadRelaxed();
+        statistics.shared = deduplicationCount(true).loadRelaxed();
+        return statistics;
+    }
+
+    /**
+     * @brief Compile tout ce qui est atteignable depuis ce schéma (sous-schémas et cibles
+     *        des $ref, y compris dans les documents référencés), pour qu'aucune validation
+     *        ne paie une compilation différée.
+     * @return Nombre de noeuds atteignables.
+     */
+    int prepare() const
+    {
+        QSet<const SwJsonSchema*> seen;
+        QVector<const SwJsonSchema*> stack;
+        stack << this;
+        while (!stack.isEmpty()) {
+            const SwJsonSchema *node = stack.takeLast();
+            if (!node || seen.contains(node)) {
+                continue;
+            }
+            seen.insert(node);
+            if (node->isReference()) {
+                stack << node->resolveReference();
+            }
+            stack << node->m_recursiveSchema;
+            node->appendSubschemas(stack);
+        }
+        return seen.size();
+    }
+
+    /**
+     * @brief Mémoire retenue par un schéma chargé, par catégorie de mots-clés.
+     *
+     * Couvre les noeuds atteignables et ceux des registres de leurs documents (définitions
+     * compilées, documents référencés). Les tampons partagés (chaînes, automates) sont comptés
+     * une fois ; les entrées de conteneurs sont estimées à trois pointeurs. Deux chargements
+     * d'un même document dans le même contexte de registres (SwJsonSchemaContext passé au
+     * constructeur) sont comptés ensemble.
+     */
+    struct MemoryUsage {
+        int    nodes = 0;                  ///< Noeuds compilés (hors schémas true / false partagés)
+        int    nodesWithColdKeywords = 0;  ///< Dont noeuds ayant un stockage annexe
+        int    deferredDefinitions = 0;    ///< Définitions pas encore compilées (non comptées)
+        qint64 nodeBytes = 0;              ///< Partie fixe : sizeof(SwJsonSchema) par noeud
+        qint64 coldBytes = 0;              ///< Stockage annexe des mots-clés rares
+        qint64 identifierBytes = 0;        ///< URI de base, $ref, $anchor, $schema, emplacements
+        qint64 objectBytes = 0;            ///< properties, patternProperties, required, dependentRequired
+        qint64 arrayBytes = 0;             ///< prefixItems
+        qint64 applicatorBytes = 0;        ///< allOf / anyOf / oneOf et discriminants
+        qint64 valueBytes = 0;             ///< enum / const (taille JSON compacte)
+        qint64 stringBytes = 0;            ///< pattern, format et automates des expressions régulières
+        qint64 cacheBytes = 0;             ///< Ordres d'évaluation, caches de validateAt() et des résultats
+
+        qint64 totalBytes() const
+        {
+            return nodeBytes + coldBytes + identifierBytes + objectBytes + arrayBytes + applicatorBytes
+                   + valueBytes + stringBytes + cacheBytes;
+        }
+    };
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        QSet<const void*> counted;
+        CountedContainers containers;
+        QSet<const SwJsonSchema*> seen;
+        QSet<QString> registries;
+        QVector<const SwJsonSchema*> stack;
+        stack << this;
+        while (!stack.isEmpty()) {
+            const SwJsonSchema *node = stack.takeLast();
+            if (!node || node->m_constant != Constant::None || seen.contains(node)) {
+                continue;
+            }
+            seen.insert(node);
+            node->accountMemory(usage, counted, containers);
+            node->appendSubschemas(stack);
+            // Cibles des $ref : lues dans les registres, sans compiler les définitions différées
+            const QString registry = node->m_baseUri.toLower();
+            if (!registries.contains(registry)) {
+                registries.insert(registry);
+                node->getRegistry(node->m_baseUri)->collectSchemas(stack, usage.deferredDefinitions);
+            }
+        }
+        usage.nodes = seen.size();
+        return usage;
+    }
+
+    /**
+     * @brief Constat de analyzeComplexity() : un mot-clé coûteux au pire cas.
+     */
+    struct ComplexityFinding {
+        enum Severity { Info, Warning, Critical };
+
+        Severity severity = Info;
+        QString  kind;      ///< "pattern", "fanOut", "uniqueItems", "recursion" ou "patternProperties"
+        QString  location;  ///< URI de base + JSON Pointer du mot-clé
+        QString  cost;      ///< Coût estimé au pire cas
+        QString  message;
+    };
+
+    /// Seuils de analyzeComplexity()
+    struct ComplexityThresholds {
+        qint64 fanOutWarning = 64;     ///< Évaluations de branches anyOf / oneOf d'un noeud par position de l'instance
+        qint64 fanOutCritical = 4096;
+        int    patternProperties = 8;  ///< Motifs patternProperties d'un noeud (chaque clé est testée contre tous)
+        int    uniqueItems = 1000;     ///< maxItems à partir duquel uniqueItems (O(n²)) est signalé
+    };
+
+    struct ComplexityReport {
+        QList<ComplexityFinding> findings;  ///< Du plus grave au moins grave
+        int    nodes = 0;                   ///< Noeuds analysés (cibles des $ref comprises)
+        qint64 maxNodeEvaluations = 0;      ///< Évaluations au pire d'un même noeud par position de l'instance
+
+        /// Nombre de constats de gravité au moins `severity`.
+        int count(ComplexityFinding::Severity severity) const
+        {
+            int n = 0;
+            for (const ComplexityFinding &finding : findings) {
+                if (finding.severity >= severity) {
+                    ++n;
+                }
+            }
+            return n;
+        }
+    };
+
+    /**
+     * @brief Analyse statique des coûts au pire cas d'un schéma chargé, avant de l'accepter.
+     *
+     * Parcourt les noeuds atteignables (cibles des $ref comprises, définitions différées
+     * compilées au passage) et signale :
+     *  - les motifs (pattern, patternProperties) non ancrés ou sujets au retour arrière
+     *    catastrophique (SwJsonSchemaRegex::backtrackingRisk()), graves seulement avec le
+     *    moteur Backtracking ;
+     *  - l'éventail des anyOf / oneOf : branches évaluées par position de l'instance, en
+     *    comptant les chemins qui mènent au noeud ($ref partagés, combinateurs imbriqués) ;
+     *  - uniqueItems sur un tableau sans maxItems ou avec un maxItems élevé ;
+     *  - les cycles de $ref : sans progression dans l'instance (récursion sans fin) ou
+     *    récursion bornée par la profondeur de l'instance ;
+     *  - les noeuds ayant beaucoup de patternProperties.
+     *
+     * Les évaluations sont comptées sans ValidationOptions::memoize, qui les borne. Les
+     * chemins ne s'additionnent que sur une même valeur : un sous-schéma partagé atteint par
+     * des propriétés différentes (setDeduplication()) compte comme le plus sollicité d'entre elles.
+     */
+    ComplexityReport analyzeComplexity() const
+    {
+        return analyzeComplexity(ComplexityThresholds());
+    }
+
+    ComplexityReport analyzeComplexity(const ComplexityThresholds &thresholds) const
+    {
+        ComplexityReport report;
+        const SwJsonSchema *root = complexityTarget(this, report);
+        if (!root) {
+            return report;
+        }
+
+        // 1. Parcours en profondeur itératif (schéma d'origine externe : pas de récursion C++) :
+        //    ordre postfixe et arcs retour, c'est-à-dire les cycles de $ref
+        struct Frame {
+            const SwJsonSchema *node;
+            int  next;
+            bool consumed;  // L'arc qui y mène descend dans l'instance
+        };
+        QHash<const SwJsonSchema*, QVector<ComplexityEdge>> edges;
+        QHash<const SwJsonSchema*, int> state;  // 1 : sur le chemin, 2 : terminé
+        QSet<QPair<const SwJsonSchema*, const SwJsonSchema*>> backEdges;
+        QVector<const SwJsonSchema*> postOrder;
+        QVector<Frame> path;
+        auto enter = [&](const SwJsonSchema *node, bool consumed) {
+            state.insert(node, 1);
+            QVector<ComplexityEdge> out;
+            node->appendComplexityEdges(out, report);
+            edges.insert(node, out);
+            path.append(Frame{node, 0, consumed});
+        };
+        enter(root, false);
+        while (!path.isEmpty()) {
+            const SwJsonSchema *node = path.last().node;
+            const QVector<ComplexityEdge> out = edges.value(node);
+            if (path.last().next == out.size()) {
+                state.insert(node, 2);
+                postOrder << node;
+                path.removeLast();
+                continue;
+            }
+            const ComplexityEdge edge = out.at(path.last().next++);
+            const int targetState = state.value(edge.target, 0);
+            if (targetState == 0) {
+                enter(edge.target, edge.consumes);
+            } else if (targetState == 1) {
+                bool consumes = edge.consumes;
+                for (int i = path.size() - 1; i >= 0 && path.at(i).node != edge.target; --i) {
+                    consumes = consumes || path.at(i).consumed;
+                }
+                backEdges.insert(qMakePair(node, edge.target));
+                ComplexityFinding finding;
+                finding.kind = "recursion";
+                finding.location = edge.via->complexityLocation();
+                if (consumes) {
+                    finding.severity = ComplexityFinding::Info;
+                    finding.cost = "profondeur de l'instance";
+                    finding.message = QString("Schéma récursif (retour vers %1) : la profondeur n'est bornée que par "
+                                              "ValidationLimits::maxDepth.").arg(edge.target->m_baseUri + edge.target->m_keywordLocation);
+                } else {
+                    finding.severity = ComplexityFinding::Critical;
+                    finding.cost = "récursion sans fin";
+                    finding.message = QString("Cycle de $ref sans progression dans l'instance (retour vers %1) : "
+                                              "toute valeur qui l'atteint est rejetée.").arg(edge.target->m_baseUri + edge.target->m_keywordLocation);
+                }
+                report.findings << finding;
+            }
+        }
+        report.nodes = postOrder.size();
+
+        // 2. Évaluations au pire par position de l'instance (arcs retour exclus). Chaque
+        //    position commence à la racine ou à la cible d'un arc qui descend dans l'instance ;
+        //    on y compte les chemins qui restent sur la même valeur. Les positions sont traitées
+        //    dans l'ordre topologique, une cible reçoit le maximum de ses parents.
+        QHash<const SwJsonSchema*, int> rank;
+        for (int i = 0; i < postOrder.size(); ++i) {
+            rank.insert(postOrder.at(i), postOrder.size() - 1 - i);
+        }
+        auto forward = [&](const SwJsonSchema *node, const ComplexityEdge &edge) {
+            return !backEdges.contains(qMakePair(node, edge.target));
+        };
+        QHash<const SwJsonSchema*, qint64> positions;  // Évaluations d'entrée de chaque position
+        QHash<const SwJsonSchema*, qint64> evaluations;
+        positions.insert(root, 1);
+        for (int i = postOrder.size() - 1; i >= 0; --i) {
+            const SwJsonSchema *head = postOrder.at(i);
+            if (!positions.contains(head)) {
+                continue;
+            }
+            // Noeuds évalués sur la même valeur que `head`, dans l'ordre topologique
+            QVector<const SwJsonSchema*> scope;
+            QSet<const SwJsonSchema*> inScope;
+            scope << head;
+            inScope.insert(head);
+            for (int j = 0; j < scope.size(); ++j) {
+                for (const ComplexityEdge &edge : edges.value(scope.at(j))) {
+                    if (!edge.consumes && forward(scope.at(j), edge) && !inScope.contains(edge.target)) {
+                        inScope.insert(edge.target);
+                        scope << edge.target;
+                    }
+                }
+            }
+            std::sort(scope.begin(), scope.end(), [&rank](const SwJsonSchema *a, const SwJsonSchema *b) {
+                return rank.value(a) < rank.value(b);
+            });
+            QHash<const SwJsonSchema*, qint64> paths;
+            paths.insert(head, positions.value(head));
+            for (const SwJsonSchema *node : scope) {
+                const qint64 count = paths.value(node);
+                evaluations.insert(node, qMax(evaluations.value(node), count));
+                for (const ComplexityEdge &edge : edges.value(node)) {
+                    if (!forward(node, edge)) {
+                        continue;
+                    }
+                    if (edge.consumes) {
+                        positions.insert(edge.target, qMax(positions.value(edge.target), count));
+                    } else {
+                        paths.insert(edge.target, qMin(complexityCap, paths.value(edge.target) + count));
+                    }
+                }
+            }
+        }
+        for (int i = postOrder.size() - 1; i >= 0; --i) {
+            const SwJsonSchema *node = postOrder.at(i);
+            const qint64 count = evaluations.value(node);
+            report.maxNodeEvaluations = qMax(report.maxNodeEvaluations, count);
+            node->analyzeNodeComplexity(count, thresholds, report);
+        }
+
+        // Un cycle de $ref seuls est rencontré par chaque noeud qui y mène
+        QSet<QString> keys;
+        QList<ComplexityFinding> unique;
+        for (const ComplexityFinding &finding : report.findings) {
+            const QString key = finding.kind + '\n' + finding.location + '\n' + finding.message;
+            if (!keys.contains(key)) {
+                keys.insert(key);
+                unique << finding;
+            }
+        }
+        report.findings = unique;
+        std::stable_sort(report.findings.begin(), report.findings.end(),
+                         [](const ComplexityFinding &a, const ComplexityFinding &b) {
+                             return a.severity > b.severity;
+                         });
+        return report;
+    }
+
+    /**
+     * @brief Enregistre une lambda pour un mot-clé personnalisé
+     * @param keyWord Mot-clé
+     * @param validator Lambda prenant un QJsonValue et QString& pour l'erreur
+     */
+    static void registerCustomKeyword(const QString& keyWord, Validator validator) {
+        getCustomKeywordRegistry()[keyWord] = validator;
+    }
+
+    /**
+     * @brief Applique un mot-clé personnalisé enregistré (registerCustomKeyword).
+     *
+     * Point d'entrée des validateurs générés par SwJsonSchemaCodegen : la lambda est
+     * recherchée à l'exécution. Un mot-clé non enregistré est ignoré (true), comme au
+     * chargement d'un schéma.
+     */
+    static bool validateCustomKeyword(const QString &keyWord, const QJsonValue &rules,
+                                      const QJsonValue &value, QString *errorMessage) {
+        const auto &customKeywords = getCustomKeywordRegistry();
+        auto it = customKeywords.constFind(keyWord);
+        if (it == customKeywords.constEnd()) {
+            return true;
+        }
+        return it.value()(rules, value, errorMessage);
+    }
+
+    /**
+     * @brief Contrôle le mot-clé "format" (email, date-time, ...) sur une chaîne.
+     */
+    static bool validateFormat(const QString &value, const QString &formatName, QString *errorMessage) {
+        return checkFormat(value, formatName, errorMessage);
+    }
+
+private:
+    // -----------------------------------------------------------------------
+    //                   Contexte de validation
+    // -----------------------------------------------------------------------
+    /**
+     * @brief Propriété discriminante d'une union oneOf / anyOf.
+     *
+     * Chaque branche contraint la propriété par "const" ou "enum" : la valeur portée par
+     * l'instance désigne directement les seules branches susceptibles d'être satisfaites.
+     */
+    struct Discriminator {
+        QString property;                          ///< Vide = pas de discriminant
+        QHash<QByteArray, QVector<int>> branches;  ///< JSON canonique de la valeur -> indices des branches
+    };
+
+    /**
+     * @brief Groupes de mots-clés évalués par un noeud, dans l'ordre historique.
+     */
+    enum class EvaluationStep : quint8 {
+        Conditional,   ///< if / then / else
+        Not,
+        AllOf,
+        AnyOf,
+        OneOf,
+        Enum,
+        Const,
+        Type,
+        TypeSpecific,  ///< minLength, pattern, minimum, required, properties, items, ...
+        Custom,        ///< mots-clés personnalisés
+        Unevaluated    ///< unevaluatedProperties / unevaluatedItems (toujours en dernier)
+    };
+
+    /// Cause de l'arrêt d'une validation avant son terme.
+    enum class Interruption : quint8 { None, TimedOut, Canceled, LimitExceeded };
+
+    /**
+     * @brief État propre à une validation, transmis le long de la récursion.
+     *
+     * Le chemin dans l'instance n'est tenu à jour que si un consommateur en a besoin
+     * (trace, cache) : sans cela, la descente ne paie aucune concaténation de chaîne.
+     */
+    struct ValidationContext {
+        SwJsonSchemaTrace *trace = nullptr;
+        SwJsonSchemaValidationState *memo = nullptr;
+        int recursionHits = 0;     ///< Détections de récursion : un résultat qui en dépend n'est pas mémorisé
+        bool trackInstancePath = false;
+        QStringList instancePath;  ///< Jetons (déjà échappés) du JSON Pointer courant
+        /// Propriétés (indices dans l'objet) ou éléments de l'instance courante évalués avec
+        /// succès ; nul si aucun unevaluated* en cours ne consomme ces annotations.
+        QBitArray *evaluated = nullptr;
+        /// Échéance, jeton d'annulation ou bornes présents : points de contrôle actifs.
+        bool interruptible = false;
+        Interruption interruption = Interruption::None;
+        QString limitExceeded;     ///< Borne dépassée (Interruption::LimitExceeded)
+        quint32 pollCount = 0;
+        QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever);
+        const SwJsonSchemaCancelToken *cancelToken = nullptr;
+        const ValidationLimits *limits = nullptr;  ///< Nul si aucune borne
+        int depth = 0;             ///< Profondeur de l'instance courante
+        qint64 steps = 0;          ///< Noeuds évalués
+
+        QString instancePointer() const
+        {
+            return instancePath.isEmpty() ? QString() : "/" + instancePath.join("/");
+        }
+
+        /**
+         * @brief Point de contrôle : vrai si la validation doit s'arrêter.
+         *
+         * L'horloge et le jeton ne sont consultés qu'une fois sur 256 appels ; une fois
+         * interrompue, la validation le reste et chaque noeud rend false aussitôt.
+         */
+        bool interrupted()
+        {
+            if (Q_LIKELY(!interruptible)) {
+                return false;
+            }
+            if (interruption == Interruption::None && (pollCount++ & 0xFF) == 0) {
+                if (cancelToken && cancelToken->isCanceled()) {
+                    interruption = Interruption::Canceled;
+                } else if (deadline.hasExpired()) {
+                    interruption = Interruption::TimedOut;
+                }
+            }
+            return interruption != Interruption::None;
+        }
+
+        /// Point de contrôle à l'entrée d'un noeud : bornes de profondeur et d'étapes, puis interrupted().
+        bool nodeInterrupted()
+        {
+            if (Q_LIKELY(!interruptible)) {
+                return false;
+            }
+            if (limits && interruption == Interruption::None) {
+                if (limits->maxDepth >= 0 && depth > limits->maxDepth) {
+                    return exceed(QString("profondeur de l'instance > %1").arg(limits->maxDepth));
+                }
+                if (limits->maxEvaluationSteps >= 0 && ++steps > limits->maxEvaluationSteps) {
+                    return exceed(QString("plus de %1 étapes d'évaluation").arg(limits->maxEvaluationSteps));
+                }
+            }
+            return interrupted();
+        }
+
+        /// Borne maxPatternLength : vrai (validation arrêtée) si `size` caractères ne peuvent
+        /// pas être soumis à l'expression de `keyword` ("pattern", "patternProperties", "format").
+        bool patternInputTooLong(int size, const char *keyword)
+        {
+            if (Q_LIKELY(!limits) || limits->maxPatternLength < 0 || size <= limits->maxPatternLength) {
+                return false;
+            }
+            return exceed(QString("chaîne de %1 caractères soumise à \"%2\" (maximum %3)")
+                              .arg(size).arg(QString::fromLatin1(keyword)).arg(limits->maxPatternLength));
+        }
+
+        /// Arrête la validation sur la borne `what` ; rend toujours true.
+        bool exceed(const QString &what)
+        {
+            interruption = Interruption::LimitExceeded;
+            limitExceeded = what;
+            return true;
+        }
+    };
+
+    static QString interruptionMessage(const ValidationContext &ctx)
+    {
+        switch (ctx.interruption) {
+        case Interruption::Canceled:      return QString("Validation interrompue : annulée.");
+        case Interruption::LimitExceeded: return QString("Limite dépassée : %1.").arg(ctx.limitExceeded);
+        default:                          return QString("Validation interrompue : délai dépassé.");
+        }
+    }
+
+    static bool interruptionError(const ValidationContext &ctx, QString *errorMessage)
+    {
+        return setError(errorMessage, interruptionMessage(ctx));
+    }
+
+    /// Noeud présent dans le chemin d'évaluation le temps d'une portée.
+    class VisitedScope {
+    public:
+        VisitedScope(QSet<const SwJsonSchema*> &visited, const SwJsonSchema *node)
+            : m_visited(visited), m_node(node)
+        {
+            m_visited.insert(m_node);
+        }
+        ~VisitedScope()
+        {
+            m_visited.remove(m_node);
+        }
+    private:
+        QSet<const SwJsonSchema*> &m_visited;
+        const SwJsonSchema *m_node;
+    };
+
+    /// Descente dans l'instance (propriété ou élément) le temps d'une portée.
+    /// Les annotations de l'instance parente ne concernent pas l'enfant : elles sont suspendues.
+    class InstancePathScope {
+    public:
+        InstancePathScope(ValidationContext &ctx, const QString &key)
+            : m_ctx(ctx), m_active(ctx.trackInstancePath), m_evaluated(ctx.evaluated)
+        {
+            m_ctx.evaluated = nullptr;
+            ++m_ctx.depth;
+            if (Q_UNLIKELY(m_active)) {
+                m_ctx.instancePath.append(escapePointerToken(key));
+            }
+        }
+        InstancePathScope(ValidationContext &ctx, int index)
+            : m_ctx(ctx), m_active(ctx.trackInstancePath), m_evaluated(ctx.evaluated)
+        {
+            m_ctx.evaluated = nullptr;
+            ++m_ctx.depth;
+            if (Q_UNLIKELY(m_active)) {
+                m_ctx.instancePath.append(QString::number(index));
+            }
+        }
+        ~InstancePathScope()
+        {
+            m_ctx.evaluated = m_evaluated;
+            --m_ctx.depth;
+            if (Q_UNLIKELY(m_active)) {
+                m_ctx.instancePath.removeLast();
+            }
+        }
+    private:
+        ValidationContext &m_ctx;
+        bool m_active;
+        QBitArray *m_evaluated;
+    };
+
+    /// Événement de trace couvrant un combinateur, nommé "<keyword location> <mot-clé>".
+    class TraceSpan {
+    public:
+        TraceSpan(ValidationContext &ctx, const SwJsonSchema *schema, const char *keyword)
+            : m_trace(ctx.trace)
+        {
+            if (Q_UNLIKELY(m_trace)) {
+                m_index = m_trace->begin(schema->m_baseUri + schema->m_keywordLocation + " " + keyword,
+                                         ctx.instancePointer());
+            }
+        }
+        ~TraceSpan()
+        {
+            if (Q_UNLIKELY(m_index >= 0)) {
+                m_trace->end(m_index, m_valid);
+            }
+        }
+        bool done(bool valid)
+        {
+            m_valid = valid;
+            return valid;
+        }
+    private:
+        SwJsonSchemaTrace *m_trace;
+        int  m_index = -1;
+        bool m_valid = true;
+    };
+
+    // -----------------------------------------------------------------------
+    //                   Schémas booléens
+    // -----------------------------------------------------------------------
+    /// Schéma booléen : true accepte toute valeur, false n'en accepte aucune.
+    enum class Constant : quint8 { None, True, False };
+
+    struct ConstantTag {};
+
+    // Noeud constant : aucune contrainte à charger, évalué en temps constant
+    SwJsonSchema(ConstantTag, bool accept)
+        : m_keywordLocation(accept ? "true" : "false"), m_parent(nullptr)
+    {
+        m_constant = accept ? Constant::True : Constant::False;
+        m_isValide = true;
+        m_estimatedCost = 0;
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Chargement parallèle (SwJsonSchemaLoader)
+    // -----------------------------------------------------------------------
+    /// $ref externe vers un document compilé à part : enregistré à la phase de liaison.
+    struct DeferredLink {
+        QString registryBase;  ///< m_baseUri du noeud référent (registre où l'enregistrer)
+        QString refPath;       ///< Chemin calculé par loadSchema, clé de registerSchemaByRef
+        QString target;        ///< Clé du document cible (documentKey)
+    };
+
+    /// Compilation d'un document par SwJsonSchemaLoader (une par tâche, donc par thread).
+    struct LoadContext {
+        const QHash<QString, bool> *documents = nullptr;  ///< Documents lus : clé -> valide
+        SwJsonSchemaContext *registries = nullptr;        ///< Registres du chargeur
+        QVector<DeferredLink> links;
+    };
+
+    static LoadContext *&activeLoadContext()
+    {
+        static thread_local LoadContext *context = nullptr;
+        return context;
+    }
+
+    /// Clé d'un document : chemin local normalisé ("a/./b.json" et "a/b.json" sont le même).
+    static QString documentKey(const QString &path)
+    {
+        QUrl url(path);
+        return QDir::cleanPath(url.isLocalFile() ? url.toLocalFile() : path);
+    }
+
+    /// Document déjà lu, compilé sans parent ; ses $ref vers les documents de `context` sont différés.
+    SwJsonSchema(const QString &schemaPath, const QJsonObject &document, LoadContext *context)
+        : m_baseUri(schemaPath), m_keywordLocation("#"), m_parent(nullptr)
+    {
+        LoadContext *previous = activeLoadContext();
+        activeLoadContext() = context;
+        initRegistryContext(context->registries);
+        m_isValide = !document.isEmpty();
+        if (m_isValide) {
+            loadSchema(document, nullptr);
+        }
+        activeLoadContext() = previous;
+    }
+
+    /**
+     * @brief Noeud partagé des schémas true / false.
+     *
+     * Chaque occurrence d'un schéma booléen référence l'un de ces deux singletons : ni
+     * chargement ni allocation par occurrence.
+     */
+    static QSharedPointer<SwJsonSchema> constantSchema(bool accept)
+    {
+        static const QSharedPointer<SwJsonSchema> trueSchema(new SwJsonSchema(ConstantTag(), true));
+        static const QSharedPointer<SwJsonSchema> falseSchema(new SwJsonSchema(ConstantTag(), false));
+        return accept ? trueSchema : falseSchema;
+    }
+
+    bool acceptsAll() const
+    {
+        return m_constant == Constant::True;
+    }
+
+    bool rejectsAll() const
+    {
+        return m_constant == Constant::False;
+    }
+
+    static QString falseSchemaError()
+    {
+        return QString("Le schéma 'false' n'accepte aucune valeur.");
+    }
+
+    /// Un sous-schéma est un objet ou un booléen.
+    static bool isSchemaValue(const QJsonValue &val)
+    {
+        return val.isObject() || val.isBool();
+    }
+
+    /// Sous-schéma d'un mot-clé à schéma unique (nul si la valeur n'est pas un schéma).
+    QSharedPointer<SwJsonSchema> loadChild(const QJsonValue &val, const QString &location)
+    {
+        if (val.isBool()) {
+            return constantSchema(val.toBool());
+        }
+        if (val.isObject()) {
+            if (QSharedPointer<SwJsonSchema> shared = loadShared(val.toObject(), location)) {
+                return shared;
+            }
+            return QSharedPointer<SwJsonSchema>(new SwJsonSchema(val.toObject(), this, location));
+        }
+        return QSharedPointer<SwJsonSchema>();
+    }
+
+    /// Entrée d'un conteneur de sous-schémas (properties, allOf, ...) : un booléen référence
+    /// le noeud constant, comme loadChild() ; un noeud partagé est copié pour garder sa
+    /// propre localisation.
+    QSharedPointer<SwJsonSchema> loadChildEntry(const QJsonValue &val, const QString &location)
+    {
+        if (val.isBool()) {
+            return constantSchema(val.toBool());
+        }
+        if (QSharedPointer<SwJsonSchema> shared = loadShared(val.toObject(), location)) {
+            // Copie de la partie fixe ; sous-schémas et mots-clés rares restent partagés
+            QSharedPointer<SwJsonSchema> copy(new SwJsonSchema(*shared));
+            copy->m_keywordLocation = location;
+            copy->m_profileEntry.storeRelaxed(nullptr);
+            copy->m_parent = this;
+            return copy;
+        }
+        return QSharedPointer<SwJsonSchema>(new SwJsonSchema(val.toObject(), this, location));
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Partage des sous-schémas identiques
+    // -----------------------------------------------------------------------
+    /// Noeuds compilés pendant le chargement d'un document, par URI de base et forme canonique.
+    struct DeduplicationPool {
+        QHash<QByteArray, QSharedPointer<SwJsonSchema>> nodes;
+    };
+
+    static DeduplicationPool *&activeDeduplicationPool()
+    {
+        static thread_local DeduplicationPool *pool = nullptr;
+        return pool;
+    }
+
+    /**
+     * @brief Réglages lus au chargement : moteur d'expressions et partage des sous-schémas.
+     *        Une définition différée garde ceux de son enregistrement (LoadSettingsScope).
+     */
+    struct LoadSettings {
+        RegexEngine regexEngine = RegexEngine::Backtracking;
+        bool        deduplication = false;
+    };
+
+    static const LoadSettings *&activeLoadSettings()
+    {
+        static thread_local const LoadSettings *settings = nullptr;
+        return settings;
+    }
+
+    /// Réglages du chargement en cours : ceux d'une définition différée, sinon les globaux.
+    static LoadSettings loadSettings()
+    {
+        if (const LoadSettings *pinned = activeLoadSettings()) {
+            return *pinned;
+        }
+        LoadSettings settings;
+        settings.regexEngine = regexEngine();
+        settings.deduplication = deduplicationSetting().loadRelaxed() != 0;
+        return settings;
+    }
+
+    /// Impose `settings` au chargement du thread pendant la portée.
+    struct LoadSettingsScope {
+        const LoadSettings *previous;
+
+        explicit LoadSettingsScope(const LoadSettings &settings)
+            : previous(activeLoadSettings())
+        {
+            activeLoadSettings() = &settings;
+        }
+
+        ~LoadSettingsScope()
+        {
+            activeLoadSettings() = previous;
+        }
+    };
+
+    /// Ouvre la table de partage pour le chargement le plus externe du thread (loadSchema).
+    struct DeduplicationScope {
+        DeduplicationPool pool;
+        bool owner = false;
+
+        DeduplicationScope()
+        {
+            if (!activeDeduplicationPool() && loadSettings().deduplication) {
+                activeDeduplicationPool() = &pool;
+                owner = true;
+            }
+        }
+
+        ~DeduplicationScope()
+        {
+            if (owner) {
+                activeDeduplicationPool() = nullptr;
+            }
+        }
+    };
+
+    static QAtomicInt &deduplicationSetting()
+    {
+        static QAtomicInt enabled(0);
+        return enabled;
+    }
+
+    /// Sous-schémas passés par la table de partage (`shared` = false) / réutilisés (true)
+    static QAtomicInt &deduplicationCount(bool shared)
+    {
+        static QAtomicInt subschemas(0);
+        static QAtomicInt reused(0);
+        return shared ? reused : subschemas;
+    }
+
+    /**
+     * @brief Noeud compilé une fois pour toutes les occurrences identiques de `data` dans le
+     *        document en cours de chargement ; nul hors chargement ou si `data` ne peut pas
+     *        être partagé (mêmes conditions qu'une définition différée).
+     */
+    QSharedPointer<SwJsonSchema> loadShared(const QJsonObject &data, const QString &location)
+    {
+        DeduplicationPool *pool = activeDeduplicationPool();
+        if (!pool || data.isEmpty() || !isSelfContainedDefinition(data)) {
+            return QSharedPointer<SwJsonSchema>();
+        }
+        const QByteArray key = m_baseUri.toUtf8() + '\n' + canonicalJson(data);
+        deduplicationCount(false).ref();
+        auto it = pool->nodes.constFind(key);
+        if (it != pool->nodes.constEnd()) {
+            deduplicationCount(true).ref();
+            return it.value();
+        }
+        QSharedPointer<SwJsonSchema> node(new SwJsonSchema(data, this, location));
+        pool->nodes.insert(key, node);
+        return node;
+    }
+
+    /// Moteur Linear strict : un motif qu'il ne sait pas exécuter invalide le schéma racine.
+    void rejectUnsupportedPatterns()
+    {
+        if (!m_parent && !cold().unsupportedPatterns.isEmpty() && loadSettings().regexEngine == RegexEngine::Linear) {
+            m_isValide = false;
+        }
+    }
+
+    /// Sous-schémas portés par ce noeud (sans suivre $ref).
+    void appendSubschemas(QVector<const SwJsonSchema*> &out) const
+    {
+        for (const QSharedPointer<SwJsonSchema> &branch : m_allOf) out << branch.data();
+        for (auto it = m_properties.cbegin(); it != m_properties.cend(); ++it) {
+            out << it.value().data();
+        }
+        out << m_additionalPropertiesSchema.data() << m_itemsSchema.data();
+        for (const QSharedPointer<SwJsonSchema> &prefix : m_prefixItemsSchemas) {
+            out << prefix.data();
+        }
+        if (!m_cold) {
+            return;
+        }
+        for (const QSharedPointer<SwJsonSchema> &branch : m_cold->anyOf) out << branch.data();
+        for (const QSharedPointer<SwJsonSchema> &branch : m_cold->oneOf) out << branch.data();
+        out << m_cold->notSchema.data() << m_cold->ifSchema.data() << m_cold->thenSchema.data()
+            << m_cold->elseSchema.data();
+        for (auto it = m_cold->patternProperties.cbegin(); it != m_cold->patternProperties.cend(); ++it) {
+            out << it.value().data();
+        }
+        out << m_cold->additionalItemsSchema.data() << m_cold->containsSchema.data()
+            << m_cold->unevaluatedPropertiesSchema.data() << m_cold->unevaluatedItemsSchema.data();
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Analyse de complexité (analyzeComplexity)
+    // -----------------------------------------------------------------------
+    /// Borne des compteurs d'évaluations (saturation au lieu du débordement).
+    static constexpr qint64 complexityCap = qint64(1) << 60;
+
+    /// Arc du graphe d'évaluation : `via` est le sous-schéma tel qu'écrit (éventuellement un $ref), `target` le noeud évalué.
+    struct ComplexityEdge {
+        const SwJsonSchema *target;
+        const SwJsonSchema *via;
+        bool consumes;  ///< Descend dans l'instance (propriété, élément)
+    };
+
+    QString complexityLocation() const
+    {
+        return m_baseUri + m_keywordLocation;
+    }
+
+    /// Noeud réellement évalué pour `node` en suivant les $ref ; nul pour un schéma booléen,
+    /// une référence introuvable ou un cycle formé uniquement de $ref (signalé).
+    static const SwJsonSchema *complexityTarget(const SwJsonSchema *node, ComplexityReport &report)
+    {
+        QVector<const SwJsonSchema*> chain;
+        while (node && node->m_constant == Constant::None && node->isReference()) {
+            if (chain.contains(node)) {
+                ComplexityFinding finding;
+                finding.severity = ComplexityFinding::Critical;
+                finding.kind = "recursion";
+                finding.location = node->complexityLocation();
+                finding.cost = "récursion sans fin";
+                finding.message = QString("Cycle formé uniquement de $ref (%1) : aucune valeur ne peut être validée.")
+                                      .arg(node->m_dollarRef);
+                report.findings << finding;
+                return nullptr;
+            }
+            chain << node;
+            node = node->resolveReference();
+        }
+        return (node && node->m_constant == Constant::None) ? node : nullptr;
+    }
+
+    /// Arcs sortants de ce noeud : sous-schémas évalués sur la même valeur ou sur ses descendants.
+    void appendComplexityEdges(QVector<ComplexityEdge> &out, ComplexityReport &report) const
+    {
+        auto add = [&](const SwJsonSchema *child, bool consumes) {
+            if (const SwJsonSchema *target = complexityTarget(child, report)) {
+                out << ComplexityEdge{target, child, consumes};
+            }
+        };
+        for (const QSharedPointer<SwJsonSchema> &branch : m_allOf) add(branch.data(), false);
+        for (auto it = m_properties.cbegin(); it != m_properties.cend(); ++it) {
+            add(it.value().data(), true);
+        }
+        if (m_recursiveSchema) {
+            // "$ref": "#" applique les properties, patternProperties et additionalProperties
+            // de la racine à l'objet courant
+            for (auto it = m_recursiveSchema->m_properties.cbegin(); it != m_recursiveSchema->m_properties.cend(); ++it) {
+                add(it.value().data(), true);
+            }
+            const ColdKeywords &rootKeywords = m_recursiveSchema->cold();
+            for (auto it = rootKeywords.patternProperties.cbegin(); it != rootKeywords.patternProperties.cend(); ++it) {
+                add(it.value().data(), true);
+            }
+            add(m_recursiveSchema->m_additionalPropertiesSchema.data(), true);
+        }
+        add(m_additionalPropertiesSchema.data(), true);
+        add(m_itemsSchema.data(), true);
+        for (const QSharedPointer<SwJsonSchema> &prefix : m_prefixItemsSchemas) {
+            add(prefix.data(), true);
+        }
+        if (!m_cold) {
+            return;
+        }
+        for (const QSharedPointer<SwJsonSchema> &branch : m_cold->anyOf) add(branch.data(), false);
+        for (const QSharedPointer<SwJsonSchema> &branch : m_cold->oneOf) add(branch.data(), false);
+        add(m_cold->notSchema.data(), false);
+        add(m_cold->ifSchema.data(), false);
+        add(m_cold->thenSchema.data(), false);
+        add(m_cold->elseSchema.data(), false);
+        for (auto it = m_cold->patternProperties.cbegin(); it != m_cold->patternProperties.cend(); ++it) {
+            add(it.value().data(), true);
+        }
+        add(m_cold->additionalItemsSchema.data(), true);
+        add(m_cold->containsSchema.data(), true);
+        add(m_cold->unevaluatedPropertiesSchema.data(), true);
+        add(m_cold->unevaluatedItemsSchema.data(), true);
+    }
+
+    /// Constats propres à ce noeud, évalué au pire `evaluations` fois par position de l'instance.
+    void analyzeNodeComplexity(qint64 evaluations, const ComplexityThresholds &thresholds, ComplexityReport &report) const
+    {
+        auto add = [&](ComplexityFinding::Severity severity, const QString &kind, const QString &location,
+                       const QString &cost, const QString &message) {
+            ComplexityFinding finding;
+            finding.severity = severity;
+            finding.kind = kind;
+            finding.location = m_baseUri + location;
+            finding.cost = cost;
+            finding.message = message;
+            report.findings << finding;
+        };
+        const ColdKeywords &keywords = cold();
+
+        if (keywords.hasPattern) {
+            analyzePattern(keywords.pattern, keywords.patternRegex, childLocation("pattern"), report);
+        }
+        int p = 0;
+        for (auto it = keywords.patternProperties.cbegin(); it != keywords.patternProperties.cend(); ++it, ++p) {
+            analyzePattern(it.key(), keywords.patternPropertyRegexes.value(p),
+                           childLocation("patternProperties", it.key()), report);
+        }
+        if (keywords.patternProperties.size() >= thresholds.patternProperties) {
+            add(ComplexityFinding::Warning, "patternProperties", childLocation("patternProperties"),
+                QString("%1 motifs par clé").arg(keywords.patternProperties.size()),
+                QString("Chaque propriété de l'objet est testée contre les %1 motifs.").arg(keywords.patternProperties.size()));
+        }
+
+        if (m_uniqueItems && m_maxItems < 0) {
+            add(ComplexityFinding::Warning, "uniqueItems", childLocation("uniqueItems"), "O(n²) en la taille du tableau",
+                "uniqueItems sans maxItems : les comparaisons par paires ne sont bornées que par "
+                "ValidationLimits::maxArrayItems.");
+        } else if (m_uniqueItems && m_maxItems >= thresholds.uniqueItems) {
+            add(ComplexityFinding::Info, "uniqueItems", childLocation("uniqueItems"),
+                QString("O(n²), n <= %1").arg(m_maxItems),
+                QString("uniqueItems sur un tableau de %1 éléments au plus.").arg(m_maxItems));
+        }
+
+        // Éventail : chaque évaluation du noeud essaie toutes ses branches (au pire : pas de
+        // discriminant dans l'instance, aucune branche ne court-circuite)
+        const QList<QPair<QString, int>> fanOuts = {
+            qMakePair(QString("anyOf"), int(keywords.anyOf.size())),
+            qMakePair(QString("oneOf"), int(keywords.oneOf.size()))
+        };
+        for (const QPair<QString, int> &fanOut : fanOuts) {
+            if (fanOut.second == 0) {
+                continue;
+            }
+            const qint64 cost = evaluations > complexityCap / fanOut.second ? complexityCap : evaluations * fanOut.second;
+            if (cost < thresholds.fanOutWarning) {
+                continue;
+            }
+            add(cost >= thresholds.fanOutCritical ? ComplexityFinding::Critical : ComplexityFinding::Warning,
+                "fanOut", childLocation(fanOut.first),
+                QString("%1 branches par position (%2 chemins x %3)").arg(cost).arg(evaluations).arg(fanOut.second),
+                (evaluations > 1 ? QString("%1 atteint par %2 chemins (combinateurs imbriqués, $ref partagés) : ")
+                                       .arg(fanOut.first).arg(evaluations)
+                                 : QString("%1 de %2 branches, toutes essayées au pire : ").arg(fanOut.first).arg(fanOut.second))
+                    + "ValidationOptions::memoize évite de réévaluer une même branche.");
+        }
+    }
+
+    void analyzePattern(const QString &pattern, const SwJsonSchemaRegex &regex, const QString &location,
+                        ComplexityReport &report) const
+    {
+        ComplexityFinding finding;
+        finding.kind = "pattern";
+        finding.location = m_baseUri + location;
+        const SwJsonSchemaRegex::BacktrackingRisk risk = SwJsonSchemaRegex::backtrackingRisk(pattern);
+        if (risk != SwJsonSchemaRegex::BacktrackingRisk::None) {
+            if (regex.engine() != SwJsonSchemaRegex::Backtracking) {
+                finding.severity = ComplexityFinding::Info;
+                finding.cost = "linéaire";
+                finding.message = QString("/%1/ : construction à risque, sans effet avec le moteur linéaire.").arg(pattern);
+            } else {
+                switch (risk) {
+                case SwJsonSchemaRegex::BacktrackingRisk::Exponential:
+                    finding.severity = ComplexityFinding::Critical;
+                    finding.cost = "exponentiel en la longueur de la chaîne";
+                    break;
+                case SwJsonSchemaRegex::BacktrackingRisk::Ambiguous:
+                    finding.severity = ComplexityFinding::Warning;
+                    finding.cost = "exponentiel en cas d'échec";
+                    break;
+                default:
+                    finding.severity = ComplexityFinding::Warning;
+                    finding.cost = "polynomial";
+                    break;
+                }
+                finding.message = QString("/%1/ : retour arrière catastrophique possible ; borner la chaîne "
+                                          "(maxLength, ValidationLimits::maxPatternLength) ou choisir le moteur "
+                                          "RegexEngine::Linear.").arg(pattern);
+            }
+            report.findings << finding;
+        }
+        if (!pattern.startsWith('^')) {
+            finding.severity = ComplexityFinding::Info;
+            finding.cost = "une tentative par position";
+            finding.message = QString("/%1/ : motif non ancré, essayé à chaque position de la chaîne.").arg(pattern);
+            report.findings << finding;
+        }
+    }
+
+    /**
+     * @brief Conteneurs implicitement partagés déjà comptés par memoryUsage(), rangés par
+     *        première clé. Les copies retenues ici ne font qu'incrémenter leur compteur de
+     *        références : elles restent partagées avec les conteneurs des noeuds.
+     */
+    struct CountedContainers {
+        QHash<QString, QList<QMap<QString, QSharedPointer<SwJsonSchema>>>> properties;
+        QHash<QString, QList<QSet<QString>>> required;
+    };
+
+    /// Vrai à la première rencontre d'un QMap non vide : une copie qui partage ses données
+    /// (sous-schémas identiques, copies de schéma) n'est comptée qu'une fois.
+    static bool firstCount(const QMap<QString, QSharedPointer<SwJsonSchema>> &map, CountedContainers &counted)
+    {
+        if (map.isEmpty()) {
+            return false;
+        }
+        QList<QMap<QString, QSharedPointer<SwJsonSchema>>> &bucket = counted.properties[map.firstKey()];
+        for (const QMap<QString, QSharedPointer<SwJsonSchema>> &other : bucket) {
+            if (other.isSharedWith(map)) {
+                return false;
+            }
+        }
+        bucket << map;
+        return true;
+    }
+
+    /// Idem pour un QSet : deux QSet partagent leurs données si leurs itérateurs de début
+    /// désignent le même élément.
+    static bool firstCount(const QSet<QString> &set, CountedContainers &counted)
+    {
+        if (set.isEmpty()) {
+            return false;
+        }
+        QList<QSet<QString>> &bucket = counted.required[*set.constBegin()];
+        for (const QSet<QString> &other : bucket) {
+            if (other.constBegin() == set.constBegin()) {
+                return false;
+            }
+        }
+        bucket << set;
+        return true;
+    }
+
+    /// Vrai à la première rencontre d'un bloc non nul (le marque alors comme compté).
+    static bool firstCount(const void *data, QSet<const void*> &counted)
+    {
+        if (!data || counted.contains(data)) {
+            return false;
+        }
+        counted.insert(data);
+        return true;
+    }
+
+    /// Octets d'un tampon de chaîne, nul s'il est vide ou déjà compté (chaînes partagées).
+    static qint64 stringMemory(const QString &value, QSet<const void*> &counted)
+    {
+        if (value.isEmpty() || counted.contains(value.constData())) {
+            return 0;
+        }
+        counted.insert(value.constData());
+        return value.capacity() * qint64(sizeof(QChar));
+    }
+
+    static qint64 discriminatorMemory(const Discriminator &discriminator, QSet<const void*> &counted)
+    {
+        qint64 bytes = stringMemory(discriminator.property, counted);
+        for (auto it = discriminator.branches.cbegin(); it != discriminator.branches.cend(); ++it) {
+            bytes += 3 * sizeof(void*) + it.key().size() + it.value().capacity() * qint64(sizeof(int));
+        }
+        return bytes;
+    }
+
+    /// Part de ce seul noeud dans memoryUsage() (ses sous-schémas sont comptés à part).
+    void accountMemory(MemoryUsage &usage, QSet<const void*> &counted, CountedContainers &containers) const
+    {
+        const qint64 entry = 3 * sizeof(void*);  // Estimation par entrée de QMap / QSet / QHash
+        usage.nodeBytes += sizeof(SwJsonSchema);
+        usage.identifierBytes += stringMemory(m_baseUri, counted) + stringMemory(m_dollarRef, counted)
+                                 + stringMemory(m_keywordLocation, counted);
+        // Conteneurs partagés entre copies (sous-schémas identiques) : comptés une fois
+        if (firstCount(m_properties, containers)) {
+            for (auto it = m_properties.cbegin(); it != m_properties.cend(); ++it) {
+                usage.objectBytes += entry + stringMemory(it.key(), counted);
+            }
+        }
+        if (firstCount(m_required, containers)) {
+            for (const QString &name : m_required) {
+                usage.objectBytes += entry + stringMemory(name, counted);
+            }
+        }
+        if (firstCount(m_prefixItemsSchemas.constData(), counted)) {
+            usage.arrayBytes += m_prefixItemsSchemas.capacity() * qint64(sizeof(QSharedPointer<SwJsonSchema>));
+        }
+        if (firstCount(m_steps.constData(), counted)) {
+            usage.cacheBytes += m_steps.capacity();
+        }
+        if (firstCount(m_costOrderedSteps.constData(), counted)) {
+            usage.cacheBytes += m_costOrderedSteps.capacity();
+        }
+        if (PathCache *cache = m_pathCache.loadAcquire()) {
+            QMutexLocker locker(&cache->mutex);
+            usage.cacheBytes += sizeof(PathCache);
+            for (const QString &pointer : cache->entries.keys()) {
+                const PathLookup *lookup = cache->entries.object(pointer);
+                usage.cacheBytes += entry + stringMemory(pointer, counted) + stringMemory(lookup->forbidden, counted)
+                                    + lookup->schemas.capacity() * qint64(sizeof(void*));
+            }
+        }
+        if (!m_cold) {
+            return;
+        }
+        const ColdKeywords &cold = *m_cold;
+        ++usage.nodesWithColdKeywords;
+        if (!firstCount(&cold, counted)) {
+            return;
+        }
+        usage.coldBytes += sizeof(ColdKeywords);
+        usage.identifierBytes += stringMemory(cold.dollarSchema, counted) + stringMemory(cold.dollarAnchor, counted);
+        for (const QJsonValue &value : cold.enumValues) {
+            usage.valueBytes += QJsonDocument(QJsonArray() << value).toJson(QJsonDocument::Compact).size() - 2;
+        }
+        if (!cold.constValue.isUndefined()) {
+            usage.valueBytes += QJsonDocument(QJsonArray() << cold.constValue).toJson(QJsonDocument::Compact).size() - 2;
+        }
+        usage.stringBytes += stringMemory(cold.pattern, counted) + stringMemory(cold.format, counted)
+                             + cold.patternRegex.memoryUsage(counted);
+        for (const SwJsonSchemaRegex &regex : cold.patternPropertyRegexes) {
+            usage.stringBytes += regex.memoryUsage(counted);
+        }
+        for (auto it = cold.patternProperties.cbegin(); it != cold.patternProperties.cend(); ++it) {
+            usage.objectBytes += entry + stringMemory(it.key(), counted);
+        }
+        for (auto it = cold.dependentRequired.cbegin(); it != cold.dependentRequired.cend(); ++it) {
+            usage.objectBytes += entry + stringMemory(it.key(), counted);
+            for (const QString &name : it.value()) {
+                usage.objectBytes += sizeof(QString) + stringMemory(name, counted);
+            }
+        }
+        usage.applicatorBytes += discriminatorMemory(cold.oneOfDiscriminator, counted)
+                                 + discriminatorMemory(cold.anyOfDiscriminator, counted);
+        if (cold.resultCache && firstCount(cold.resultCache.data(), counted)) {
+            usage.cacheBytes += cold.resultCache->memoryUsage();
+        }
+    }
+
+    /**
+     * @brief Définition différée : compilée hors de loadSchema, sous la base de son document et
+     *        dans les registres `context`.
+     *
+     * Racine de ses propres sous-schémas : elle ne garde aucun pointeur vers le schéma qui
+     * l'a déclarée (qui a pu être détruit depuis) et tient elle-même ses motifs non supportés,
+     * écrits avant sa publication (voir unsupportedPatterns()). `settings` sont ceux du
+     * chargement qui l'a enregistrée, quels que soient les réglages globaux au moment de
+     * la compilation.
+     */
+    SwJsonSchema(SwJsonSchemaContext *context, const QJsonObject &data, const QString &baseUri,
+                 const QString &keywordLocation, const LoadSettings &settings)
+        : m_baseUri(baseUri), m_keywordLocation(keywordLocation), m_parent(nullptr)
+    {
+        m_registryContext = context;
+        m_isValide = !data.isEmpty();
+        if (m_isValide) {
+            LoadSettingsScope settingsScope(settings);
+            loadSchema(data, nullptr);
+        }
+    }
+
+    static QAtomicInt &lazyDefinitionsSetting()
+    {
+        static QAtomicInt lazy(1);
+        return lazy;
+    }
+
+    /**
+     * @brief Vrai si `value` peut être compilé plus tard, ou une seule fois pour plusieurs
+     *        occurrences, sans changer le chargement : aucun $id / $anchor à enregistrer,
+     *        aucun $ref externe à charger.
+     */
+    static bool isSelfContainedDefinition(const QJsonValue &value)
+    {
+        if (value.isArray()) {
+            for (const QJsonValue &item : value.toArray()) {
+                if (!isSelfContainedDefinition(item)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (!value.isObject()) {
+            return true;
+        }
+        const QJsonObject obj = value.toObject();
+        if (obj.contains("$id") || obj.contains("$anchor") || obj.contains("$dynamicAnchor")) {
+            return false;
+        }
+        const QString ref = obj.value("$ref").toString().trimmed();
+        if (!ref.isEmpty() && !ref.contains("$def") && !ref.startsWith("#")) {
+            return false;
+        }
+        // "$ref": "#" désigne la racine du document, qu'une définition différée ne retient pas
+        if (ref == "#") {
+            return false;
+        }
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            if (it.key() == "const" || it.key() == "enum" || it.key() == "default" || it.key() == "examples") {
+                continue;
+            }
+            if (!isSelfContainedDefinition(it.value())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Entrée de $defs / definitions : enregistrée compilée, ou différée jusqu'à sa première résolution.
+    void registerDefinition(const QString &keyword, const QString &name, const QJsonValue &value)
+    {
+        const QString anchor = "#/" + keyword + "/" + name;
+        if (value.isBool()) {
+            getRegistry(m_baseUri)->registerSchemaByAnchor(anchor, constantSchema(value.toBool()).data());
+            return;
+        }
+        if (!value.isObject()) {
+            return;
+        }
+        // Le moteur Linear strict doit voir tous les motifs au chargement (rejectUnsupportedPatterns)
+        const LoadSettings settings = loadSettings();
+        if (lazyDefinitionsSetting().loadRelaxed() && settings.regexEngine != RegexEngine::Linear
+            && isSelfContainedDefinition(value)) {
+            const QJsonObject data = value.toObject();
+            const QString baseUri = resolveUri(this, QString());
+            // Le contexte détient le registre, donc cette définition : il lui survit
+            SwJsonSchemaContext *context = m_registryContext;
+            const QString location = childLocation(keyword, name);
+            QSharedPointer<SwJsonSchemaLazyDefinition> definition(new SwJsonSchemaLazyDefinition(
+                [data, baseUri, context, location, settings]() {
+                    SwJsonSchema *node = new SwJsonSchema(context, data, baseUri, location, settings);
+                    node->registryContext()->adopt(node);
+                    return node;
+                }));
+            SwJsonSchemaLazyDefinition::deferredCount().ref();
+            getRegistry(m_baseUri)->registerLazySchemaByAnchor(anchor, definition);
+            return;
+        }
+        SwJsonSchema *def = new SwJsonSchema(value.toObject(), this, childLocation(keyword, name));
+        registryContext()->adopt(def);
+        getRegistry(m_baseUri)->registerSchemaByAnchor(anchor, def);
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Méthodes de chargement
+    // -----------------------------------------------------------------------
+    void loadSchema(const QJsonObject &schemaObject, const SwJsonSchema *parent)
+    {
+        DeduplicationScope deduplicationScope;
+
+        // 1) Lire $schema (optionnel)
+        if (schemaObject.contains("$schema") && schemaObject.value("$schema").isString()) {
+            mutableCold().dollarSchema = schemaObject.value("$schema").toString();
+        }
+
+        // 2) Lire $id
+        if (schemaObject.contains("$id") && schemaObject.value("$id").isString()) {
+            m_baseUri = schemaObject.value("$id").toString().trimmed();
+        }
+
+        // 3) Calcul du m_baseUri
+        m_baseUri = resolveUri(parent, m_baseUri);
+
+        // 5) Lire $anchor
+        //        getRegistry(m_baseUri)->registerSchemaByAnchor("#", this);
+        if (schemaObject.contains("$anchor") && schemaObject.value("$anchor").isString()) {
+            mutableCold().dollarAnchor = schemaObject.value("$anchor").toString().trimmed();
+            if (!cold().dollarAnchor.isEmpty()) {
+                QString fullAnchor = m_baseUri + "#" + cold().dollarAnchor;
+                getRegistry(m_baseUri)->registerSchemaByAnchor(fullAnchor, this);
+            }
+        }
+
+        // 6) Lire $ref
+        if (schemaObject.contains("$ref") && schemaObject.value("$ref").isString()) {
+            m_dollarRef = schemaObject.value("$ref").toString().trimmed();
+            if(!m_dollarRef.contains("$def")){
+                if(!m_dollarRef.trimmed().startsWith("#")){
+                    QStringList tmpLst = m_baseUri.split("/");
+                    tmpLst.removeLast();
+                    tmpLst.append(m_dollarRef.split("#").first());
+                    LoadContext *context = activeLoadContext();
+                    const QString target = context ? documentKey(tmpLst.join("/")) : QString();
+                    if (context && context->documents->contains(target)) {
+                        // Document déjà lu par SwJsonSchemaLoader : compilé à part, lié ensuite
+                        if (context->documents->value(target)) {
+                            context->links << DeferredLink{m_baseUri, tmpLst.join("/"), target};
+                        } else {
+                            m_dollarRef = "";
+                        }
+                    } else {
+                        SwJsonSchema *ref = new SwJsonSchema(tmpLst.join("/"), this);
+                        if(ref->m_isValide){
+                            registryContext()->adopt(ref);
+                            getRegistry(m_baseUri)->registerSchemaByRef(tmpLst.join("/"), ref);
+                        } else {
+                            delete ref;
+                            m_dollarRef = "";
+                        }
+                    }
+                } else if(m_dollarRef.trimmed() == "#"){
+                    //recursive reference
+                    m_recursiveSchema = findMainSchema();
+                }
+            }
+        }
+
+        // 7.1) Charger $defs
+        if (schemaObject.contains("$defs") && schemaObject.value("$defs").isObject()) {
+            QJsonObject defsObj = schemaObject.value("$defs").toObject();
+            for (auto it = defsObj.begin(); it != defsObj.end(); ++it) {
+                registerDefinition("$defs", it.key(), it.value());
+            }
+        }
+        // 7.2) Charger $defs
+        if (schemaObject.contains("definitions") && schemaObject.value("definitions").isObject()) {
+            QJsonObject defsObj = schemaObject.value("definitions").toObject();
+            for (auto it = defsObj.begin(); it != defsObj.end(); ++it) {
+                registerDefinition("definitions", it.key(), it.value());
+            }
+        }
+
+        // 8) Lire "type"
+        if (schemaObject.contains("type")) {
+            m_types = parseType(schemaObject.value("type"));
+        }
+
+        // 9) enum / const
+        if (schemaObject.contains("enum") && schemaObject.value("enum").isArray()) {
+            QJsonArray arr = schemaObject.value("enum").toArray();
+            for (const auto &v : arr) {
+                mutableCold().enumValues.append(v);
+            }
+        }
+        if (schemaObject.contains("const")) {
+            mutableCold().constValue = schemaObject.value("const");
+        }
+
+        // 10) multipleOf, minimum, maximum, ...
+        if (schemaObject.contains("multipleOf")) {
+            mutableCold().multipleOf = schemaObject.value("multipleOf").toDouble(0.0);
+            mutableCold().hasMultipleOf = true;
+        }
+        if (schemaObject.contains("minimum")) {
+            m_minimum = schemaObject.value("minimum").toDouble(0.0);
+            m_hasMinimum = true;
+        }
+        if (schemaObject.contains("maximum")) {
+            m_maximum = schemaObject.value("maximum").toDouble(0.0);
+            m_hasMaximum = true;
+        }
+        if (schemaObject.contains("exclusiveMinimum")) {
+            const QJsonValue exMin = schemaObject.value("exclusiveMinimum");
+            if (exMin.isBool()) {
+                m_exclusiveMinimum = exMin.toBool(false);
+            } else {
+                m_minimum = exMin.toDouble(0.0);
+                m_hasMinimum = true;
+                m_exclusiveMinimum = true;
+            }
+        }
+        if (schemaObject.contains("exclusiveMaximum")) {
+            const QJsonValue exMax = schemaObject.value("exclusiveMaximum");
+            if (exMax.isBool()) {
+                m_exclusiveMaximum = exMax.toBool(false);
+            } else {
+                m_maximum = exMax.toDouble(0.0);
+                m_hasMaximum = true;
+                m_exclusiveMaximum = true;
+            }
+        }
+
+        // 11) minLength / maxLength / pattern / format
+        if (schemaObject.contains("minLength")) {
+            m_minLength = schemaObject.value("minLength").toInt(-1);
+        }
+        if (schemaObject.contains("maxLength")) {
+            m_maxLength = schemaObject.value("maxLength").toInt(-1);
+        }
+        if (schemaObject.contains("pattern")) {
+            mutableCold().pattern = schemaObject.value("pattern").toString();
+            mutableCold().hasPattern = true;
+            mutableCold().patternRegex = compileRegex(cold().pattern, childLocation("pattern"));
+        }
+        if (schemaObject.contains("format")) {
+            mutableCold().format = schemaObject.value("format").toString();
+        }
+
+        // 12) items / prefixItems / additionalItems
+        if (schemaObject.contains("items")) {
+            QJsonValue val = schemaObject.value("items");
+            if (val.isArray()) {
+                QJsonArray arr = val.toArray();
+                for (int i = 0; i < arr.size(); ++i) {
+                    if (isSchemaValue(arr.at(i))) {
+                        m_prefixItemsSchemas.append(loadChild(arr.at(i), childLocation("items", QString::number(i))));
+                    }
+                }
+            } else {
+                m_itemsSchema = loadChild(val, childLocation("items"));
+            }
+        }
+        // prefixItems (2020-12) : "items" s'applique alors aux éléments suivants
+        if (schemaObject.contains("prefixItems") && schemaObject.value("prefixItems").isArray()) {
+            QJsonArray arr = schemaObject.value("prefixItems").toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                if (isSchemaValue(arr.at(i))) {
+                    m_prefixItemsSchemas.append(loadChild(arr.at(i), childLocation("prefixItems", QString::number(i))));
+                }
+            }
+        }
+        if (schemaObject.contains("additionalItems")) {
+            mutableCold().additionalItemsSchema = loadChild(schemaObject.value("additionalItems"), childLocation("additionalItems"));
+        }
+        if (schemaObject.contains("minItems")) {
+            m_minItems = schemaObject.value("minItems").toInt(-1);
+        }
+        if (schemaObject.contains("maxItems")) {
+            m_maxItems = schemaObject.value("maxItems").toInt(-1);
+        }
+        if (schemaObject.contains("uniqueItems")) {
+            m_uniqueItems = schemaObject.value("uniqueItems").toBool(false);
+        }
+
+        // 13) contains / minContains / maxContains
+        if (schemaObject.contains("contains")) {
+            mutableCold().containsSchema = loadChild(schemaObject.value("contains"), childLocation("contains"));
+        }
+        if (schemaObject.contains("minContains")) {
+            mutableCold().minContains = schemaObject.value("minContains").toInt(-1);
+        }
+        if (schemaObject.contains("maxContains")) {
+            mutableCold().maxContains = schemaObject.value("maxContains").toInt(-1);
+        }
+
+        // 14) properties / patternProperties / additionalProperties
+        if (schemaObject.contains("properties") && schemaObject.value("properties").isObject()) {
+            QJsonObject props = schemaObject.value("properties").toObject();
+            for (auto it = props.begin(); it != props.end(); ++it) {
+                if (isSchemaValue(it.value())) {
+                    m_properties.insert(it.key(), loadChildEntry(it.value(), childLocation("properties", it.key())));
+                }
+            }
+        }
+        if (schemaObject.contains("patternProperties") && schemaObject.value("patternProperties").isObject()) {
+            QJsonObject pprops = schemaObject.value("patternProperties").toObject();
+            for (auto it = pprops.begin(); it != pprops.end(); ++it) {
+                if (isSchemaValue(it.value())) {
+                    mutableCold().patternProperties.insert(it.key(), loadChildEntry(it.value(), childLocation("patternProperties", it.key())));
+                }
+            }
+            // Compilées une fois, dans l'ordre d'itération de cold().patternProperties
+            for (auto it = cold().patternProperties.cbegin(); it != cold().patternProperties.cend(); ++it) {
+                mutableCold().patternPropertyRegexes << compileRegex(it.key(), childLocation("patternProperties", it.key()));
+            }
+        }
+        if (schemaObject.contains("additionalProperties")) {
+            m_additionalPropertiesSchema = loadChild(schemaObject.value("additionalProperties"),
+                                                     childLocation("additionalProperties"));
+        }
+
+        // unevaluatedProperties / unevaluatedItems (2020-12)
+        if (schemaObject.contains("unevaluatedProperties")) {
+            mutableCold().unevaluatedPropertiesSchema = loadChild(schemaObject.value("unevaluatedProperties"),
+                                                                  childLocation("unevaluatedProperties"));
+        }
+        if (schemaObject.contains("unevaluatedItems")) {
+            mutableCold().unevaluatedItemsSchema = loadChild(schemaObject.value("unevaluatedItems"),
+                                                             childLocation("unevaluatedItems"));
+        }
+
+        // 15) required / dependentRequired
+        if (schemaObject.contains("required") && schemaObject.value("required").isArray()) {
+            QJsonArray reqArr = schemaObject.value("required").toArray();
+            for (const auto &r : reqArr) {
+                if (r.isString()) {
+                    m_required.insert(r.toString());
+                }
+            }
+        }
+        if (schemaObject.contains("dependentRequired") && schemaObject.value("dependentRequired").isObject()) {
+            QJsonObject drObj = schemaObject.value("dependentRequired").toObject();
+            for (auto it = drObj.begin(); it != drObj.end(); ++it) {
+                if (it.value().isArray()) {
+                    QStringList deps;
+                    for (const auto &d : it.value().toArray()) {
+                        deps << d.toString();
+                    }
+                    mutableCold().dependentRequired.insert(it.key(), deps);
+                }
+            }
+        }
+
+        // 16) allOf / anyOf / oneOf / not
+        if (schemaObject.contains("allOf") && schemaObject.value("allOf").isArray()) {
+            QJsonArray arr = schemaObject.value("allOf").toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                if (isSchemaValue(arr.at(i))) {
+                    m_allOf.append(loadChildEntry(arr.at(i), childLocation("allOf", QString::number(i))));
+                }
+            }
+        }
+        if (schemaObject.contains("anyOf") && schemaObject.value("anyOf").isArray()) {
+            QJsonArray arr = schemaObject.value("anyOf").toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                if (isSchemaValue(arr.at(i))) {
+                    mutableCold().anyOf.append(loadChildEntry(arr.at(i), childLocation("anyOf", QString::number(i))));
+                }
+            }
+        }
+        if (schemaObject.contains("oneOf") && schemaObject.value("oneOf").isArray()) {
+            QJsonArray arr = schemaObject.value("oneOf").toArray();
+            for (int i = 0; i < arr.size(); ++i) {
+                if (isSchemaValue(arr.at(i))) {
+                    mutableCold().oneOf.append(loadChildEntry(arr.at(i), childLocation("oneOf", QString::number(i))));
+                }
+            }
+        }
+        if (schemaObject.contains("not")) {
+            mutableCold().notSchema = loadChild(schemaObject.value("not"), childLocation("not"));
+        }
+        // 17) if / then / else
+        if (schemaObject.contains("if")) {
+            mutableCold().ifSchema = loadChild(schemaObject.value("if"), childLocation("if"));
+        }
+        if (schemaObject.contains("then")) {
+            mutableCold().thenSchema = loadChild(schemaObject.value("then"), childLocation("then"));
+        }
+        if (schemaObject.contains("else")) {
+            mutableCold().elseSchema = loadChild(schemaObject.value("else"), childLocation("else"));
+        }
+
+        // 18) Si type pas défini => tenter deduceTypeFromConstraints()
+        if (m_types == 0) {
+            deduceTypeFromConstraints();
+        }
+
+        const auto& customKeywords = getCustomKeywordRegistry();
+        foreach(const QString &key, schemaObject.keys()){
+            if(customKeywords.contains(key)) {
+                KeywordJsonValidator userKey(customKeywords.value(key));
+                userKey.setRules(schemaObject.value(key));
+                userKey.setKeyword(key);
+                mutableCold().internalCustomKeywordValidator.append(userKey);
+            }
+        }
+
+        // 19) Propriétés discriminantes des unions
+        if (m_cold) {
+            m_cold->oneOfDiscriminator = findDiscriminator(m_cold->oneOf);
+            m_cold->anyOfDiscriminator = findDiscriminator(m_cold->anyOf);
+        }
+
+        // 20) Ordre d'évaluation des mots-clés
+        buildEvaluationOrder();
+    }
+
+    /**
+     * @brief Recherche une propriété que toutes les branches contraignent par const / enum.
+     *
+     * Une branche dont la valeur const / enum ne contient pas celle de l'instance échoue
+     * forcément sur "properties" : seules les branches indexées sous cette valeur sont à
+     * évaluer. Parmi les candidates, on retient la propriété qui laisse le moins de
+     * branches par valeur. Une branche réduite à un $ref n'est pas analysée.
+     */
+    static Discriminator findDiscriminator(const QList<QSharedPointer<SwJsonSchema>> &branches)
+    {
+        Discriminator best;
+        if (branches.size() < 2) {
+            return best;
+        }
+        int bestBucket = branches.size();
+        const SwJsonSchema &first = *branches.first();
+        for (auto pit = first.m_properties.cbegin(); pit != first.m_properties.cend(); ++pit) {
+            QHash<QByteArray, QVector<int>> table;
+            bool eligible = true;
+            for (int i = 0; i < branches.size() && eligible; ++i) {
+                const SwJsonSchema &branch = *branches.at(i);
+                auto it = branch.m_properties.constFind(pit.key());
+                if (branch.isReference() || it == branch.m_properties.constEnd()) {
+                    eligible = false;
+                    break;
+                }
+                QList<QJsonValue> allowed = it.value()->allowedValues();
+                if (allowed.isEmpty()) {
+                    eligible = false;
+                    break;
+                }
+                for (const QJsonValue &v : allowed) {
+                    QVector<int> &bucket = table[canonicalJson(v)];
+                    if (bucket.isEmpty() || bucket.last() != i) {
+                        bucket.append(i);
+                    }
+                }
+            }
+            if (!eligible) {
+                continue;
+            }
+            int largest = 0;
+            for (auto it = table.cbegin(); it != table.cend(); ++it) {
+                largest = qMax(largest, int(it.value().size()));
+            }
+            if (largest < bestBucket) {
+                best.property = pit.key();
+                best.branches = table;
+                bestBucket = largest;
+            }
+        }
+        return best;
+    }
+
+    /// Valeurs admises par ce schéma via const / enum (vide = non contraint).
+    QList<QJsonValue> allowedValues() const
+    {
+        if (isReference()) {
+            return QList<QJsonValue>();
+        }
+        if (!cold().constValue.isUndefined()) {
+            return QList<QJsonValue>() << cold().constValue;
+        }
+        return cold().enumValues;
+    }
+
+    bool isReference() const
+    {
+        return !m_dollarRef.isEmpty() && m_dollarRef != "#";
+    }
+
+    /// Cible de $ref, recherchée dans les registres de ce noeud puis de ses parents (nul si introuvable).
+    const SwJsonSchema *resolveReference() const
+    {
+        bool isFound = false;
+        SwJsonSchema *refSchema = const_cast<SwJsonSchema *>(this);
+        while(!isFound && refSchema != nullptr){
+            refSchema = refSchema->getRegistry(refSchema->m_baseUri)->resolveRef(m_dollarRef, refSchema->m_baseUri, isFound);
+        }
+        return refSchema;
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Navigation par JSON Pointer (validateAt)
+    // -----------------------------------------------------------------------
+    /// Sous-schémas applicables à une position de l'instance ; forbidden non vide si elle est interdite.
+    struct PathLookup {
+        QVector<const SwJsonSchema*> schemas;
+        QString forbidden;
+    };
+
+    /// Pointeurs d'instance dont la navigation est gardée en cache par validateAt() (LRU)
+    static constexpr int pathCacheCapacity = 256;
+
+    /// Cache de validateAt() : JSON Pointer -> sous-schémas applicables
+    struct PathCache {
+        QMutex mutex;
+        QCache<QString, PathLookup> entries{pathCacheCapacity};
+    };
+
+    PathCache &pathCache() const
+    {
+        PathCache *cache = m_pathCache.loadAcquire();
+        if (!cache) {
+            PathCache *created = new PathCache;
+            if (m_pathCache.testAndSetOrdered(nullptr, created)) {
+                cache = created;
+            } else {
+                delete created;
+                cache = m_pathCache.loadAcquire();
+            }
+        }
+        return *cache;
+    }
+
+    /**
+     * @brief Sous-schémas applicables à la position `tokens` (déjà déséchappés).
+     *
+     * À chaque niveau, les noeuds courants sont étendus à leurs cibles $ref et à leurs
+     * branches allOf (appliquées sans condition), puis on descend par properties,
+     * patternProperties, additionalProperties, prefixItems / items / additionalItems,
+     * et à défaut par unevaluatedProperties / unevaluatedItems.
+     */
+    PathLookup lookupPath(const QStringList &tokens) const
+    {
+        PathLookup lookup;
+        lookup.schemas << this;
+        for (const QString &token : tokens) {
+            QVector<const SwJsonSchema*> scope;
+            QSet<const SwJsonSchema*> seen;
+            for (const SwJsonSchema *schema : lookup.schemas) {
+                if (!expandApplicators(schema, scope, seen, lookup.forbidden)) {
+                    lookup.schemas.clear();
+                    return lookup;
+                }
+            }
+            QVector<const SwJsonSchema*> next;
+            for (const SwJsonSchema *schema : scope) {
+                if (schema->rejectsAll()) {
+                    // Aucune valeur admise ici : a fortiori aucun descendant
+                    lookup.forbidden = falseSchemaError();
+                }
+                schema->collectChildSchemas(token, next, lookup.forbidden);
+                if (schema->m_recursiveSchema) {
+                    schema->m_recursiveSchema->collectPropertySchemas(token, next, lookup.forbidden);
+                }
+                if (!lookup.forbidden.isEmpty()) {
+                    lookup.schemas.clear();
+                    return lookup;
+                }
+            }
+            for (const SwJsonSchema *schema : scope) {
+                schema->collectUnevaluatedSchema(token, next, lookup.forbidden);
+                if (!lookup.forbidden.isEmpty()) {
+                    lookup.schemas.clear();
+                    return lookup;
+                }
+            }
+            lookup.schemas.clear();
+            QSet<const SwJsonSchema*> unique;
+            for (const SwJsonSchema *schema : next) {
+                if (!schema->acceptsAll() && !unique.contains(schema)) {
+                    unique.insert(schema);
+                    lookup.schemas << schema;
+                }
+            }
+            if (lookup.schemas.isEmpty()) {
+                break;  // position non contrainte
+            }
+        }
+        return lookup;
+    }
+
+    /// Ajoute `schema`, ses cibles $ref et ses branches allOf à `scope` ; faux (et `error`) si une $ref est introuvable.
+    static bool expandApplicators(const SwJsonSchema *schema,
+                                  QVector<const SwJsonSchema*> &scope,
+                                  QSet<const SwJsonSchema*> &seen,
+                                  QString &error)
+    {
+        if (seen.contains(schema)) {
+            return true;
+        }
+        seen.insert(schema);
+        if (schema->isReference()) {
+            const SwJsonSchema *target = schema->resolveReference();
+            if (!target) {
+                error = QString("Impossible de résoudre la référence '%1'.").arg(schema->m_dollarRef);
+                return false;
+            }
+            return expandApplicators(target, scope, seen, error);
+        }
+        scope << schema;
+        for (const QSharedPointer<SwJsonSchema> &branch : schema->m_allOf) {
+            if (!expandApplicators(branch.data(), scope, seen, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief unevaluatedProperties / unevaluatedItems de ce noeud pour l'enfant `token`, si
+     *        aucun mot-clé de ce noeud (ni de ses $ref / allOf) ne l'évalue.
+     *
+     * Un anyOf / oneOf / if dans ce périmètre pourrait l'évaluer selon le reste du
+     * document : le mot-clé n'est alors pas appliqué.
+     */
+    void collectUnevaluatedSchema(const QString &token, QVector<const SwJsonSchema*> &out, QString &forbidden) const
+    {
+        if (!m_cold || (!m_cold->unevaluatedPropertiesSchema && !m_cold->unevaluatedItemsSchema)) {
+            return;
+        }
+        const int index = SwJsonSchemaValidationState::arrayIndex(token);
+        const bool allowsArray = m_types == 0 || (m_types & typeBit(SchemaType::Array));
+        const bool allowsObject = m_types == 0 || (m_types & typeBit(SchemaType::Object));
+        const bool asArray = index >= 0 && cold().unevaluatedItemsSchema && allowsArray;
+        if (!asArray && !(cold().unevaluatedPropertiesSchema && allowsObject)) {
+            return;
+        }
+        QVector<const SwJsonSchema*> scope;
+        QSet<const SwJsonSchema*> seen;
+        QString error;
+        if (!expandApplicators(this, scope, seen, error)) {
+            return;
+        }
+        for (const SwJsonSchema *schema : scope) {
+            if (schema->m_cold && (!schema->m_cold->anyOf.isEmpty() || !schema->m_cold->oneOf.isEmpty()
+                                   || schema->m_cold->ifSchema)) {
+                return;
+            }
+            if (asArray ? schema->evaluatesItem(index) : schema->evaluatesProperty(token)) {
+                return;
+            }
+        }
+        const SwJsonSchema *unevaluated = asArray ? cold().unevaluatedItemsSchema.data()
+                                                  : cold().unevaluatedPropertiesSchema.data();
+        if (unevaluated->rejectsAll()) {
+            forbidden = asArray ? QString("Element [%1] non autorisé (unevaluatedItems=false).").arg(index)
+                                : QString("Propriété '%1' non autorisée (unevaluatedProperties=false).").arg(token);
+        } else if (!unevaluated->acceptsAll()) {
+            out << unevaluated;
+        }
+    }
+
+    /// Vrai si properties, patternProperties ou additionalProperties de ce noeud évaluent la propriété `key`.
+    bool evaluatesProperty(const QString &key) const
+    {
+        return m_properties.contains(key) || m_additionalPropertiesSchema || matchesAnyPattern(key);
+    }
+
+    /// Vrai si prefixItems, items, additionalItems ou contains de ce noeud peuvent évaluer l'élément `index`.
+    bool evaluatesItem(int index) const
+    {
+        return m_itemsSchema || index < m_prefixItemsSchemas.size()
+               || (m_cold && (m_cold->additionalItemsSchema || m_cold->containsSchema));
+    }
+
+    /// Sous-schémas de ce noeud s'appliquant à l'enfant `token` (propriété ou indice).
+    void collectChildSchemas(const QString &token, QVector<const SwJsonSchema*> &out, QString &forbidden) const
+    {
+        const int index = SwJsonSchemaValidationState::arrayIndex(token);
+        const bool hasArrayKeywords = m_itemsSchema || !m_prefixItemsSchemas.isEmpty() || cold().additionalItemsSchema;
+        // Tableau seulement, ou ambigu (aucun type / tableau et objet) : d'après le jeton
+        const bool maybeArray = m_types & typeBit(SchemaType::Array);
+        const bool maybeObject = m_types & typeBit(SchemaType::Object);
+        if ((maybeArray && !maybeObject) || (maybeArray == maybeObject && index >= 0 && hasArrayKeywords)) {
+            if (index < 0) {
+                return;
+            }
+            if (index < m_prefixItemsSchemas.size()) {
+                out << m_prefixItemsSchemas.at(index).data();
+            } else if (!m_prefixItemsSchemas.isEmpty() && cold().additionalItemsSchema) {
+                out << cold().additionalItemsSchema.data();
+            } else if (m_itemsSchema) {
+                out << m_itemsSchema.data();
+            }
+            return;
+        }
+        collectPropertySchemas(token, out, forbidden);
+    }
+
+    void collectPropertySchemas(const QString &token, QVector<const SwJsonSchema*> &out,
+                                QString &forbidden) const
+    {
+        bool declared = false;
+        auto property = m_properties.constFind(token);
+        if (property != m_properties.constEnd()) {
+            out << property.value().data();
+            declared = true;
+        }
+        int p = 0;
+        for (auto it = cold().patternProperties.cbegin(); it != cold().patternProperties.cend(); ++it, ++p) {
+            if (cold().patternPropertyRegexes.at(p).match(token)) {
+                out << it.value().data();
+                declared = true;
+            }
+        }
+        if (declared) {
+            return;
+        }
+        if (m_additionalPropertiesSchema && m_additionalPropertiesSchema->rejectsAll()) {
+            forbidden = QString("Propriété '%1' non autorisée (additionalProperties=false).").arg(token);
+        } else if (m_additionalPropertiesSchema && !m_additionalPropertiesSchema->acceptsAll()) {
+            out << m_additionalPropertiesSchema.data();
+        }
+    }
+
+    /// Forme textuelle canonique d'une valeur JSON (clés d'objet triées par QJsonObject).
+    static QByteArray canonicalJson(const QJsonValue &value)
+    {
+        return QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+    }
+
+    /**
+     * @brief Branches à évaluer d'après le discriminant.
+     * @return nullptr si toutes les branches doivent être évaluées (pas de discriminant,
+     *         instance non objet ou propriété absente), sinon la liste des candidates.
+     */
+    template <typename Value>
+    static const QVector<int> *discriminatedBranches(const Discriminator &discriminator, const Value &value)
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        if (discriminator.property.isEmpty() || Document::type(value) != QJsonValue::Object) {
+            return nullptr;
+        }
+        const typename Document::Object obj = Document::toObject(value);
+        auto it = Document::find(obj, discriminator.property);
+        if (it == Document::end(obj)) {
+            return nullptr;
+        }
+        auto bit = discriminator.branches.constFind(canonicalJson(Document::toJsonValue(Document::value(it))));
+        if (bit == discriminator.branches.constEnd()) {
+            static const QVector<int> none;
+            return &none;
+        }
+        return &bit.value();
+    }
+
+    /**
+     * @brief Calcule l'ordre historique et l'ordre par coût des mots-clés présents.
+     *
+     * Pour une conjonction évaluée en court-circuit, trier par coût / probabilité de
+     * rejet croissant minimise le coût moyen. Les sous-schémas sont déjà chargés :
+     * leur coût estimé est connu. Une référence $ref est comptée à coût fixe.
+     */
+    void buildEvaluationOrder()
+    {
+        m_steps.clear();
+        if (cold().ifSchema) m_steps << EvaluationStep::Conditional;
+        if (cold().notSchema) m_steps << EvaluationStep::Not;
+        if (!m_allOf.isEmpty()) m_steps << EvaluationStep::AllOf;
+        if (!cold().anyOf.isEmpty()) m_steps << EvaluationStep::AnyOf;
+        if (!cold().oneOf.isEmpty()) m_steps << EvaluationStep::OneOf;
+        if (!cold().enumValues.isEmpty()) m_steps << EvaluationStep::Enum;
+        if (!cold().constValue.isUndefined()) m_steps << EvaluationStep::Const;
+        if (m_types != 0) m_steps << EvaluationStep::Type;
+        m_steps << EvaluationStep::TypeSpecific;
+        if (!cold().internalCustomKeywordValidator.isEmpty()) m_steps << EvaluationStep::Custom;
+        if (cold().unevaluatedPropertiesSchema || cold().unevaluatedItemsSchema) m_steps << EvaluationStep::Unevaluated;
+
+        qint64 total = 0;
+        QVector<QPair<qint64, EvaluationStep>> ranked;
+        for (EvaluationStep step : m_steps) {
+            const qint64 cost = stepCost(step);
+            total += cost;
+            ranked.append(qMakePair(cost * 100 / stepSelectivity(step), step));
+        }
+        m_estimatedCost = isReference() ? 30 : clampCost(total);
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const QPair<qint64, EvaluationStep> &a, const QPair<qint64, EvaluationStep> &b) {
+                             return a.first < b.first;
+                         });
+
+        m_costOrderedSteps.clear();
+        for (const auto &r : ranked) {
+            m_costOrderedSteps << r.second;
+        }
+
+        // Dépendance : unevaluated* consomme les annotations de toutes les autres étapes.
+        if (m_costOrderedSteps.removeOne(EvaluationStep::Unevaluated)) {
+            m_costOrderedSteps << EvaluationStep::Unevaluated;
+        }
+    }
+
+    /// Plafond des coûts estimés : les facteurs 4 des tableaux imbriqués dépasseraient un int.
+    static constexpr qint64 maxEstimatedCost = 10000000;
+
+    static int clampCost(qint64 cost)
+    {
+        return int(qMin(cost, maxEstimatedCost));
+    }
+
+    /// Coût estimé d'un groupe de mots-clés (unité arbitraire, ~ une comparaison), plafonné.
+    qint64 stepCost(EvaluationStep step) const
+    {
+        return clampCost(rawStepCost(step));
+    }
+
+    qint64 rawStepCost(EvaluationStep step) const
+    {
+        switch (step) {
+        case EvaluationStep::Conditional:
+            return 5 + qint64(cold().ifSchema->m_estimatedCost)
+                   + qMax(cold().thenSchema ? cold().thenSchema->m_estimatedCost : 0,
+                          cold().elseSchema ? cold().elseSchema->m_estimatedCost : 0);
+        case EvaluationStep::Not:
+            return 5 + cold().notSchema->m_estimatedCost;
+        case EvaluationStep::AllOf:
+            return 5 + sumCost(m_allOf);
+        case EvaluationStep::AnyOf:
+            return 5 + (cold().anyOfDiscriminator.property.isEmpty() ? sumCost(cold().anyOf) : maxCost(cold().anyOf));
+        case EvaluationStep::OneOf:
+            return 5 + (cold().oneOfDiscriminator.property.isEmpty() ? sumCost(cold().oneOf) : maxCost(cold().oneOf));
+        case EvaluationStep::Enum:
+            return 1 + qint64(cold().enumValues.size());
+        case EvaluationStep::Const:
+            return 2;
+        case EvaluationStep::Type:
+            return 1;
+        case EvaluationStep::TypeSpecific: {
+            qint64 cost = 2;
+            if (cold().hasPattern) cost += 40;
+            if (!cold().format.isEmpty()) cost += 20;
+            cost += m_required.size() + cold().dependentRequired.size();
+            for (auto it = m_properties.cbegin(); it != m_properties.cend(); ++it) {
+                cost += 2 + it.value()->m_estimatedCost;
+            }
+            for (auto it = cold().patternProperties.cbegin(); it != cold().patternProperties.cend(); ++it) {
+                cost += 40 + it.value()->m_estimatedCost;
+            }
+            if (m_additionalPropertiesSchema) cost += 10 + m_additionalPropertiesSchema->m_estimatedCost;
+            if (m_uniqueItems) cost += 20;
+            // Tableaux : on suppose quelques éléments
+            if (m_itemsSchema) cost += 4 * qint64(m_itemsSchema->m_estimatedCost);
+            for (const QSharedPointer<SwJsonSchema> &prefix : m_prefixItemsSchemas) cost += prefix->m_estimatedCost;
+            if (cold().additionalItemsSchema) cost += 4 * qint64(cold().additionalItemsSchema->m_estimatedCost);
+            if (cold().containsSchema) cost += 4 * qint64(cold().containsSchema->m_estimatedCost);
+            if (m_recursiveSchema) cost += 30;
+            return cost;
+        }
+        case EvaluationStep::Custom:
+            return 20 * qint64(cold().internalCustomKeywordValidator.size());
+        case EvaluationStep::Unevaluated:
+            return 10 + (cold().unevaluatedPropertiesSchema ? 4 * qint64(cold().unevaluatedPropertiesSchema->m_estimatedCost) : 0)
+                      + (cold().unevaluatedItemsSchema ? 4 * qint64(cold().unevaluatedItemsSchema->m_estimatedCost) : 0);
+        }
+        return 1;
+    }
+
+    /// Probabilité de rejet estimée (en %) : plus un mot-clé rejette souvent, plus tôt il passe.
+    static int stepSelectivity(EvaluationStep step)
+    {
+        switch (step) {
+        case EvaluationStep::Const:        return 90;
+        case EvaluationStep::Enum:         return 80;
+        case EvaluationStep::Type:         return 50;
+        case EvaluationStep::Not:          return 50;
+        case EvaluationStep::TypeSpecific: return 40;
+        case EvaluationStep::AllOf:
+        case EvaluationStep::AnyOf:
+        case EvaluationStep::OneOf:        return 30;
+        case EvaluationStep::Conditional:  return 20;
+        case EvaluationStep::Custom:       return 30;
+        case EvaluationStep::Unevaluated:  return 30;
+        }
+        return 50;
+    }
+
+    static qint64 sumCost(const QList<QSharedPointer<SwJsonSchema>> &schemas)
+    {
+        qint64 cost = 0;
+        for (const QSharedPointer<SwJsonSchema> &schema : schemas) {
+            cost += schema->m_estimatedCost;
+        }
+        return cost;
+    }
+
+    static qint64 maxCost(const QList<QSharedPointer<SwJsonSchema>> &schemas)
+    {
+        qint64 cost = 0;
+        for (const QSharedPointer<SwJsonSchema> &schema : schemas) {
+            cost = qMax(cost, qint64(schema->m_estimatedCost));
+        }
+        return cost;
+    }
+
+    static QString stepName(EvaluationStep step)
+    {
+        switch (step) {
+        case EvaluationStep::Conditional:  return "if/then/else";
+        case EvaluationStep::Not:          return "not";
+        case EvaluationStep::AllOf:        return "allOf";
+        case EvaluationStep::AnyOf:        return "anyOf";
+        case EvaluationStep::OneOf:        return "oneOf";
+        case EvaluationStep::Enum:         return "enum";
+        case EvaluationStep::Const:        return "const";
+        case EvaluationStep::Type:         return "type";
+        case EvaluationStep::TypeSpecific: return "typeSpecific";
+        case EvaluationStep::Custom:       return "custom";
+        case EvaluationStep::Unevaluated:  return "unevaluated";
+        }
+        return QString();
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Validation (interne)
+    // -----------------------------------------------------------------------
+    static ValidationResult::Status resultStatus(bool ok, Interruption interruption)
+    {
+        switch (interruption) {
+        case Interruption::TimedOut:      return ValidationResult::TimedOut;
+        case Interruption::Canceled:      return ValidationResult::Canceled;
+        case Interruption::LimitExceeded: return ValidationResult::LimitExceeded;
+        default:                          return ok ? ValidationResult::Valid : ValidationResult::Invalid;
+        }
+    }
+
+    /// Cache de résultats applicable à une validation avec ces options (nul si aucun).
+    /// Un résultat calculé sans bornes ne dit pas si le document les respecte : une
+    /// validation avec ValidationOptions::limits ne passe pas par le cache.
+    SwJsonSchemaResultCache *resultCacheFor(const ValidationOptions &options) const
+    {
+        SwJsonSchemaResultCache *cache = cold().resultCache.data();
+        return (cache && !options.trace && !options.state && options.limits.isUnlimited()) ? cache : nullptr;
+    }
+
+    /**
+     * @brief Minorant de la taille de la forme canonique de `value`, décompté de `budget`.
+     * @return false dès que le budget est épuisé : le parcours s'arrête sans sérialiser.
+     */
+    static bool canonicalSizeWithin(const QJsonValue &value, qint64 &budget)
+    {
+        switch (value.type()) {
+        case QJsonValue::String:
+            budget -= value.toString().size() + 2;
+            break;
+        case QJsonValue::Array: {
+            const QJsonArray array = value.toArray();
+            budget -= 2 + qMax(0, int(array.size()) - 1);  // crochets et virgules
+            for (const QJsonValue &item : array) {
+                if (budget < 0 || !canonicalSizeWithin(item, budget)) {
+                    return false;
+                }
+            }
+            break;
+        }
+        case QJsonValue::Object: {
+            const QJsonObject obj = value.toObject();
+            budget -= 2 + qMax(0, int(obj.size()) - 1);
+            for (auto it = obj.begin(); it != obj.end(); ++it) {
+                budget -= it.key().size() + 3;  // "clé":
+                if (budget < 0 || !canonicalSizeWithin(it.value(), budget)) {
+                    return false;
+                }
+            }
+            break;
+        }
+        default:
+            budget -= 1;
+            break;
+        }
+        return budget >= 0;
+    }
+
+    /// Clé du cache de résultats : forme canonique d'une QJsonValue ; vide pour les autres
+    /// types et pour les documents dont la forme canonique dépasserait `maxBytes`.
+    static QByteArray resultCacheKey(const QJsonValue &value, int maxBytes)
+    {
+        qint64 budget = maxBytes;
+        if (!canonicalSizeWithin(value, budget)) {
+            return QByteArray();
+        }
+        return 'c' + canonicalJson(value);
+    }
+
+    template <typename Value>
+    static QByteArray resultCacheKey(const Value &, int)
+    {
+        return QByteArray();
+    }
+
+    /// Validation avec options, servie par le cache de résultats s'il est actif.
+    template <typename Value>
+    bool validateWithOptions(const Value &value, const ValidationOptions &options,
+                             QString *errorMessage, Interruption &interruption) const
+    {
+        SwJsonSchemaResultCache *cache = resultCacheFor(options);
+        if (Q_LIKELY(!cache)) {
+            return validateUncached(value, options, errorMessage, interruption);
+        }
+        const QByteArray key = resultCacheKey(value, cache->maxPayloadBytes());
+        if (key.isEmpty() || key.size() > cache->maxPayloadBytes()) {
+            return validateUncached(value, options, errorMessage, interruption);
+        }
+        bool ok = false;
+        if (cache->find(key, errorMessage, ok)) {
+            // Aucune évaluation : le cache de la validation n'a pas servi
+            if (options.memoStatistics) {
+                *options.memoStatistics = MemoStatistics();
+            }
+            return ok;
+        }
+        ok = validateUncached(value, options, errorMessage, interruption);
+        if (interruption == Interruption::None) {
+            cache->insert(key, ok, errorMessage);
+        }
+        return ok;
+    }
+
+    /// validateBytes() : la clé du cache est le document brut, lu seulement en son absence.
+    bool validateBytesWithOptions(const QByteArray &json, const ValidationOptions &options,
+                                  QString *errorMessage, Interruption &interruption) const
+    {
+        SwJsonSchemaResultCache *cache = resultCacheFor(options);
+        QByteArray key;
+        bool ok = false;
+        if (cache && json.size() < cache->maxPayloadBytes()) {
+            key = 'r' + json;
+            if (cache->find(key, errorMessage, ok)) {
+                if (options.memoStatistics) {
+                    *options.memoStatistics = MemoStatistics();
+                }
+                return ok;
+            }
+        }
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            ok = setError(errorMessage, QString("JSON invalide (position %1) : %2")
+                                            .arg(parseError.offset).arg(parseError.errorString()));
+        } else {
+            const QJsonValue value = document.isArray() ? QJsonValue(document.array()) : QJsonValue(document.object());
+            ok = validateUncached(value, options, errorMessage, interruption);
+        }
+        if (!key.isEmpty() && interruption == Interruption::None) {
+            cache->insert(key, ok, errorMessage);
+        }
+        return ok;
+    }
+
+    /// Validation avec options : trace, cache, état conservé, échéance et annulation.
+    template <typename Value>
+    bool validateUncached(const Value &value, const ValidationOptions &options,
+                          QString *errorMessage, Interruption &interruption) const
+    {
+        QSet<const SwJsonSchema*> visited;
+        ValidationContext ctx;
+        SwJsonSchemaValidationState localMemo;
+        SwJsonSchemaValidationState *memo = options.state ? options.state : &localMemo;
+        if (options.state) {
+            options.state->clear();
+            options.state->m_schema = this;
+            options.state->m_document = SwJsonSchemaDocument<Value>::toJsonValue(value);
+            options.state->m_indexed = true;
+        }
+        ctx.trace = options.trace;
+        ctx.memo = (options.memoize || options.state) ? memo : nullptr;
+        ctx.trackInstancePath = (options.trace != nullptr) || ctx.memo;
+        ctx.deadline = options.deadline;
+        ctx.cancelToken = options.cancelToken;
+        ctx.limits = options.limits.isUnlimited() ? nullptr : &options.limits;
+        ctx.interruptible = !options.deadline.isForever() || options.cancelToken || ctx.limits;
+        bool ok = validateInternal(value, visited, ctx, errorMessage);
+        interruption = ctx.interruption;
+        if (interruption != Interruption::None) {
+            // Le résultat ne dit rien du document : rien n'est conservé pour revalidate()
+            if (options.state) {
+                options.state->clear();
+            }
+            ok = false;
+            setError(errorMessage, interruptionMessage(ctx));
+        }
+        memo->m_valid = ok;
+        if (options.memoStatistics) {
+            options.memoStatistics->hits = memo->m_hits;
+            options.memoStatistics->misses = memo->m_misses;
+            options.memoStatistics->entries = quint64(memo->m_entries.size());
+        }
+        return ok;
+    }
+
+    template <typename Value>
+    bool validateInternal(const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        // Schéma booléen : résultat constant, sans cache, trace ni profilage
+        if (m_constant != Constant::None) {
+            return acceptsAll() || setError(errorMessage, falseSchemaError());
+        }
+        if (Q_UNLIKELY(ctx.nodeInterrupted())) {
+            return interruptionError(ctx, errorMessage);
+        }
+        // Un résultat mémorisé ne restitue pas les annotations : pas de cache quand elles sont collectées.
+        if (Q_UNLIKELY(ctx.memo) && !ctx.evaluated) {
+            return validateMemoized(value, visited, ctx, errorMessage);
+        }
+        return evaluate(value, visited, ctx, errorMessage);
+    }
+
+    /**
+     * @brief Évaluation via le cache de la validation en cours.
+     *
+     * La position dans l'instance identifie la valeur : au sein d'une validation, un même
+     * JSON Pointer désigne toujours la même valeur. Un résultat obtenu en traversant une
+     * détection de récursion dépend du chemin parcouru : il n'est pas mémorisé.
+     */
+    template <typename Value>
+    bool validateMemoized(const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        const SwJsonSchemaValidationState::Key key(this, ctx.instancePointer());
+        auto it = ctx.memo->m_entries.constFind(key);
+        if (it != ctx.memo->m_entries.constEnd()
+            && (it.value().valid || !errorMessage || it.value().hasError)) {
+            ++ctx.memo->m_hits;
+            if (!it.value().valid) {
+                return setError(errorMessage, it.value().error);
+            }
+            return true;
+        }
+
+        ++ctx.memo->m_misses;
+        const int recursionHits = ctx.recursionHits;
+        bool ok = evaluate(value, visited, ctx, errorMessage);
+        // Un résultat interrompu ne dit rien de l'instance : il n'est pas mémorisé
+        if (ctx.recursionHits == recursionHits && ctx.interruption == Interruption::None) {
+            SwJsonSchemaValidationState::Entry entry;
+            entry.valid = ok;
+            entry.hasError = (errorMessage != nullptr);
+            if (!ok && errorMessage) {
+                entry.error = *errorMessage;
+            }
+            ctx.memo->insert(key, entry);
+        }
+        return ok;
+    }
+
+    template <typename Value>
+    bool evaluate(const Value &value,
+                  QSet<const SwJsonSchema*> &visited,
+                  ValidationContext &ctx,
+                  QString *errorMessage) const
+    {
+        if (Q_LIKELY(!ctx.trace && !SwJsonSchemaProfiler::isEnabled())) {
+            return validateNode(value, visited, ctx, errorMessage);
+        }
+        return validateInstrumented(value, visited, ctx, errorMessage);
+    }
+
+    // Évaluation tracée et/ou profilée
+    template <typename Value>
+    bool validateInstrumented(const Value &value,
+                              QSet<const SwJsonSchema*> &visited,
+                              ValidationContext &ctx,
+                              QString *errorMessage) const
+    {
+        int traceIndex = -1;
+        if (ctx.trace) {
+            traceIndex = ctx.trace->begin(m_baseUri + m_keywordLocation, ctx.instancePointer());
+        }
+        bool ok = SwJsonSchemaProfiler::isEnabled()
+                      ? validateProfiled(value, visited, ctx, errorMessage)
+                      : validateNode(value, visited, ctx, errorMessage);
+        if (traceIndex >= 0) {
+            ctx.trace->end(traceIndex, ok);
+        }
+        return ok;
+    }
+
+    // Évaluation instrumentée : compteurs et temps (propre / cumulé) du noeud
+    template <typename Value>
+    bool validateProfiled(const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        SwJsonSchemaProfileEntry *entry = profileEntry();
+        SwJsonSchemaProfileEntry *&current = SwJsonSchemaProfiler::currentEntry();
+        quint64 &childNs = SwJsonSchemaProfiler::childNs();
+        SwJsonSchemaProfileEntry *previousEntry = current;
+        quint64 previousChildNs = childNs;
+        current = entry;
+        childNs = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = validateNode(value, visited, ctx, errorMessage);
+        quint64 elapsed = quint64(timer.nsecsElapsed());
+
+        entry->invocations.fetchAndAddRelaxed(1);
+        if (!ok) {
+            entry->failures.fetchAndAddRelaxed(1);
+        }
+        entry->totalNs.fetchAndAddRelaxed(elapsed);
+        entry->selfNs.fetchAndAddRelaxed(elapsed > childNs ? elapsed - childNs : 0);
+
+        current = previousEntry;
+        childNs = previousChildNs + elapsed;
+        return ok;
+    }
+
+    SwJsonSchemaProfileEntry *profileEntry() const
+    {
+        SwJsonSchemaProfileEntry *entry = m_profileEntry.loadAcquire();
+        if (!entry) {
+            entry = SwJsonSchemaProfiler::instance().entry(m_baseUri + m_keywordLocation);
+            m_profileEntry.storeRelease(entry);
+        }
+        return entry;
+    }
+
+    template <typename Value>
+    bool validateNode(const Value &value,
+                      QSet<const SwJsonSchema*> &visited,
+                      ValidationContext &ctx,
+                      QString *errorMessage) const
+    {
+        if (visited.contains(this)) {
+            ++ctx.recursionHits;
+            return setError(errorMessage, "Récursion de schémas détectée.");
+        }
+        // "visited" ne contient que le chemin courant : deux branches sœurs (allOf, $ref
+        // en losange) peuvent évaluer le même noeud sans être prises pour une récursion.
+        VisitedScope visitedScope(visited, this);
+
+        // Gérer $ref
+        if (isReference()) {
+            const SwJsonSchema *refSchema = resolveReference();
+            if (!refSchema) {
+                return setError(errorMessage,
+                                QString("Impossible de résoudre la référence '%1'.").arg(m_dollarRef));
+            }
+            return refSchema->validateInternal(value, visited, ctx, errorMessage);
+        }
+
+        // Sans message d'erreur attendu, seule la validité compte : ordre par coût estimé.
+        const QVector<EvaluationStep> &steps = errorMessage ? m_steps : m_costOrderedSteps;
+        // Type de l'instance calculé une fois pour toutes les étapes du noeud
+        const SchemaType type = instanceType(value);
+        if (Q_UNLIKELY(collectsAnnotations(value))) {
+            return evaluateStepsAnnotated(steps, value, type, visited, ctx, errorMessage);
+        }
+        for (EvaluationStep step : steps) {
+            if (!evaluateStep(step, value, type, visited, ctx, errorMessage)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Ce noeud porte unevaluatedProperties / unevaluatedItems applicable à la valeur.
+    template <typename Value>
+    bool collectsAnnotations(const Value &value) const
+    {
+        const QJsonValue::Type type = SwJsonSchemaDocument<Value>::type(value);
+        return (cold().unevaluatedPropertiesSchema && type == QJsonValue::Object)
+               || (cold().unevaluatedItemsSchema && type == QJsonValue::Array);
+    }
+
+    /**
+     * @brief Évalue les mots-clés en collectant les propriétés / éléments évalués.
+     *
+     * Un bit par propriété (rang dans l'objet) ou par élément. Les sous-schémas appliqués
+     * à la même instance (allOf, $ref, then/else) écrivent dans ce même tableau ; les
+     * branches dont l'échec n'invalide pas le noeud (anyOf, oneOf, if) écrivent dans une
+     * copie fusionnée en cas de succès (validateIsolated). En cas de succès, le résultat
+     * est fusionné dans le tableau du noeud englobant s'il en collecte un.
+     */
+    template <typename Value>
+    bool evaluateStepsAnnotated(const QVector<EvaluationStep> &steps,
+                                const Value &value,
+                                SchemaType type,
+                                QSet<const SwJsonSchema*> &visited,
+                                ValidationContext &ctx,
+                                QString *errorMessage) const
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        QBitArray *outer = ctx.evaluated;
+        QBitArray evaluated(Document::type(value) == QJsonValue::Object ? Document::size(Document::toObject(value))
+                                                                         : Document::size(Document::toArray(value)));
+        ctx.evaluated = &evaluated;
+        bool ok = true;
+        for (EvaluationStep step : steps) {
+            if (!evaluateStep(step, value, type, visited, ctx, errorMessage)) {
+                ok = false;
+                break;
+            }
+        }
+        ctx.evaluated = outer;
+        if (ok && outer) {
+            *outer |= evaluated;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Évalue un sous-schéma appliqué à la même instance dont l'échec n'invalide pas
+     *        ce noeud (branche anyOf / oneOf, if) : ses annotations ne sont retenues qu'en
+     *        cas de succès.
+     */
+    template <typename Value>
+    bool validateIsolated(const SwJsonSchema &schema,
+                          const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        if (Q_LIKELY(!ctx.evaluated)) {
+            return schema.validateInternal(value, visited, ctx, errorMessage);
+        }
+        QBitArray *outer = ctx.evaluated;
+        QBitArray branch(outer->size());
+        ctx.evaluated = &branch;
+        bool ok = schema.validateInternal(value, visited, ctx, errorMessage);
+        ctx.evaluated = outer;
+        if (ok) {
+            *outer |= branch;
+        }
+        return ok;
+    }
+
+    template <typename Value>
+    bool evaluateStep(EvaluationStep step,
+                      const Value &value,
+                      SchemaType type,
+                      QSet<const SwJsonSchema*> &visited,
+                      ValidationContext &ctx,
+                      QString *errorMessage) const
+    {
+        switch (step) {
+        case EvaluationStep::Conditional:
+            return applyConditional(value, visited, ctx, errorMessage);
+
+        case EvaluationStep::Not: {
+            // Les annotations produites sous "not" ne sont jamais retenues
+            QBitArray *outer = ctx.evaluated;
+            ctx.evaluated = nullptr;
+            bool satisfied = cold().notSchema->validateInternal(value, visited, ctx, nullptr);
+            ctx.evaluated = outer;
+            if (satisfied) {
+                return setError(errorMessage, "Le schéma 'not' est satisfait, ce qui est interdit.");
+            }
+            return true;
+        }
+
+        case EvaluationStep::AllOf:
+            return checkAllOf(value, visited, ctx, errorMessage);
+        case EvaluationStep::AnyOf:
+            return checkAnyOf(value, visited, ctx, errorMessage);
+        case EvaluationStep::OneOf:
+            return checkOneOf(value, visited, ctx, errorMessage);
+
+        case EvaluationStep::Enum: {
+            const QJsonValue &json = SwJsonSchemaDocument<Value>::toJsonValue(value);
+            for (auto &ev : cold().enumValues) {
+                if (ev == json) {
+                    return true;
+                }
+            }
+            return setError(errorMessage, "Valeur non listée dans 'enum'.");
+        }
+
+        case EvaluationStep::Const:
+            if (cold().constValue != SwJsonSchemaDocument<Value>::toJsonValue(value)) {
+                return setError(errorMessage, "Valeur différente de 'const'.");
+            }
+            return true;
+
+        case EvaluationStep::Type:
+            if (!(m_types & typeBit(type))) {
+                return setError(errorMessage,
+                                QString("Type invalide. Attendu: %1, reçu: %2")
+                                    .arg(toString(m_types))
+                                    .arg(type == SchemaType::Invalid ? QString("undefined") : toString(type)));
+            }
+            return true;
+
+        case EvaluationStep::TypeSpecific: {
+            // Validation détaillée, seulement pour un type admis (sinon l'étape Type échoue)
+            if (m_types != 0 && !(m_types & typeBit(type))) {
+                return true;
+            }
+
+            switch (type) {
+            case SchemaType::String:
+                return validateString(value, ctx, errorMessage);
+            case SchemaType::Number:
+            case SchemaType::Integer:
+                return validateNumber(value, errorMessage);
+            case SchemaType::Object:
+                return validateObject(value, ctx, errorMessage);
+            case SchemaType::Array:
+                return validateArray(value, ctx, errorMessage);
+            case SchemaType::Boolean:
+            case SchemaType::Null:
+            case SchemaType::Invalid:
+            default:
+                // rien de spécial
+                return true;
+            }
+        }
+
+        case EvaluationStep::Custom: {
+            const QJsonValue &json = SwJsonSchemaDocument<Value>::toJsonValue(value);
+            for (const KeywordJsonValidator &customValidator : cold().internalCustomKeywordValidator) {
+                QString localErr;
+                if (!customValidator.validate(json, &localErr)) {
+                    return setError(errorMessage, QString("Validation failed with error: %1").arg(localErr));
+                }
+            }
+            return true;
+        }
+
+        case EvaluationStep::Unevaluated:
+            return checkUnevaluated(value, visited, ctx, errorMessage);
+        }
+        return true;
+    }
+
+    // -- if/then/else, allOf, anyOf, oneOf --
+    template <typename Value>
+    bool applyConditional(const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        if (!cold().ifSchema) {
+            return true;
+        }
+        TraceSpan span(ctx, this, "if/then/else");
+        // si ifSchema satisfait
+        if (validateIsolated(*cold().ifSchema, value, visited, ctx, nullptr)) {
+            // then
+            if (cold().thenSchema && !cold().thenSchema->validateInternal(value, visited, ctx, errorMessage)) {
+                return span.done(false);
+            }
+        } else {
+            // else
+            if (cold().elseSchema && !cold().elseSchema->validateInternal(value, visited, ctx, errorMessage)) {
+                return span.done(false);
+            }
+        }
+        return true;
+    }
+
+    template <typename Value>
+    bool checkAllOf(const Value &value,
+                    QSet<const SwJsonSchema*> &visited,
+                    ValidationContext &ctx,
+                    QString *errorMessage) const
+    {
+        if (m_allOf.isEmpty()) return true;
+        TraceSpan span(ctx, this, "allOf");
+        for (int i = 0; i < m_allOf.size(); ++i) {
+            if (!m_allOf[i]->validateInternal(value, visited, ctx, errorMessage)) {
+                return span.done(setError(errorMessage, QString("Echec de allOf[%1]. %2")
+                                              .arg(i)
+                                              .arg(errorMessage ? *errorMessage : "")));
+            }
+        }
+        return true;
+    }
+
+    template <typename Value>
+    bool checkAnyOf(const Value &value,
+                    QSet<const SwJsonSchema*> &visited,
+                    ValidationContext &ctx,
+                    QString *errorMessage) const
+    {
+        if (cold().anyOf.isEmpty()) return true;
+        TraceSpan span(ctx, this, "anyOf");
+        const QVector<int> *candidates = discriminatedBranches(cold().anyOfDiscriminator, value);
+        const int count = candidates ? int(candidates->size()) : int(cold().anyOf.size());
+        bool matched = false;
+        for (int c = 0; c < count; ++c) {
+            const int i = candidates ? candidates->at(c) : c;
+            QString localErr;
+            if (validateIsolated(*cold().anyOf[i], value, visited, ctx, errorMessage ? &localErr : nullptr)) {
+                // au moins un match => OK ; si des annotations sont collectées, toutes les
+                // branches satisfaites y contribuent : on poursuit l'évaluation.
+                matched = true;
+                if (!ctx.evaluated) {
+                    return true;
+                }
+            }
+        }
+        if (matched) {
+            return true;
+        }
+        return span.done(setError(errorMessage, "Aucun schéma dans 'anyOf' n'est satisfait."));
+    }
+
+    template <typename Value>
+    bool checkOneOf(const Value &value,
+                    QSet<const SwJsonSchema*> &visited,
+                    ValidationContext &ctx,
+                    QString *errorMessage) const
+    {
+        if (cold().oneOf.isEmpty()) return true;
+        TraceSpan span(ctx, this, "oneOf");
+        int countValid = 0;
+        QString lastError;
+        const QVector<int> *candidates = discriminatedBranches(cold().oneOfDiscriminator, value);
+        if (candidates && candidates->isEmpty()) {
+            lastError = QString("Valeur de '%1' ne correspondant à aucune branche.").arg(cold().oneOfDiscriminator.property);
+        }
+        const int count = candidates ? int(candidates->size()) : int(cold().oneOf.size());
+        for (int c = 0; c < count; ++c) {
+            const int i = candidates ? candidates->at(c) : c;
+            QString localErr;
+            if (validateIsolated(*cold().oneOf[i], value, visited, ctx, errorMessage ? &localErr : nullptr)) {
+                countValid++;
+                if (countValid > 1) {
+                    return span.done(setError(errorMessage, "Plus d'un schéma dans 'oneOf' est satisfait."));
+                }
+            } else {
+                lastError = localErr;
+            }
+        }
+        if (countValid == 1) {
+            return true;
+        } else {
+            return span.done(setError(errorMessage,
+                                      QString("Aucun schéma dans 'oneOf' n'est satisfait. Dernière erreur: %1").arg(lastError)));
+        }
+    }
+
+    // -- validations de type --
+    template <typename Value>
+    bool validateString(const Value &value, ValidationContext &ctx, QString *errorMessage) const
+    {
+        QString str = SwJsonSchemaDocument<Value>::toString(value);
+        if (m_minLength >= 0 && str.size() < m_minLength) {
+            return setError(errorMessage, QString("Longueur trop petite: %1 < %2").arg(str.size()).arg(m_minLength));
+        }
+        if (m_maxLength >= 0 && str.size() > m_maxLength) {
+            return setError(errorMessage, QString("Longueur trop grande: %1 > %2").arg(str.size()).arg(m_maxLength));
+        }
+        if (cold().hasPattern) {
+            if (ctx.patternInputTooLong(str.size(), "pattern")) {
+                return interruptionError(ctx, errorMessage);
+            }
+            if (!cold().patternRegex.match(str)) {
+                return setError(errorMessage, QString("Ne correspond pas au pattern: %1").arg(cold().pattern));
+            }
+        }
+        if (!cold().format.isEmpty()) {
+            if (isRegexFormat(cold().format) && ctx.patternInputTooLong(str.size(), "format")) {
+                return interruptionError(ctx, errorMessage);
+            }
+            if (!checkFormat(str, cold().format, errorMessage)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Value>
+    bool validateNumber(const Value &value, QString *errorMessage) const
+    {
+        double d = SwJsonSchemaDocument<Value>::toDouble(value);
+        if (cold().hasMultipleOf && !qFuzzyIsNull(cold().multipleOf)) {
+            double ratio = d / cold().multipleOf;
+            double frac = ratio - qFloor(ratio);
+            double eps = 1e-12;
+            if (qAbs(frac) > eps && qAbs(frac - 1.0) > eps) {
+                return setError(errorMessage, QString("%1 n'est pas multiple de %2").arg(d).arg(cold().multipleOf));
+            }
+        }
+        if (m_hasMinimum) {
+            if (m_exclusiveMinimum) {
+                if (!(d > m_minimum)) {
+                    return setError(errorMessage, QString("Doit être > %1 (exclusiveMinimum)").arg(m_minimum));
+                }
+            } else {
+                if (d < m_minimum) {
+                    return setError(errorMessage, QString("Doit être >= %1").arg(m_minimum));
+                }
+            }
+        }
+        if (m_hasMaximum) {
+            if (m_exclusiveMaximum) {
+                if (!(d < m_maximum)) {
+                    return setError(errorMessage, QString("Doit être < %1 (exclusiveMaximum)").arg(m_maximum));
+                }
+            } else {
+                if (d > m_maximum) {
+                    return setError(errorMessage, QString("Doit être <= %1").arg(m_maximum));
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Value>
+    bool validateObject(const Value &value,
+                        ValidationContext &ctx,
+                        QString *errorMessage) const
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        if (Document::type(value) != QJsonValue::Object) {
+            return setError(errorMessage, "La valeur n'est pas un objet.");
+        }
+        const typename Document::Object obj = Document::toObject(value);
+        // Propriétés évaluées de cette instance (nul si aucun unevaluatedProperties ne les attend)
+        QBitArray *evaluated = ctx.evaluated;
+        if (Q_UNLIKELY(ctx.limits) && ctx.limits->maxObjectProperties >= 0 && Document::size(obj) > ctx.limits->maxObjectProperties) {
+            ctx.exceed(QString("objet de %1 propriétés (maximum %2)").arg(Document::size(obj)).arg(ctx.limits->maxObjectProperties));
+            return interruptionError(ctx, errorMessage);
+        }
+
+        // required
+        for (auto &req : m_required) {
+            if (!Document::contains(obj, req)) {
+                return setError(errorMessage, QString("La propriété requise '%1' est manquante.").arg(req));
+            }
+        }
+
+        // dependentRequired
+        for (auto it = cold().dependentRequired.begin(); it != cold().dependentRequired.end(); ++it) {
+            if (Document::contains(obj, it.key())) {
+                for (auto &dep : it.value()) {
+                    if (!Document::contains(obj, dep)) {
+                        return setError(errorMessage,
+                                        QString("La propriété '%1' est requise car '%2' est présent.")
+                                            .arg(dep)
+                                            .arg(it.key()));
+                    }
+                }
+            }
+        }
+
+        // Chaque descente dans l'instance repart d'un ensemble "visited" vide : la valeur
+        // évaluée change, un cycle de références ne peut donc pas boucler indéfiniment.
+
+        // properties
+        if (evaluated) markEvaluatedProperties<Value>(m_properties, obj, evaluated);
+        for (auto it = m_properties.begin(); it != m_properties.end(); ++it) {
+            auto found = Document::find(obj, it.key());
+            if (found != Document::end(obj)) {
+                if (Q_UNLIKELY(ctx.interrupted())) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                if (it.value()->acceptsAll()) {
+                    continue;
+                }
+                InstancePathScope path(ctx, it.key());
+                QString localErr;
+                QSet<const SwJsonSchema*> childVisited;
+                if (!it.value()->validateInternal(Document::value(found), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                    return setError(errorMessage,
+                                    QString("Propriété '%1' invalide: %2").arg(it.key()).arg(localErr));
+                }
+            }
+        }
+
+        // patternProperties
+        if (!validatePatternProperties<Value>(this, obj, ctx, errorMessage)) {
+            return false;
+        }
+
+        // additionalProperties
+        if (!validateAdditionalProperties<Value>(this, obj, ctx, errorMessage)) {
+            return false;
+        }
+
+        if (m_recursiveSchema) {
+            // Le schéma racine est réutilisé tel quel : ses noeuds gardent une adresse stable
+            // (clé du cache de résultats).
+            const SwJsonSchema *root = m_recursiveSchema;
+            // properties
+            if (evaluated) markEvaluatedProperties<Value>(root->m_properties, obj, evaluated);
+            for (auto it = root->m_properties.begin(); it != root->m_properties.end(); ++it) {
+                auto found = Document::find(obj, it.key());
+                if (found != Document::end(obj)) {
+                    if (it.value()->acceptsAll()) {
+                        continue;
+                    }
+                    InstancePathScope path(ctx, it.key());
+                    QString localErr;
+                    QSet<const SwJsonSchema*> childVisited;
+                    if (!it.value()->validateInternal(Document::value(found), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                        return setError(errorMessage,
+                                        QString("Propriété '%1' invalide: %2").arg(it.key()).arg(localErr));
+                    }
+                }
+            }
+
+            if (!validatePatternProperties<Value>(root, obj, ctx, errorMessage)) {
+                return false;
+            }
+            if (!validateAdditionalProperties<Value>(root, obj, ctx, errorMessage)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// patternProperties de `owner` : chaque motif est essayé sur chaque propriété de l'objet.
+    template <typename Value>
+    static bool validatePatternProperties(const SwJsonSchema *owner,
+                                          const typename SwJsonSchemaDocument<Value>::Object &obj,
+                                          ValidationContext &ctx,
+                                          QString *errorMessage)
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        const ColdKeywords &keywords = owner->cold();
+        QBitArray *evaluated = ctx.evaluated;
+        int p = 0;
+        for (auto pit = keywords.patternProperties.begin(); pit != keywords.patternProperties.end(); ++pit, ++p) {
+            const SwJsonSchemaRegex &re = keywords.patternPropertyRegexes.at(p);
+            int rank = 0;
+            for (auto it = Document::begin(obj); it != Document::end(obj); ++it, ++rank) {
+                if (Q_UNLIKELY(ctx.interrupted())) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                const QString key = Document::key(it);
+                if (ctx.patternInputTooLong(key.size(), "patternProperties")) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                if (re.match(key)) {
+                    if (evaluated) evaluated->setBit(rank);
+                    if (pit.value()->acceptsAll()) {
+                        continue;
+                    }
+                    InstancePathScope path(ctx, key);
+                    QString localErr;
+                    QSet<const SwJsonSchema*> childVisited;
+                    if (!pit.value()->validateInternal(Document::value(it), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                        return setError(errorMessage,
+                                        QString("Propriété '%1' invalide (patternProperties / %2): %3")
+                                            .arg(key)
+                                            .arg(pit.key())
+                                            .arg(localErr));
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Annotations de "properties" : marque le rang de chaque propriété déclarée.
+     *
+     * Un seul parcours de l'objet, rang tenu au fil de l'eau : retrouver le rang d'une
+     * propriété depuis son itérateur serait linéaire pour un QVariantMap.
+     */
+    template <typename Value>
+    static void markEvaluatedProperties(const QMap<QString, QSharedPointer<SwJsonSchema>> &properties,
+                                        const typename SwJsonSchemaDocument<Value>::Object &obj,
+                                        QBitArray *evaluated)
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        if (properties.isEmpty()) {
+            return;
+        }
+        int rank = 0;
+        for (auto it = Document::begin(obj); it != Document::end(obj); ++it, ++rank) {
+            if (properties.contains(Document::key(it))) {
+                evaluated->setBit(rank);
+            }
+        }
+    }
+
+    /**
+     * @brief additionalProperties de `owner` : propriétés absentes de ses "properties" et
+     *        "patternProperties" (les annotations d'autres sous-schémas ne comptent pas).
+     */
+    template <typename Value>
+    static bool validateAdditionalProperties(const SwJsonSchema *owner,
+                                             const typename SwJsonSchemaDocument<Value>::Object &obj,
+                                             ValidationContext &ctx,
+                                             QString *errorMessage)
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        const SwJsonSchema *additional = owner->m_additionalPropertiesSchema.data();
+        QBitArray *evaluated = ctx.evaluated;
+        // true : rien à valider, seules les annotations sont à produire
+        if (!additional || (additional->acceptsAll() && !evaluated)) {
+            return true;
+        }
+        int rank = 0;
+        for (auto it = Document::begin(obj); it != Document::end(obj); ++it, ++rank) {
+            if (Q_UNLIKELY(ctx.interrupted())) {
+                return interruptionError(ctx, errorMessage);
+            }
+            const QString key = Document::key(it);
+            if (owner->m_properties.contains(key)) {
+                continue;
+            }
+            if (!owner->cold().patternPropertyRegexes.isEmpty()
+                && ctx.patternInputTooLong(key.size(), "patternProperties")) {
+                return interruptionError(ctx, errorMessage);
+            }
+            if (owner->matchesAnyPattern(key)) {
+                continue;
+            }
+            if (additional->rejectsAll()) {
+                // on refuse toute propriété non listée
+                return setError(errorMessage,
+                                QString("Propriété '%1' non autorisée (additionalProperties=false).")
+                                    .arg(key));
+            }
+            if (evaluated) evaluated->setBit(rank);
+            if (additional->acceptsAll()) {
+                continue;
+            }
+            InstancePathScope path(ctx, key);
+            QString localErr;
+            QSet<const SwJsonSchema*> childVisited;
+            if (!additional->validateInternal(Document::value(it), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                return setError(errorMessage,
+                                QString("Propriété '%1' invalide (additionalProperties): %2")
+                                    .arg(key)
+                                    .arg(localErr));
+            }
+        }
+        return true;
+    }
+
+    template <typename Value>
+    bool validateArray(const Value &value,
+                       ValidationContext &ctx,
+                       QString *errorMessage) const
+    {
+        using Document = SwJsonSchemaDocument<Value>;
+        if (Document::type(value) != QJsonValue::Array) {
+            return setError(errorMessage, "La valeur n'est pas un tableau (array).");
+        }
+        const typename Document::Array arr = Document::toArray(value);
+        const int size = Document::size(arr);
+        // Éléments évalués de cette instance (nul si aucun unevaluatedItems ne les attend)
+        QBitArray *evaluated = ctx.evaluated;
+        if (Q_UNLIKELY(ctx.limits) && ctx.limits->maxArrayItems >= 0 && size > ctx.limits->maxArrayItems) {
+            ctx.exceed(QString("tableau de %1 éléments (maximum %2)").arg(size).arg(ctx.limits->maxArrayItems));
+            return interruptionError(ctx, errorMessage);
+        }
+
+        if (m_minItems >= 0 && size < m_minItems) {
+            return setError(errorMessage,
+                            QString("Trop peu d'éléments: %1 < %2").arg(size).arg(m_minItems));
+        }
+        if (m_maxItems >= 0 && size > m_maxItems) {
+            return setError(errorMessage,
+                            QString("Trop d'éléments: %1 > %2").arg(size).arg(m_maxItems));
+        }
+        if (m_uniqueItems) {
+            for (int i = 0; i < size; ++i) {
+                for (int j = i + 1; j < size; ++j) {
+                    if (Q_UNLIKELY(ctx.interrupted())) {
+                        return interruptionError(ctx, errorMessage);
+                    }
+                    if (Document::toJsonValue(Document::at(arr, i)) == Document::toJsonValue(Document::at(arr, j))) {
+                        return setError(errorMessage, "Doublon trouvé alors que uniqueItems=true.");
+                    }
+                }
+            }
+        }
+
+        // prefixItems (2020-12) ou items sous forme de tableau (draft-07)
+        // (descente dans l'instance : "visited" repart à vide)
+        int i = 0;
+        for (; i < size && i < m_prefixItemsSchemas.size(); ++i) {
+            if (Q_UNLIKELY(ctx.interrupted())) {
+                return interruptionError(ctx, errorMessage);
+            }
+            if (evaluated) evaluated->setBit(i);
+            InstancePathScope path(ctx, i);
+            QString localErr;
+            QSet<const SwJsonSchema*> childVisited;
+            if (!m_prefixItemsSchemas[i]->validateInternal(Document::at(arr, i), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                return setError(errorMessage,
+                                QString("Element [%1] invalide (prefixItems): %2").arg(i).arg(localErr));
+            }
+        }
+
+        // Éléments suivants : additionalItems (draft-07) ou items (tous, ou au-delà de prefixItems en 2020-12).
+        // Sans schéma, on accepte (draft 2019-09).
+        const SwJsonSchema *restSchema = m_itemsSchema.data();
+        QString restLabel;
+        if (!m_prefixItemsSchemas.isEmpty() && cold().additionalItemsSchema) {
+            restSchema = cold().additionalItemsSchema.data();
+            restLabel = " (additionalItems)";
+        }
+        if (restSchema && restSchema->rejectsAll()) {
+            // false : simple contrôle de longueur
+            if (i < size) {
+                return setError(errorMessage,
+                                QString("Element [%1] invalide%2: %3").arg(i).arg(restLabel).arg(falseSchemaError()));
+            }
+        } else if (restSchema && restSchema->acceptsAll()) {
+            // true : rien à valider
+            if (evaluated) evaluated->fill(true, i, qMax(i, size));
+        } else if (restSchema) {
+            for (; i < size; ++i) {
+                if (Q_UNLIKELY(ctx.interrupted())) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                if (evaluated) evaluated->setBit(i);
+                InstancePathScope path(ctx, i);
+                QString localErr;
+                QSet<const SwJsonSchema*> childVisited;
+                if (!restSchema->validateInternal(Document::at(arr, i), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                    return setError(errorMessage,
+                                    QString("Element [%1] invalide%2: %3").arg(i).arg(restLabel).arg(localErr));
+                }
+            }
+        }
+
+        // contains
+        if (cold().containsSchema) {
+            int count = 0;
+            if (cold().containsSchema->m_constant != Constant::None) {
+                // true : tous les éléments correspondent ; false : aucun
+                if (cold().containsSchema->acceptsAll()) {
+                    count = size;
+                    if (evaluated) evaluated->fill(true);
+                }
+            } else {
+                for (int i = 0; i < size; ++i) {
+                    if (Q_UNLIKELY(ctx.interrupted())) {
+                        return interruptionError(ctx, errorMessage);
+                    }
+                    InstancePathScope path(ctx, i);
+                    QSet<const SwJsonSchema*> childVisited;
+                    if (cold().containsSchema->validateInternal(Document::at(arr, i), childVisited, ctx, nullptr)) {
+                        count++;
+                        if (evaluated) evaluated->setBit(i);
+                    }
+                }
+            }
+            if (cold().minContains >= 0 && count < cold().minContains) {
+                return setError(errorMessage,
+                                QString("Pas assez d'éléments correspondant à 'contains': %1 < %2.")
+                                    .arg(count).arg(cold().minContains));
+            }
+            if (cold().maxContains >= 0 && count > cold().maxContains) {
+                return setError(errorMessage,
+                                QString("Trop d'éléments correspondant à 'contains': %1 > %2.")
+                                    .arg(count).arg(cold().maxContains));
+            }
+            if (cold().minContains < 0 && cold().maxContains < 0 && count == 0) {
+                return setError(errorMessage, "Aucun élément ne satisfait 'contains'.");
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief unevaluatedProperties / unevaluatedItems : s'applique à ce qui n'a été évalué
+     *        ni par ce noeud ni par ses sous-schémas satisfaits appliqués à la même instance.
+     *        Évalué en dernier ; en cas de succès, tout est marqué évalué.
+     */
+    template <typename Value>
+    bool checkUnevaluated(const Value &value,
+                          QSet<const SwJsonSchema*> &visited,
+                          ValidationContext &ctx,
+                          QString *errorMessage) const
+    {
+        Q_UNUSED(visited);
+        using Document = SwJsonSchemaDocument<Value>;
+        QBitArray *evaluated = ctx.evaluated;
+        if (!evaluated || !collectsAnnotations(value)) {
+            return true;
+        }
+        const bool isObject = Document::type(value) == QJsonValue::Object;
+        const SwJsonSchema *unevaluated = isObject ? cold().unevaluatedPropertiesSchema.data()
+                                                   : cold().unevaluatedItemsSchema.data();
+        if (unevaluated->acceptsAll()) {
+            evaluated->fill(true);
+            return true;
+        }
+
+        if (isObject) {
+            const typename Document::Object obj = Document::toObject(value);
+            int rank = 0;
+            for (auto it = Document::begin(obj); it != Document::end(obj); ++it, ++rank) {
+                if (Q_UNLIKELY(ctx.interrupted())) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                if (evaluated->testBit(rank)) {
+                    continue;
+                }
+                const QString key = Document::key(it);
+                if (cold().unevaluatedPropertiesSchema->rejectsAll()) {
+                    return setError(errorMessage,
+                                    QString("Propriété '%1' non autorisée (unevaluatedProperties=false).")
+                                        .arg(key));
+                }
+                if (!cold().unevaluatedPropertiesSchema->acceptsAll()) {
+                    InstancePathScope path(ctx, key);
+                    QString localErr;
+                    QSet<const SwJsonSchema*> childVisited;
+                    if (!cold().unevaluatedPropertiesSchema->validateInternal(Document::value(it), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                        return setError(errorMessage,
+                                        QString("Propriété '%1' invalide (unevaluatedProperties): %2")
+                                            .arg(key)
+                                            .arg(localErr));
+                    }
+                }
+            }
+        } else {
+            const typename Document::Array arr = Document::toArray(value);
+            const int size = Document::size(arr);
+            for (int i = 0; i < size; ++i) {
+                if (Q_UNLIKELY(ctx.interrupted())) {
+                    return interruptionError(ctx, errorMessage);
+                }
+                if (evaluated->testBit(i)) {
+                    continue;
+                }
+                if (cold().unevaluatedItemsSchema->rejectsAll()) {
+                    return setError(errorMessage,
+                                    QString("Element [%1] non autorisé (unevaluatedItems=false).").arg(i));
+                }
+                if (!cold().unevaluatedItemsSchema->acceptsAll()) {
+                    InstancePathScope path(ctx, i);
+                    QString localErr;
+                    QSet<const SwJsonSchema*> childVisited;
+                    if (!cold().unevaluatedItemsSchema->validateInternal(Document::at(arr, i), childVisited, ctx, errorMessage ? &localErr : nullptr)) {
+                        return setError(errorMessage,
+                                        QString("Element [%1] invalide (unevaluatedItems): %2").arg(i).arg(localErr));
+                    }
+                }
+            }
+        }
+        evaluated->fill(true);
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    //                Outils
+    // -----------------------------------------------------------------------
+    bool matchesAnyPattern(const QString &propertyName) const
+    {
+        for (const SwJsonSchemaRegex &re : cold().patternPropertyRegexes) {
+            if (re.match(propertyName)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // -----------------------------------------------------------------
+    //             Outils annexes
+    // -----------------------------------------------------------------
+    void copyFrom(const SwJsonSchema &other)
+    {
+        // On ne copie pas le registry => dépend du design
+        // (on pourrait le recopier, ou le passer en paramètre)
+        m_baseUri = other.m_baseUri;
+        m_dollarRef = other.m_dollarRef;
+        m_keywordLocation = other.m_keywordLocation;
+        m_profileEntry.storeRelease(other.m_profileEntry.loadAcquire());
+        // Le cache de validateAt() désigne les noeuds de l'ancien contenu
+        delete m_pathCache.fetchAndStoreOrdered(nullptr);
+
+        m_constant = other.m_constant;
+        m_types = other.m_types;
+
+        m_minimum = other.m_minimum;
+        m_maximum = other.m_maximum;
+        m_exclusiveMinimum = other.m_exclusiveMinimum;
+        m_exclusiveMaximum = other.m_exclusiveMaximum;
+        m_hasMinimum = other.m_hasMinimum;
+        m_hasMaximum = other.m_hasMaximum;
+
+        m_minLength = other.m_minLength;
+        m_maxLength = other.m_maxLength;
+
+        m_minItems = other.m_minItems;
+        m_maxItems = other.m_maxItems;
+        m_uniqueItems = other.m_uniqueItems;
+
+        // Sous-schémas et mots-clés rares partagés : un noeud chargé n'est plus modifié
+        // (les conteneurs Qt et m_cold se détachent à la première écriture)
+        m_itemsSchema = other.m_itemsSchema;
+        m_prefixItemsSchemas = other.m_prefixItemsSchemas;
+        m_properties = other.m_properties;
+        m_additionalPropertiesSchema = other.m_additionalPropertiesSchema;
+        m_required = other.m_required;
+        m_allOf = other.m_allOf;
+        m_cold = other.m_cold;
+
+        m_isValide = other.m_isValide;
+        m_parent = other.m_parent;
+        m_registryContext = other.m_registryContext;
+        m_recursiveSchema = other.m_recursiveSchema;
+        m_steps = other.m_steps;
+        m_costOrderedSteps = other.m_costOrderedSteps;
+        m_estimatedCost = other.m_estimatedCost;
+    }
+
+    void deduceTypeFromConstraints()
+    {
+        bool mightBeString = (m_minLength >= 0 || m_maxLength >= 0 || cold().hasPattern || !cold().format.isEmpty());
+        bool mightBeNumber = (m_hasMinimum || m_hasMaximum || cold().hasMultipleOf);
+        bool mightBeObject = (!m_properties.isEmpty() || !cold().patternProperties.isEmpty()
+                              || !m_required.isEmpty()
+                              || m_additionalPropertiesSchema);
+        bool mightBeArray  = (!m_prefixItemsSchemas.isEmpty() || m_itemsSchema
+                             || (m_minItems >= 0) || (m_maxItems >= 0));
+
+        int count = 0;
+        if (mightBeString)  count++;
+        if (mightBeNumber)  count++;
+        if (mightBeObject)  count++;
+        if (mightBeArray)   count++;
+
+        if (count == 1) {
+            if (mightBeString) m_types = typeBit(SchemaType::String);
+            else if (mightBeNumber) m_types = typeBit(SchemaType::Number) | typeBit(SchemaType::Integer);
+            else if (mightBeObject) m_types = typeBit(SchemaType::Object);
+            else if (mightBeArray)  m_types = typeBit(SchemaType::Array);
+        }
+    }
+
+    /// Formats vérifiés par une expression régulière (soumis à ValidationLimits::maxPatternLength).
+    static bool isRegexFormat(const QString &formatName)
+    {
+        static const QSet<QString> formats = {
+            "email", "date-time", "date", "time", "hostname", "ipv4", "ipv6",
+            "uri", "uuid", "phone", "credit-card"
+        };
+        return formats.contains(formatName);
+    }
+
+    static bool checkFormat(const QString &value, const QString &formatName, QString *errorMessage)
+    {
+        // Implémentez ici la logique pour "email", "date-time", etc.
+        // Ex en simplifié :
+        // -- "email" --
+        if (formatName == "email") {
+            static const SwJsonSchemaRegex emailRe(
+                R"(^[a-zA-Z0-9._%+\-]+@[a-zA-Z0-9.\-]+\.[a-zA-Z]{2,}$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!emailRe.match(value)) {
+                return setError(errorMessage, "Le format email est invalide.");
+            }
+
+            // -- "date-time" (RFC3339 simplifié) --
+        } else if (formatName == "date-time") {
+            static const SwJsonSchemaRegex dateTimeRe(
+                R"(^(?<year>\d{4})-(?<month>\d{2})-(?<day>\d{2})T(?<hour>\d{2}):(?<min>\d{2}):(?<sec>\d{2})(\.\d+)?(Z|[+\-]\d{2}:\d{2})$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!dateTimeRe.match(value)) {
+                return setError(errorMessage, "Le format date-time (RFC3339) est invalide.");
+            }
+
+            // -- "date" (YYYY-MM-DD) --
+        } else if (formatName == "date") {
+            static const SwJsonSchemaRegex dateRe(
+                R"(^(?<year>\d{4})-(?<month>\d{2})-(?<day>\d{2})$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!dateRe.match(value)) {
+                return setError(errorMessage, "Le format date (YYYY-MM-DD) est invalide.");
+            }
+
+            // -- "time" (hh:mm:ss(.fraction)?(Z|±hh:mm)?) --
+        } else if (formatName == "time") {
+            static const SwJsonSchemaRegex timeRe(
+                R"(^(?<hour>\d{2}):(?<min>\d{2})(:(?<sec>\d{2})(\.\d+)?)?(Z|[+\-]\d{2}:\d{2})?$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!timeRe.match(value)) {
+                return setError(errorMessage, "Le format time est invalide.");
+            }
+
+            // -- "hostname" (RFC1123 simplifié) --
+        } else if (formatName == "hostname") {
+            // La longueur totale (1 à 253) est vérifiée à part : pas d'assertion avant en linéaire
+            static const SwJsonSchemaRegex hostnameRe(
+                R"(^([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?)(\.([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?))*$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (value.isEmpty() || value.size() > 253 || !hostnameRe.match(value)) {
+                return setError(errorMessage, "Le format hostname est invalide.");
+            }
+
+            // -- "ipv4" --
+        } else if (formatName == "ipv4") {
+            static const SwJsonSchemaRegex ipv4Re(
+                R"(^(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
+                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
+                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
+                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!ipv4Re.match(value)) {
+                return setError(errorMessage, "Le format IPv4 est invalide.");
+            }
+
+            // -- "ipv6" (simplifié, incluant '::') --
+        } else if (formatName == "ipv6") {
+            // Version simplifiée. Pour un check complet, se fier à QHostAddress ou RFC 4291.
+            static const SwJsonSchemaRegex ipv6Re(
+                // Ce pattern essaie de capturer divers cas "compressés" via '::'.
+                R"((^(([0-9A-Fa-f]{1,4}:){7}([0-9A-Fa-f]{1,4}|:))|)"
+                R"(^(::([0-9A-Fa-f]{1,4}:){0,5}((([0-9A-Fa-f]{1,4}))|:))$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!ipv6Re.match(value)) {
+                return setError(errorMessage, "Le format IPv6 est invalide.");
+            }
+
+            // -- "uri" (simplifié) --
+        } else if (formatName == "uri") {
+            // On peut aussi faire `QUrl url(value); if (!url.isValid()) ...`
+            // Pour un check plus élaboré sur tous les aspects d'une URI (RFC 3986).
+            static const SwJsonSchemaRegex uriRe(
+                R"(^[A-Za-z][A-Za-z0-9+\-.]*:)"
+                R"(\/\/?([^\s/]+)(\/\S*)?$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!uriRe.match(value)) {
+                return setError(errorMessage, "Le format URI est invalide.");
+            }
+
+            // -- "uuid" (RFC 4122 version 4 / standard) --
+        } else if (formatName == "uuid") {
+            // Forme : 8-4-4-4-12 hexadécimal
+            static const SwJsonSchemaRegex uuidRe(
+                R"(^[0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12}$)",
+                SwJsonSchemaRegex::Linear
+                );
+            if (!uuidRe.match(value)) {
+                return setError(errorMessage, "Le format uuid est invalide.");
+            }
+
+            // -- "phone" (exemple très général) --
+        } else if (formatName == "phone") {
+            // Ici on autorise : +, (), espace, tiret, chiffres, etc.
+            // À affiner selon le plan de numérotation international, etc.
+            static const SwJsonSchemaRegex phoneRe(
+                R"(^[+\-()0-9\s]+$)",  // très permissif
+                SwJsonSchemaRegex::Linear
+                );
+            if (!phoneRe.match(value)) {
+                return setError(errorMessage, "Le format phone est invalide.");
+            }
+
+            // -- "credit-card" : check via Regex + Luhn --
+        } else if (formatName == "credit-card") {
+            // Regex simple : 13 à 19 chiffres
+            static const SwJsonSchemaRegex ccRe(R"(^\d{13,19}$)", SwJsonSchemaRegex::Linear);
+            if (!ccRe.match(value)) {
+                return setError(errorMessage, "Le format credit-card est invalide (doit être 13-19 chiffres).");
+            }
+            // Vérification Luhn
+            if (!luhnCheck(value)) {
+                return setError(errorMessage, "Le numéro de carte de crédit n'est pas valide (Luhn).");
+            }
+        }
+        return true;
+    }
+
+    static bool luhnCheck(const QString &ccNumberInput)
+    {
+        QString ccNumber = ccNumberInput;
+        ccNumber.remove(' ');
+        ccNumber.remove('-');
+        static const SwJsonSchemaRegex reDigits("^[0-9]+$", SwJsonSchemaRegex::Linear);
+        if (!reDigits.match(ccNumber)) {
+            return false;
+        }
+        if (ccNumber.size() < 13 || ccNumber.size() > 19) {
+            return false;
+        }
+
+        int sum = 0;
+        bool alternate = false;
+        for (int i = ccNumber.size() - 1; i >= 0; --i) {
+            int n = ccNumber.at(i).digitValue();
+            if (alternate) {
+                n *= 2;
+                if (n > 9) {
+                    n = (n % 10) + 1;
+                }
+            }
+            sum += n;
+            alternate = !alternate;
+        }
+        return (sum % 10) == 0;
+    }
+
+    static bool setError(QString *errorMessage, const QString &msg)
+    {
+        if (errorMessage) {
+            *errorMessage = msg;
+        }
+        return false;
+    }
+
+    static QString toString(SchemaType t)
+    {
+        switch (t) {
+        case SchemaType::String:  return "string";
+        case SchemaType::Number:  return "number";
+        case SchemaType::Integer: return "integer";
+        case SchemaType::Boolean: return "boolean";
+        case SchemaType::Object:  return "object";
+        case SchemaType::Array:   return "array";
+        case SchemaType::Null:    return "null";
+        default:                  return "invalid";
+        }
+    }
+
+    /// Types d'un masque, dans l'ordre de SchemaType ("integer" omis s'il vient de "number").
+    static QString toString(TypeMask types)
+    {
+        QStringList names;
+        for (int t = int(SchemaType::String); t <= int(SchemaType::Null); ++t) {
+            const SchemaType type = SchemaType(t);
+            if (!(types & typeBit(type))) {
+                continue;
+            }
+            if (type == SchemaType::Integer && (types & typeBit(SchemaType::Number))) {
+                continue;
+            }
+            names << toString(type);
+        }
+        return names.isEmpty() ? toString(SchemaType::Invalid) : names.join(", ");
+    }
+
+    static QString toString(const QJsonValue &v)
+    {
+        if (v.isString())  return "string";
+        if (v.isBool())    return "boolean";
+        if (v.isObject())  return "object";
+        if (v.isArray())   return "array";
+        if (v.isNull())    return "null";
+        if (v.isDouble()) {
+            double value = v.toDouble();
+            if (std::floor(value) == value) {
+                return "integer";
+            }
+            return "number";
+        }
+        return "undefined";
+    }
+
+
+    static SchemaType parseTypeName(const QJsonValue &val)
+    {
+        if (!val.isString()) {
+            return SchemaType::Invalid;
+        }
+        QString typeStr = val.toString().toLower().trimmed();
+        if (typeStr == "string")  return SchemaType::String;
+        if (typeStr == "number")  return SchemaType::Number;
+        if (typeStr == "integer")  return SchemaType::Integer;
+        if (typeStr == "boolean") return SchemaType::Boolean;
+        if (typeStr == "object")  return SchemaType::Object;
+        if (typeStr == "array")   return SchemaType::Array;
+        if (typeStr == "null")    return SchemaType::Null;
+        return SchemaType::Invalid;
+    }
+
+    /// "type" sous forme de nom ou de tableau de noms ; les noms inconnus sont ignorés.
+    static TypeMask parseType(const QJsonValue &val)
+    {
+        QJsonArray names = val.isArray() ? val.toArray() : QJsonArray{val};
+        TypeMask types = 0;
+        for (const QJsonValue &name : names) {
+            SchemaType type = parseTypeName(name);
+            types |= typeBit(type);
+            if (type == SchemaType::Number) {
+                types |= typeBit(SchemaType::Integer);
+            }
+        }
+        return types;
+    }
+
+    inline QString resolveUri(const SwJsonSchema *parent, const QString &id)
+    {
+        if (!parent || parent->m_baseUri.isEmpty()) {
+            return id.trimmed();
+        }
+
+        QUrl baseUrl(parent->m_baseUri);
+
+        QUrl relativeUrl(id.trimmed());
+
+        QUrl resolved = baseUrl.resolved(relativeUrl);
+
+        return resolved.toString();
+    }
+
+    /// Lit et compile le document `schemaPath` (constructeurs par chemin).
+    void loadFile(const QString &schemaPath)
+    {
+        if (m_parent) {
+            m_baseUri = resolveUri(m_parent, schemaPath);
+        }
+        // Tente d’ouvrir le fichier local
+        // (si vous gérez des URLs http(s), adapter ici)
+        QUrl url(schemaPath);
+        QString localFile = url.isLocalFile() ? url.toLocalFile() : schemaPath;
+
+        QFile f(localFile);
+        if (!f.open(QIODevice::ReadOnly)) {
+            // Erreur : on pourrait stocker un message d’erreur ou laisser un schéma "vide".
+            return;
+        }
+
+        QByteArray data = f.readAll();
+        f.close();
+
+        QJsonParseError jerr;
+        QJsonDocument doc = QJsonDocument::fromJson(data, &jerr);
+        if (jerr.error != QJsonParseError::NoError) {
+            // Erreur de parsing JSON
+            return;
+        }
+        if (!doc.isObject()) {
+            // Pas un objet JSON => schéma invalide
+            return;
+        }
+        QJsonObject rootObj = doc.object();
+        m_isValide = !rootObj.isEmpty();
+        if(m_isValide){
+            loadSchema(rootObj, m_parent);
+            rejectUnsupportedPatterns();
+        }
+    }
+
+    /**
+     * @brief Contexte des registres, fixé à la construction : celui du parent, sinon (racine)
+     *        le contexte donné, sinon un contexte propre, partagé par ses copies.
+     *
+     * Retenu par chaque noeud : les sous-schémas rangés par valeur sont des copies, leur
+     * chaîne de parents ne vaut que pendant le chargement.
+     */
+    void initRegistryContext(SwJsonSchemaContext *context)
+    {
+        if (m_parent) {
+            m_registryContext = m_parent->m_registryContext;
+        } else if (context) {
+            m_registryContext = context;
+        } else {
+            ColdKeywords &cold = mutableCold();
+            cold.ownedContext.reset(new SwJsonSchemaContext);
+            m_registryContext = cold.ownedContext.data();
+        }
+    }
+
+    SwJsonSchemaContext *registryContext() const
+    {
+        return m_registryContext ? m_registryContext : &SwJsonSchemaContext::global();
+    }
+
+    SwJsonSchemaRegistry *getRegistry(const QString &baseUri) const
+    {
+        return registryContext()->registry(baseUri);
+    }
+
+    SwJsonSchema *parent() const {
+        return m_parent;
+    }
+
+    /**
+     * @brief JSON Pointer d'un sous-schéma, relatif à ce noeud (ex: "#/properties/age").
+     */
+    QString childLocation(const QString &keyword, const QString &token = QString()) const
+    {
+        QString location = m_keywordLocation + "/" + escapePointerToken(keyword);
+        if (!token.isNull()) {
+            location += "/" + escapePointerToken(token);
+        }
+        return location;
+    }
+
+    static QString escapePointerToken(QString token)
+    {
+        token.replace("~", "~0");
+        token.replace("/", "~1");
+        return token;
+    }
+
+    SwJsonSchema *findMainSchema() {
+        SwJsonSchema *seeked = this;
+        while(seeked->parent()){
+            seeked = seeked->parent();
+        }
+        return seeked;
+    }
+
+    static QMap<QString, Validator>& getCustomKeywordRegistry() {
+        static QMap<QString, Validator> customKeywordRegistry;
+        return customKeywordRegistry;
+    }
+
+    static QAtomicInt &regexEngineSetting()
+    {
+        static QAtomicInt engine(int(RegexEngine::Backtracking));
+        return engine;
+    }
+
+    /**
+     * @brief Compile un motif avec le moteur choisi. Un motif hors du sous-ensemble linéaire
+     *        est signalé au schéma racine (unsupportedPatterns()).
+     */
+    SwJsonSchemaRegex compileRegex(const QString &pattern, const QString &location)
+    {
+        const RegexEngine engine = loadSettings().regexEngine;
+        if (engine == RegexEngine::Backtracking) {
+            return SwJsonSchemaRegex(pattern, SwJsonSchemaRegex::Backtracking);
+        }
+        SwJsonSchemaRegex regex(pattern, SwJsonSchemaRegex::Linear);
+        if (regex.isValid()) {
+            return regex;
+        }
+        SwJsonSchema *root = this;
+        while (root->m_parent) {
+            root = root->m_parent;
+        }
+        root->mutableCold().unsupportedPatterns << QString("%1%2 : /%3/ : %4").arg(m_baseUri, location, pattern, regex.errorString());
+        if (engine == RegexEngine::LinearWithFallback) {
+            return SwJsonSchemaRegex(pattern, SwJsonSchemaRegex::Backtracking);
+        }
+        return regex;
+    }
+
+private:
+    static QAtomicInt &liveInstanceCount()
+    {
+        static QAtomicInt count(0);
+        return count;
+    }
+
+    /// Compté à la construction de chaque noeud (copies comprises), décompté à sa destruction.
+    struct InstanceCounter {
+        InstanceCounter() { liveInstanceCount().ref(); }
+        InstanceCounter(const InstanceCounter &) { liveInstanceCount().ref(); }
+        InstanceCounter &operator=(const InstanceCounter &) { return *this; }
+        ~InstanceCounter() { liveInstanceCount().deref(); }
+    };
+
+    // -----------------------------------------------------------------------
+    //                      Données membres
+    // -----------------------------------------------------------------------
+    // Partie fixe : mots-clés présents dans la plupart des noeuds, lus à chaque validation
+    QString m_baseUri;
+    QString m_dollarRef;
+
+    // Localisation du noeud (JSON Pointer) et compteurs de profilage associés
+    QString m_keywordLocation;
+    mutable QAtomicPointer<SwJsonSchemaProfileEntry> m_profileEntry;
+
+    Constant    m_constant       = Constant::None;  ///< Schéma booléen (noeud partagé)
+    TypeMask    m_types          = 0;  ///< Types admis (typeBit), 0 = non contraint
+    bool        m_isValide       = false;
+    InstanceCounter m_instanceCounter;  ///< liveInstances()
+
+    // Numérique
+    double m_minimum             = 0.0;
+    double m_maximum             = 0.0;
+    bool   m_exclusiveMinimum    = false;
+    bool   m_exclusiveMaximum    = false;
+    bool   m_hasMinimum          = false;
+    bool   m_hasMaximum          = false;
+
+    // String
+    int     m_minLength          = -1;
+    int     m_maxLength          = -1;
+
+    // Array
+    int     m_minItems           = -1;
+    int     m_maxItems           = -1;
+    bool    m_uniqueItems        = false;
+    QSharedPointer<SwJsonSchema> m_itemsSchema;
+    QList<QSharedPointer<SwJsonSchema>> m_prefixItemsSchemas;
+    SwJsonSchema *m_recursiveSchema = nullptr;
+
+    // Object
+    QMap<QString, QSharedPointer<SwJsonSchema>> m_properties;
+    QSharedPointer<SwJsonSchema> m_additionalPropertiesSchema;
+    QSet<QString>                m_required;
+
+    QList<QSharedPointer<SwJsonSchema>> m_allOf;
+
+    /**
+     * @brief Mots-clés rares, alloués au premier utilisé (la plupart des noeuds n'en ont aucun).
+     *        Lecture : cold() (instance vide partagée si absent) ; écriture : mutableCold().
+     *        Partagés entre les copies d'un noeud, détachés à la première écriture.
+     */
+    struct ColdKeywords : public QSharedData {
+        QString dollarSchema;
+        QString dollarAnchor;
+        QList<QJsonValue> enumValues;
+        QJsonValue constValue = QJsonValue(QJsonValue::Undefined);
+
+        double multipleOf = 0.0;
+        bool   hasMultipleOf = false;
+
+        QString pattern;
+        SwJsonSchemaRegex patternRegex;
+        bool    hasPattern = false;
+        QString format;
+
+        QSharedPointer<SwJsonSchema> additionalItemsSchema;
+        QSharedPointer<SwJsonSchema> containsSchema;
+        int minContains = -1;
+        int maxContains = -1;
+
+        QMap<QString, QSharedPointer<SwJsonSchema>> patternProperties;
+        QVector<SwJsonSchemaRegex>   patternPropertyRegexes;  ///< Motifs de patternProperties compilés, même ordre
+        QMap<QString, QStringList>   dependentRequired;
+
+        // unevaluatedProperties / unevaluatedItems : non nul = annotations à collecter
+        QSharedPointer<SwJsonSchema> unevaluatedPropertiesSchema;
+        QSharedPointer<SwJsonSchema> unevaluatedItemsSchema;
+
+        QList<QSharedPointer<SwJsonSchema>> anyOf;
+        QList<QSharedPointer<SwJsonSchema>> oneOf;
+        Discriminator oneOfDiscriminator;
+        Discriminator anyOfDiscriminator;
+        QSharedPointer<SwJsonSchema> notSchema;
+
+        QSharedPointer<SwJsonSchema> ifSchema;
+        QSharedPointer<SwJsonSchema> thenSchema;
+        QSharedPointer<SwJsonSchema> elseSchema;
+
+        QList<KeywordJsonValidator> internalCustomKeywordValidator;
+        QStringList unsupportedPatterns;  ///< Racine : motifs hors du moteur linéaire (unsupportedPatterns())
+        QSharedPointer<SwJsonSchemaResultCache> resultCache;  ///< setResultCache(), nul = désactivé
+        QSharedPointer<SwJsonSchemaContext> ownedContext;         ///< Racine construite sans contexte : son contexte propre
+    };
+    QSharedDataPointer<ColdKeywords> m_cold;
+
+    const ColdKeywords &cold() const
+    {
+        static const ColdKeywords empty;
+        return m_cold ? *m_cold : empty;
+    }
+
+    ColdKeywords &mutableCold()
+    {
+        if (!m_cold) {
+            m_cold = new ColdKeywords;
+        }
+        return *m_cold;
+    }
+
+    // Cache de navigation de validateAt(), alloué à son premier appel (nul pour les autres noeuds)
+    mutable QAtomicPointer<PathCache> m_pathCache;
+
+    SwJsonSchema *m_parent;
+    SwJsonSchemaContext *m_registryContext = nullptr;  // Nul (noeuds true / false partagés) = contexte global
+
+    // Ordre d'évaluation : historique (avec message d'erreur) et par coût (validité seule)
+    QVector<EvaluationStep> m_steps;
+    QVector<EvaluationStep> m_costOrderedSteps;
+    int m_estimatedCost = 1;
+};
+
+
+inline SwJsonSchemaContext::~SwJsonSchemaContext()
+{
+    // Les registres ne font que référencer les noeuds : ceux détenus sont libérés à part
+    qDeleteAll(m_nodes);
+    qDeleteAll(m_registries);
+    if (!m_global) {
+        liveCount(true).fetchAndAddRelaxed(-m_nodes.size());
+        liveCount(false).fetchAndAddRelaxed(-m_registries.size());
+    }
+}
+
+
+/**
+ * @brief Chargement parallèle d'un ensemble de schémas répartis sur plusieurs fichiers.
+ *
+ * Trois phases :
+ *  - découverte : à partir des racines, chaque vague de fichiers est lue et analysée en
+ *    parallèle ; les $ref externes trouvées forment la vague suivante ;
+ *  - compilation : chaque document est compilé une seule fois, en parallèle, sans charger
+ *    ses $ref externes (elles sont notées) ;
+ *  - liaison : sur le thread appelant, les $ref notées sont enregistrées vers les documents
+ *    compilés, puis les motifs non supportés remontent à chaque racine.
+ *
+ * Un document référencé par plusieurs autres (ou par un cycle) n'est lu et compilé qu'une
+ * fois. Les schémas rendus par schema() appartiennent au chargeur : il doit leur survivre.
+ * Une $ref que la découverte n'a pas vue est chargée comme avant, à la compilation.
+ *
+ * Les registres ($id, $anchor, $ref) des documents chargés sont ceux d'un
+ * SwJsonSchemaContext propre au chargeur : deux chargeurs ne se voient pas, et détruire
+ * le chargeur libère ses documents, leurs registres et les définitions compilées.
+ */
+class SwJsonSchemaLoader
+{
+public:
+    /// Durées (ns) et volumes du dernier load()
+    struct Statistics {
+        int    documents = 0;
+        int    links = 0;
+        qint64 discoverNs = 0;
+        qint64 compileNs = 0;
+        qint64 linkNs = 0;
+    };
+
+    /// `pool` : QThreadPool::globalInstance() par défaut
+    explicit SwJsonSchemaLoader(QThreadPool *pool = nullptr)
+        : m_pool(pool)
+    {
     }
 
-    bool validateNumber(const QJsonValue &value, QString *errorMessage) const
+    SwJsonSchemaLoader(const SwJsonSchemaLoader &) = delete;
+    SwJsonSchemaLoader &operator=(const SwJsonSchemaLoader &) = delete;
+
+    /**
+     * @brief Charge `rootPaths` et tous les fichiers qu'ils référencent.
+     * @return true si toutes les racines sont des schémas valides (détail dans errors()).
+     */
+    bool load(const QStringList &rootPaths)
     {
-        if(!checkType(value)){
-            return setError(errorMessage, QString("Value %1 is not a type double").arg(value.toString()));
+        m_statistics = Statistics();
+        m_errors.clear();
+        QElapsedTimer timer;
+        timer.start();
+
+        // 1) Découverte, vague par vague
+        QStringList wave;
+        for (const QString &path : rootPaths) {
+            wave << addDocument(path);
         }
-        double d = value.toDouble();
-        if (m_hasMultipleOf && !qFuzzyIsNull(m_multipleOf)) {
-            double ratio = d / m_multipleOf;
-            double frac = ratio - qFloor(ratio);
-            double eps = 1e-12;
-            if (qAbs(frac) > eps && qAbs(frac - 1.0) > eps) {
-                return setError(errorMessage, QString("%1 n'est pas multiple de %2").arg(d).arg(m_multipleOf));
+        wave.removeAll(QString());
+        while (!wave.isEmpty()) {
+            QVector<QSharedPointer<Document>> documents;
+            for (const QString &key : wave) {
+                documents << m_documents.at(m_index.value(key));
             }
-        }
-        if (m_hasMinimum) {
-            if (m_exclusiveMinimum) {
-                if (!(d > m_minimum)) {
-                    return setError(errorMessage, QString("Doit être > %1 (exclusiveMinimum)").arg(m_minimum));
-                }
-            } else {
-                if (d < m_minimum) {
-                    return setError(errorMessage, QString("Doit être >= %1").arg(m_minimum));
+            forEach(documents, [](const QSharedPointer<Document> &document) {
+                readDocument(*document);
+            });
+            wave.clear();
+            for (const QSharedPointer<Document> &document : documents) {
+                for (const QString &reference : document->references) {
+                    wave << addDocument(reference);
                 }
             }
+            wave.removeAll(QString());
         }
-        if (m_hasMaximum) {
-            if (m_exclusiveMaximum) {
-                if (!(d < m_maximum)) {
-                    return setError(errorMessage, QString("Doit être < %1 (exclusiveMaximum)").arg(m_maximum));
-                }
-            } else {
-                if (d > m_maximum) {
-                    return setError(errorMessage, QString("Doit être <= %1").arg(m_maximum));
-                }
+        m_statistics.discoverNs = timer.nsecsElapsed();
+
+        // 2) Compilation des documents lus
+        QHash<QString, bool> validity;
+        QVector<QSharedPointer<Document>> pending;
+        for (const QSharedPointer<Document> &document : m_documents) {
+            validity.insert(document->key, document->valid);
+            if (document->valid && !document->schema) {
+                pending << document;
             }
         }
-        return true;
-    }
-
-    bool validateObject(const QJsonValue &value,
-                        QSet<const SwJsonSchema*> &visited,
-                        QString *errorMessage) const
-    {
-        if (!value.isObject()) {
-            return setError(errorMessage, "La valeur n'est pas un objet.");
-        }
-        QJsonObject obj = value.toObject();
-
-        // required
-        for (auto &req : m_required) {
-            if (!obj.contains(req)) {
-                return setError(errorMessage, QString("La propriété requise '%1' est manquante.").arg(req));
+        timer.restart();
+        forEach(pending, [this, &validity](const QSharedPointer<Document> &document) {
+            SwJsonSchema::LoadContext context;
+            context.documents = &validity;
+            context.registries = &m_context;
+            document->schema.reset(new SwJsonSchema(document->path, document->object, &context));
+            document->links = context.links;
+            document->object = QJsonObject();
+        });
+        m_statistics.compileNs = timer.nsecsElapsed();
+
+        // 3) Liaison (registres du chargeur, un seul thread)
+        timer.restart();
+        for (const QSharedPointer<Document> &document : pending) {
+            for (const SwJsonSchema::DeferredLink &link : document->links) {
+                SwJsonSchema *target = m_documents.at(m_index.value(link.target))->schema.data();
+                m_context.registry(link.registryBase)->registerSchemaByRef(link.refPath, target);
+                ++m_statistics.links;
             }
         }
-
-        // dependentRequired
-        for (auto it = m_dependentRequired.begin(); it != m_dependentRequired.end(); ++it) {
-            if (obj.contains(it.key())) {
-                for (auto &dep : it.value()) {
-                    if (!obj.contains(dep)) {
-                        return setError(errorMessage,
-                                        QString("La propriété '%1' est requise car '%2' est présent.")
-                                            .arg(dep)
-                                            .arg(it.key()));
-                    }
-                }
+        bool ok = true;
+        for (const QString &path : rootPaths) {
+            const QSharedPointer<Document> root = document(path);
+            if (!root || !root->schema) {
+                m_errors << QString("%1 : schéma racine invalide").arg(path);
+                ok = false;
+                continue;
             }
+            collectUnsupportedPatterns(root);
         }
-
-        // properties
-        for (auto it = m_properties.begin(); it != m_properties.end(); ++it) {
-            if (obj.contains(it.key())) {
-                QString localErr;
-                QSet<const SwJsonSchema*> visitedCopy(visited);
-                if (!it.value().validateInternal(obj.value(it.key()), visitedCopy, &localErr)) {
-                    return setError(errorMessage,
-                                    QString("Propriété '%1' invalide: %2").arg(it.key()).arg(localErr));
-                }
+        for (const QSharedPointer<Document> &document : m_documents) {
+            if (!document->error.isEmpty()) {
+                m_errors << QString("%1 : %2").arg(document->path, document->error);
             }
         }
+        m_statistics.linkNs = timer.nsecsElapsed();
+        m_statistics.documents = m_documents.size();
+        return ok;
+    }
 
-        // patternProperties
-        for (auto pit = m_patternProperties.begin(); pit != m_patternProperties.end(); ++pit) {
-            QRegularExpression re(pit.key());
-            for (auto it = obj.begin(); it != obj.end(); ++it) {
-                if (re.match(it.key()).hasMatch()) {
-                    QString localErr;
-                    QSet<const SwJsonSchema*> visitedCopy(visited);
-                    if (!pit.value().validateInternal(it.value(), visitedCopy, &localErr)) {
-                        return setError(errorMessage,
-                                        QString("Propriété '%1' invalide (patternProperties / %2): %3")
-                                            .arg(it.key())
-                                            .arg(pit.key())
-                                            .arg(localErr));
-                    }
-                }
-            }
-        }
+    bool load(const QString &rootPath)
+    {
+        return load(QStringList() << rootPath);
+    }
 
-        // additionalProperties
-        if (m_additionalPropertiesIsFalse) {
-            // on refuse toute propriété non listée
-            for (auto it = obj.begin(); it != obj.end(); ++it) {
-                if (!m_properties.contains(it.key()) &&
-                    !matchesAnyPattern(it.key()) &&
-                    !m_ifThenElsePropertyValidated.contains(it.key()))
-                {
-                    return setError(errorMessage,
-                                    QString("Propriété '%1' non autorisée (additionalProperties=false).")
-                                        .arg(it.key()));
-                }
-            }
-        } else if (m_additionalPropertiesSchema) {
-            for (auto it = obj.begin(); it != obj.end(); ++it) {
-                if (!m_properties.contains(it.key()) &&
-                    !matchesAnyPattern(it.key()) &&
-                    !m_ifThenElsePropertyValidated.contains(it.key()))
-                {
-                    QString localErr;
-                    QSet<const SwJsonSchema*> visitedCopy(visited);
-                    if (!m_additionalPropertiesSchema->validateInternal(it.value(), visitedCopy, &localErr)) {
-                        return setError(errorMessage,
-                                        QString("Propriété '%1' invalide (additionalProperties): %2")
-                                            .arg(it.key())
-                                            .arg(localErr));
-                    }
-                }
-            }
-        }
+    /// Schéma compilé de `path` (racine ou document référencé), nullptr s'il est invalide
+    const SwJsonSchema *schema(const QString &path) const
+    {
+        const QSharedPointer<Document> found = document(path);
+        return found ? found->schema.data() : nullptr;
+    }
 
-        if (m_recursiveSchema) {
-            QScopedPointer<SwJsonSchema> _circularRef(new SwJsonSchema(*m_recursiveSchema));
-            // properties
-            for (auto it = _circularRef->m_properties.begin(); it != _circularRef->m_properties.end(); ++it) {
-                if (obj.contains(it.key())) {
-                    QString localErr;
-                    QSet<const SwJsonSchema*> visitedCopy(visited);
-                    if (!it.value().validateInternal(obj.value(it.key()), visitedCopy, &localErr)) {
-                        return setError(errorMessage,
-                                        QString("Propriété '%1' invalide: %2").arg(it.key()).arg(localErr));
-                    }
-                }
-            }
+    /// Fichiers illisibles, JSON invalide, racines invalides
+    QStringList errors() const
+    {
+        return m_errors;
+    }
 
+    Statistics statistics() const
+    {
+        return m_statistics;
+    }
 
-            if (_circularRef->m_additionalPropertiesIsFalse) {
-                // on refuse toute propriété non listée
-                for (auto it = obj.begin(); it != obj.end(); ++it) {
-                    if (!_circularRef->m_properties.contains(it.key()) &&
-                        !_circularRef->matchesAnyPattern(it.key()) &&
-                        !_circularRef->m_ifThenElsePropertyValidated.contains(it.key()))
-                    {
-                        return setError(errorMessage,
-                                        QString("Propriété '%1' non autorisée (additionalProperties=false).")
-                                            .arg(it.key()));
-                    }
-                }
-            } else if (_circularRef->m_additionalPropertiesSchema) {
-                for (auto it = obj.begin(); it != obj.end(); ++it) {
-                    if (!_circularRef->m_properties.contains(it.key()) &&
-                        !_circularRef->matchesAnyPattern(it.key()) &&
-                        !_circularRef->m_ifThenElsePropertyValidated.contains(it.key()))
-                    {
-                        QString localErr;
-                        QSet<const SwJsonSchema*> visitedCopy(visited);
-                        if (!_circularRef->m_additionalPropertiesSchema->validateInternal(it.value(), visitedCopy, &localErr)) {
-                            return setError(errorMessage,
-                                            QString("Propriété '%1' invalide (additionalProperties): %2")
-                                                .arg(it.key())
-                                                .arg(localErr));
-                        }
-                    }
-                }
-            }
+    /// Chemins de tous les documents rencontrés (racines et fichiers référencés, lisibles ou non)
+    QStringList documents() const
+    {
+        QStringList paths;
+        for (const QSharedPointer<Document> &document : m_documents) {
+            paths << document->key;
         }
-        return true;
+        return paths;
     }
 
-    bool validateArray(const QJsonValue &value,
-                       QSet<const SwJsonSchema*> &visited,
-                       QString *errorMessage) const
+private:
+    struct Document {
+        QString key;
+        QString path;
+        QJsonObject object;
+        bool valid = false;
+        QString error;
+        QStringList references;  ///< Chemins des $ref externes vus à la découverte
+        QSharedPointer<SwJsonSchema> schema;
+        QVector<SwJsonSchema::DeferredLink> links;
+        bool patternsCollected = false;
+    };
+
+    /// Enregistre `path` s'il est nouveau ; rend sa clé, vide s'il était déjà connu
+    QString addDocument(const QString &path)
     {
-        if (!value.isArray()) {
-            return setError(errorMessage, "La valeur n'est pas un tableau (array).");
+        const QString key = SwJsonSchema::documentKey(path);
+        if (m_index.contains(key)) {
+            return QString();
         }
-        QJsonArray arr = value.toArray();
+        QSharedPointer<Document> document(new Document);
+        document->key = key;
+        document->path = path;
+        m_index.insert(key, m_documents.size());
+        m_documents << document;
+        return key;
+    }
 
-        if (m_minItems >= 0 && arr.size() < m_minItems) {
-            return setError(errorMessage,
-                            QString("Trop peu d'éléments: %1 < %2").arg(arr.size()).arg(m_minItems));
+    QSharedPointer<Document> document(const QString &path) const
+    {
+        const int index = m_index.value(SwJsonSchema::documentKey(path), -1);
+        return index >= 0 ? m_documents.at(index) : QSharedPointer<Document>();
+    }
+
+    static void readDocument(Document &document)
+    {
+        QFile file(document.key);
+        if (!file.open(QIODevice::ReadOnly)) {
+            document.error = "fichier illisible";
+            return;
         }
-        if (m_maxItems >= 0 && arr.size() > m_maxItems) {
-            return setError(errorMessage,
-                            QString("Trop d'éléments: %1 > %2").arg(arr.size()).arg(m_maxItems));
+        QJsonParseError jerr;
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &jerr);
+        if (jerr.error != QJsonParseError::NoError || !doc.isObject()) {
+            document.error = jerr.error != QJsonParseError::NoError ? jerr.errorString() : QString("pas un objet JSON");
+            return;
         }
-        if (m_uniqueItems) {
-            for (int i = 0; i < arr.size(); ++i) {
-                for (int j = i + 1; j < arr.size(); ++j) {
-                    if (arr[i] == arr[j]) {
-                        return setError(errorMessage, "Doublon trouvé alors que uniqueItems=true.");
-                    }
-                }
-            }
+        document.object = doc.object();
+        document.valid = !document.object.isEmpty();
+        if (document.valid) {
+            scanReferences(document.object, document.path, true, document.references);
         }
+    }
 
-        // items / prefixItems
-        if (m_itemsSchema) {
-            for (int i = 0; i < arr.size(); ++i) {
-                QString localErr;
-                QSet<const SwJsonSchema*> visitedCopy(visited);
-                if (!m_itemsSchema->validateInternal(arr[i], visitedCopy, &localErr)) {
-                    return setError(errorMessage,
-                                    QString("Element [%1] invalide: %2").arg(i).arg(localErr));
-                }
-            }
-        } else if (!m_prefixItemsSchemas.isEmpty()) {
-            int i = 0;
-            for (; i < arr.size() && i < m_prefixItemsSchemas.size(); ++i) {
-                QString localErr;
-                QSet<const SwJsonSchema*> visitedCopy(visited);
-                if (!m_prefixItemsSchemas[i]->validateInternal(arr[i], visitedCopy, &localErr)) {
-                    return setError(errorMessage,
-                                    QString("Element [%1] invalide (prefixItems): %2").arg(i).arg(localErr));
-                }
-            }
-            // Au-delà de prefixItems, on applique additionalItemsSchema si défini
-            if (i < arr.size()) {
-                if (m_additionalItemsSchema) {
-                    for (; i < arr.size(); ++i) {
-                        QString localErr;
-                        QSet<const SwJsonSchema*> visitedCopy(visited);
-                        if (!m_additionalItemsSchema->validateInternal(arr[i], visitedCopy, &localErr)) {
-                            return setError(errorMessage,
-                                            QString("Element [%1] invalide (additionalItems): %2")
-                                                .arg(i).arg(localErr));
-                        }
-                    }
-                }
-                // Sinon, on accepte (draft 2019-09).
+    /**
+     * @brief Relève les $ref externes de `value` en suivant le calcul de m_baseUri de loadSchema
+     *        ($id racine tel quel, $id imbriqué résolu contre la base englobante).
+     */
+    static void scanReferences(const QJsonValue &value, const QString &base, bool isRoot, QStringList &references)
+    {
+        if (value.isArray()) {
+            for (const QJsonValue &item : value.toArray()) {
+                scanReferences(item, base, false, references);
             }
+            return;
         }
-
-        // contains
-        if (m_containsSchema) {
-            int count = 0;
-            for (int i = 0; i < arr.size(); ++i) {
-                QSet<const SwJsonSchema*> visitedCopy(visited);
-                if (m_containsSchema->validateInternal(arr[i], visitedCopy, nullptr)) {
-                    count++;
-                }
-            }
-            if (m_minContains >= 0 && count < m_minContains) {
-                return setError(errorMessage,
-                                QString("Pas assez d'éléments correspondant à 'contains': %1 < %2.")
-                                    .arg(count).arg(m_minContains));
-            }
-            if (m_maxContains >= 0 && count > m_maxContains) {
-                return setError(errorMessage,
-                                QString("Trop d'éléments correspondant à 'contains': %1 > %2.")
-                                    .arg(count).arg(m_maxContains));
+        if (!value.isObject()) {
+            return;
+        }
+        const QJsonObject obj = value.toObject();
+        QString nodeBase = base;
+        if (obj.value("$id").isString()) {
+            const QString id = obj.value("$id").toString().trimmed();
+            nodeBase = (isRoot || base.isEmpty()) ? id : QUrl(base).resolved(QUrl(id)).toString();
+        }
+        if (obj.value("$ref").isString()) {
+            const QString ref = obj.value("$ref").toString().trimmed();
+            if (!ref.contains("$def") && !ref.startsWith("#")) {
+                QStringList tmpLst = nodeBase.split("/");
+                tmpLst.removeLast();
+                tmpLst.append(ref.split("#").first());
+                references << tmpLst.join("/");
             }
-            if (m_minContains < 0 && m_maxContains < 0 && count == 0) {
-                return setError(errorMessage, "Aucun élément ne satisfait 'contains'.");
+        }
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            // Valeurs d'instance, pas des sous-schémas
+            if (it.key() == "const" || it.key() == "enum" || it.key() == "default" || it.key() == "examples") {
+                continue;
             }
+            scanReferences(it.value(), nodeBase, false, references);
         }
-
-        return true;
     }
 
-    // -----------------------------------------------------------------------
-    //                Outils
-    // -----------------------------------------------------------------------
-    bool matchesAnyPattern(const QString &propertyName) const
+    /// Remonte à la racine les motifs non supportés de tous les documents qu'elle atteint
+    void collectUnsupportedPatterns(const QSharedPointer<Document> &root)
     {
-        for (auto it = m_patternProperties.cbegin(); it != m_patternProperties.cend(); ++it) {
-            QRegularExpression re(it.key());
-            if (re.match(propertyName).hasMatch()) {
-                return true;
+        QSet<QString> seen;
+        QVector<QSharedPointer<Document>> stack;
+        stack << root;
+        seen.insert(root->key);
+        QStringList patterns = root->schema->cold().unsupportedPatterns;
+        while (!stack.isEmpty()) {
+            const QSharedPointer<Document> current = stack.takeLast();
+            for (const SwJsonSchema::DeferredLink &link : current->links) {
+                if (seen.contains(link.target)) {
+                    continue;
+                }
+                seen.insert(link.target);
+                const QSharedPointer<Document> next = m_documents.at(m_index.value(link.target));
+                patterns << next->schema->cold().unsupportedPatterns;
+                stack << next;
             }
         }
-        return false;
+        patterns.removeDuplicates();
+        root->schema->mutableCold().unsupportedPatterns = patterns;
+        root->schema->rejectUnsupportedPatterns();
     }
 
-    // -----------------------------------------------------------------
-    //             Outils annexes
-    // -----------------------------------------------------------------
-    void copyFrom(const SwJsonSchema &other)
+    /**
+     * @brief Appelle `function` sur chaque document, en parallèle. Comme
+     *        SwJsonSchemaSet::validateAll() : le thread appelant prend aussi des documents et
+     *        n'attend que ceux déjà commencés (appel depuis une tâche du pool, rechargement
+     *        de SwJsonSchemaReloader). Les tâches ne retiennent aucun document : tous sont
+     *        libérés avec le chargeur.
+     */
+    template <typename Function>
+    void forEach(const QVector<QSharedPointer<Document>> &documents, Function function)
     {
-        // On ne copie pas le registry => dépend du design
-        // (on pourrait le recopier, ou le passer en paramètre)
-        m_dollarSchema = other.m_dollarSchema;
-        m_baseUri = other.m_baseUri;
-        m_dollarAnchor = other.m_dollarAnchor;
-        m_dollarRef = other.m_dollarRef;
-
-        m_type = other.m_type;
-        m_enumValues = other.m_enumValues;
-        m_constValue = other.m_constValue;
-
-        m_multipleOf = other.m_multipleOf;
-        m_hasMultipleOf = other.m_hasMultipleOf;
-        m_minimum = other.m_minimum;
-        m_maximum = other.m_maximum;
-        m_exclusiveMinimum = other.m_exclusiveMinimum;
-        m_exclusiveMaximum = other.m_exclusiveMaximum;
-        m_hasMinimum = other.m_hasMinimum;
-        m_hasMaximum = other.m_hasMaximum;
-
-        m_minLength = other.m_minLength;
-        m_maxLength = other.m_maxLength;
-        m_pattern = other.m_pattern;
-        m_hasPattern = other.m_hasPattern;
-        m_format = other.m_format;
-
-        m_minItems = other.m_minItems;
-        m_maxItems = other.m_maxItems;
-        m_uniqueItems = other.m_uniqueItems;
-
-        // copier m_itemsSchema, m_additionalItemsSchema
-        m_itemsSchema.reset(other.m_itemsSchema ? new SwJsonSchema(*other.m_itemsSchema) : nullptr);
-        m_additionalItemsSchema.reset(other.m_additionalItemsSchema ? new SwJsonSchema(*other.m_additionalItemsSchema) : nullptr);
-
-        // copier prefixItems
-        for (auto *p : m_prefixItemsSchemas) delete p;
-        m_prefixItemsSchemas.clear();
-        for (auto *p : other.m_prefixItemsSchemas) {
-            m_prefixItemsSchemas.append(new SwJsonSchema(*p));
+#ifndef SWJSONSCHEMA_NO_CONCURRENT
+        QThreadPool *pool = m_pool ? m_pool : QThreadPool::globalInstance();
+        const int count = documents.size();
+        QSharedPointer<QAtomicInt> next(new QAtomicInt(0));
+        QSharedPointer<QSemaphore> done(new QSemaphore(0));
+        auto work = [&documents, &function, next, done, count]() {
+            for (int index = next->fetchAndAddRelaxed(1); index < count; index = next->fetchAndAddRelaxed(1)) {
+                function(documents.at(index));
+                done->release();
+            }
+        };
+        for (int helper = 1; helper < qMin(count, pool->maxThreadCount()); ++helper) {
+            (void)QtConcurrent::run(pool, work);  // Tâche encore en file au retour : ne trouve plus rien
+        }
+        work();
+        done->acquire(count);
+#else
+        for (const QSharedPointer<Document> &document : documents) {
+            function(document);
         }
+#endif
+    }
 
-        // contains
-        m_containsSchema.reset(other.m_containsSchema ? new SwJsonSchema(*other.m_containsSchema) : nullptr);
-        m_minContains = other.m_minContains;
-        m_maxContains = other.m_maxContains;
+    SwJsonSchemaContext m_context;  // Déclaré en premier : détruit après les documents
+    QThreadPool *m_pool;
+    QVector<QSharedPointer<Document>> m_documents;
+    QHash<QString, int> m_index;
+    QStringList m_errors;
+    Statistics m_statistics;
+};
 
-        // properties, patternProperties
-        m_properties = other.m_properties;
-        m_patternProperties = other.m_patternProperties;
-        m_additionalPropertiesIsFalse = other.m_additionalPropertiesIsFalse;
-        m_additionalPropertiesSchema.reset(other.m_additionalPropertiesSchema
-                                               ? new SwJsonSchema(*other.m_additionalPropertiesSchema)
-                                               : nullptr);
 
-        m_required = other.m_required;
-        m_dependentRequired = other.m_dependentRequired;
-        m_allOf = other.m_allOf;
-        m_anyOf = other.m_anyOf;
-        m_oneOf = other.m_oneOf;
+/**
+ * @brief Ensemble de schémas routés : chaque message est validé par le schéma désigné par
+ *        l'un de ses champs (discriminant).
+ *
+ * Le discriminant est lu au JSON Pointer donné à la construction ("/type", "/header/kind",
+ * "/$schema", ...). Chaque membre est enregistré sous une valeur de ce champ, ou sous son
+ * $id, comparé sans la casse comme dans les registres (routage par "$schema" ou "$id" du
+ * message). La table de routage est un QHash : coût constant quel que soit le nombre de
+ * membres.
+ *
+ * Les membres sont chargés ensemble par un SwJsonSchemaLoader : les documents de
+ * définitions communs à plusieurs membres ne sont lus et compilés qu'une fois, et tous les
+ * membres partagent les registres de $ref. L'ensemble possède ses schémas. validate() et
+ * validateAll() peuvent être appelés depuis plusieurs threads une fois load() terminé.
+ */
+class SwJsonSchemaSet
+{
+public:
+    /// `routePointer` : JSON Pointer du discriminant dans chaque message
+    explicit SwJsonSchemaSet(const QString &routePointer = "/$schema", QThreadPool *pool = nullptr)
+        : m_routePointer(routePointer), m_pool(pool), m_loader(pool)
+    {
+        const QStringList raw = routePointer.startsWith('/') ? routePointer.mid(1).split('/') : QStringList();
+        for (QString token : raw) {
+            token.replace("~1", "/");
+            token.replace("~0", "~");
+            m_routeTokens << token;
+        }
+    }
 
-        m_notSchema.reset(other.m_notSchema ? new SwJsonSchema(*other.m_notSchema) : nullptr);
-        m_ifSchema.reset(other.m_ifSchema ? new SwJsonSchema(*other.m_ifSchema) : nullptr);
-        m_thenSchema.reset(other.m_thenSchema ? new SwJsonSchema(*other.m_thenSchema) : nullptr);
-        m_elseSchema.reset(other.m_elseSchema ? new SwJsonSchema(*other.m_elseSchema) : nullptr);
+    SwJsonSchemaSet(const SwJsonSchemaSet &) = delete;
+    SwJsonSchemaSet &operator=(const SwJsonSchemaSet &) = delete;
 
-        m_defs = other.m_defs;
-        m_isValide = other.m_isValide;
-        m_parent = other.m_parent;
-        m_recursiveSchema = other.m_recursiveSchema;
-        m_internalCustomKeywordValidator = other.m_internalCustomKeywordValidator;
+    /// Ajoute le schéma du fichier `path`, choisi pour les messages dont le discriminant vaut `routeValue`.
+    void addSchema(const QString &routeValue, const QString &path)
+    {
+        m_members << Member{routeValue, path, false};
     }
 
-    void deduceTypeFromConstraints()
+    /// Ajoute le schéma du fichier `path`, routé par son $id (son chemin s'il n'en a pas).
+    void addSchema(const QString &path)
     {
-        bool mightBeString = (m_minLength >= 0 || m_maxLength >= 0 || m_hasPattern || !m_format.isEmpty());
-        bool mightBeNumber = (m_hasMinimum || m_hasMaximum || m_hasMultipleOf);
-        bool mightBeObject = (!m_properties.isEmpty() || !m_patternProperties.isEmpty()
-                              || !m_required.isEmpty()
-                              || m_additionalPropertiesSchema || m_additionalPropertiesIsFalse);
-        bool mightBeArray  = (!m_prefixItemsSchemas.isEmpty() || m_itemsSchema
-                             || (m_minItems >= 0) || (m_maxItems >= 0));
-
-        int count = 0;
-        if (mightBeString)  count++;
-        if (mightBeNumber)  count++;
-        if (mightBeObject)  count++;
-        if (mightBeArray)   count++;
-
-        if (count == 1) {
-            if (mightBeString) m_type = SchemaType::String;
-            else if (mightBeNumber) m_type = SchemaType::Number;
-            else if (mightBeObject) m_type = SchemaType::Object;
-            else if (mightBeArray)  m_type = SchemaType::Array;
-        }
+        m_members << Member{QString(), path, true};
     }
 
-    bool checkType(const QJsonValue &v) const
+    /**
+     * @brief Charge en parallèle les membres ajoutés depuis le dernier appel, puis met à jour
+     *        la table de routage.
+     * @return false si un membre est invalide ou si une valeur est routée vers deux schémas
+     *         (détail dans errors()).
+     */
+    bool load()
     {
-        switch (m_type) {
-        case SchemaType::String:
-            return v.isString();
-        case SchemaType::Number:
-            return v.isDouble();
-        case SchemaType::Integer:
-            if (v.isDouble()) {
-                double value = v.toDouble();
-                return std::floor(value) == value;
+        m_errors.clear();
+        QStringList paths;
+        for (const Member &member : m_members) {
+            paths << member.path;
+        }
+        bool ok = m_loader.load(paths);
+        m_errors << m_loader.errors();
+        for (const Member &member : m_members) {
+            const SwJsonSchema *schema = m_loader.schema(member.path);
+            if (!schema) {
+                ok = false;
+                continue;
             }
-            return false;
-        case SchemaType::Boolean:
-            return v.isBool();
-        case SchemaType::Object:
-            return v.isObject();
-        case SchemaType::Array:
-            return v.isArray();
-        case SchemaType::Null:
-            return v.isNull();
-        case SchemaType::Invalid:
-        default:
-            return true;
+            // $id : comparé sans la casse, comme dans les registres
+            QHash<QString, const SwJsonSchema *> &routes = member.byId ? m_idRoutes : m_routes;
+            const QString route = member.byId ? schema->m_baseUri.toLower() : member.routeValue;
+            const SwJsonSchema *previous = routes.value(route, nullptr);
+            if (previous && previous != schema) {
+                m_errors << QString("%1 : valeur de routage '%2' déjà attribuée").arg(member.path, route);
+                ok = false;
+                continue;
+            }
+            routes.insert(route, schema);
         }
+        m_members.clear();
+        return ok;
     }
 
-
-    SchemaType getType(const QJsonValue &v) const
+    /// Schéma choisi pour `message`, nullptr si son discriminant est absent ou inconnu.
+    const SwJsonSchema *schemaFor(const QJsonValue &message) const
     {
-        if (v.isString()) {
-            return SchemaType::String;
-        } else if (v.isDouble()) {
-            return SchemaType::Number;
-        } else if (v.isBool()) {
-            return SchemaType::Boolean;
-        } else if (v.isObject()) {
-            return SchemaType::Object;
-        } else if (v.isArray()) {
-            return SchemaType::Array;
-        } else if (v.isNull()) {
-            return SchemaType::Null;
-        } else {
-            return SchemaType::Invalid;  // Cas par défaut pour un type non reconnu
-        }
+        QString route;
+        return routeValue(message, route) ? lookup(route) : nullptr;
     }
 
-
-
-    static bool checkFormat(const QString &value, const QString &formatName, QString *errorMessage)
+    /// Schéma enregistré sous `routeValue`, nullptr sinon.
+    const SwJsonSchema *schema(const QString &routeValue) const
     {
-        // Implémentez ici la logique pour "email", "date-time", etc.
-        // Ex en simplifié :
-        // -- "email" --
-        if (formatName == "email") {
-            static const QRegularExpression emailRe(
-                R"(^[a-zA-Z0-9._%+\-]+@[a-zA-Z0-9.\-]+\.[a-zA-Z]{2,}$)"
-                );
-            if (!emailRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format email est invalide.");
-            }
+        return lookup(routeValue);
+    }
 
-            // -- "date-time" (RFC3339 simplifié) --
-        } else if (formatName == "date-time") {
-            static const QRegularExpression dateTimeRe(
-                R"(^(?<year>\d{4})-(?<month>\d{2})-(?<day>\d{2})T(?<hour>\d{2}):(?<min>\d{2}):(?<sec>\d{2})(\.\d+)?(Z|[+\-]\d{2}:\d{2})$)"
-                );
-            if (!dateTimeRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format date-time (RFC3339) est invalide.");
-            }
+    /// Valeurs de routage connues ($id en minuscules)
+    QStringList routes() const
+    {
+        return m_routes.keys() + m_idRoutes.keys();
+    }
 
-            // -- "date" (YYYY-MM-DD) --
-        } else if (formatName == "date") {
-            static const QRegularExpression dateRe(
-                R"(^(?<year>\d{4})-(?<month>\d{2})-(?<day>\d{2})$)"
-                );
-            if (!dateRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format date (YYYY-MM-DD) est invalide.");
-            }
+    /**
+     * @brief Valide `message` avec le schéma désigné par son discriminant. Un message sans
+     *        discriminant, ou dont la valeur n'est pas routée, est invalide.
+     */
+    bool validate(const QJsonValue &message, QString *errorMessage = nullptr) const
+    {
+        const SwJsonSchema *schema = route(message, errorMessage);
+        return schema && schema->validate(message, errorMessage);
+    }
 
-            // -- "time" (hh:mm:ss(.fraction)?(Z|±hh:mm)?) --
-        } else if (formatName == "time") {
-            static const QRegularExpression timeRe(
-                R"(^(?<hour>\d{2}):(?<min>\d{2})(:(?<sec>\d{2})(\.\d+)?)?(Z|[+\-]\d{2}:\d{2})?$)"
-                );
-            if (!timeRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format time est invalide.");
-            }
+    SwJsonSchema::ValidationResult validateWithResult(const QJsonValue &message,
+                                                      const SwJsonSchema::ValidationOptions &options) const
+    {
+        SwJsonSchema::ValidationResult result;
+        const SwJsonSchema *schema = route(message, &result.errorMessage);
+        return schema ? schema->validateWithResult(message, options) : result;
+    }
 
-            // -- "hostname" (RFC1123 simplifié) --
-        } else if (formatName == "hostname") {
-            static const QRegularExpression hostnameRe(
-                R"(^(?=.{1,253}$)([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?)(\.([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?))*$)"
-                );
-            if (!hostnameRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format hostname est invalide.");
+    /**
+     * @brief Valide un lot de messages, répartis par tranches sur le pool du constructeur
+     *        (QThreadPool::globalInstance() par défaut). Les résultats suivent l'ordre de
+     *        `messages`. ValidationOptions::trace, ::state et ::memoStatistics sont ignorés :
+     *        ils ne décrivent qu'une validation. Le thread appelant valide aussi : l'appel
+     *        depuis une tâche du pool ne bloque pas.
+     */
+    QVector<SwJsonSchema::ValidationResult> validateAll(const QVector<QJsonValue> &messages,
+                                                        const SwJsonSchema::ValidationOptions &options) const
+    {
+        QVector<SwJsonSchema::ValidationResult> results(messages.size());
+        SwJsonSchema::ValidationOptions shared = options;
+        shared.trace = nullptr;
+        shared.state = nullptr;
+        shared.memoStatistics = nullptr;
+        auto validateRange = [this, &messages, &results, &shared](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                results[i] = validateWithResult(messages.at(i), shared);
             }
-
-            // -- "ipv4" --
-        } else if (formatName == "ipv4") {
-            static const QRegularExpression ipv4Re(
-                R"(^(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
-                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
-                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)\."
-                  R"(25[0-5]|2[0-4]\d|[01]?\d?\d)$)"
-                );
-            if (!ipv4Re.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format IPv4 est invalide.");
+        };
+#ifndef SWJSONSCHEMA_NO_CONCURRENT
+        QThreadPool *pool = m_pool ? m_pool : QThreadPool::globalInstance();
+        const int size = messages.size();
+        const int chunk = qMax(16, int(size / (qMax(1, pool->maxThreadCount()) * 4)));
+        const int chunks = (size + chunk - 1) / chunk;
+        // Tranches prises une à une par le thread appelant et par les tâches du pool :
+        // l'appelant n'attend que les tranches déjà commencées, jamais une tâche en file.
+        // Appelé depuis une tâche du même pool (saturé), il fait seul tout le travail.
+        QSharedPointer<QAtomicInt> next(new QAtomicInt(0));
+        QSharedPointer<QSemaphore> done(new QSemaphore(0));
+        auto work = [validateRange, next, done, chunk, chunks, size]() {
+            for (int index = next->fetchAndAddRelaxed(1); index < chunks; index = next->fetchAndAddRelaxed(1)) {
+                validateRange(index * chunk, qMin(size, (index + 1) * chunk));
+                done->release();
             }
+        };
+        for (int helper = 1; helper < qMin(chunks, pool->maxThreadCount()); ++helper) {
+            (void)QtConcurrent::run(pool, work);  // Tâche encore en file au retour : ne trouve plus rien
+        }
+        work();
+        done->acquire(chunks);
+#else
+        validateRange(0, messages.size());
+#endif
+        return results;
+    }
 
-            // -- "ipv6" (simplifié, incluant '::') --
-        } else if (formatName == "ipv6") {
-            // Version simplifiée. Pour un check complet, se fier à QHostAddress ou RFC 4291.
-            static const QRegularExpression ipv6Re(
-                // Ce pattern essaie de capturer divers cas "compressés" via '::'.
-                R"((^(([0-9A-Fa-f]{1,4}:){7}([0-9A-Fa-f]{1,4}|:))|)"
-                R"(^(::([0-9A-Fa-f]{1,4}:){0,5}((([0-9A-Fa-f]{1,4}))|:))$)"
-                );
-            if (!ipv6Re.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format IPv6 est invalide.");
-            }
+    QVector<SwJsonSchema::ValidationResult> validateAll(const QVector<QJsonValue> &messages) const
+    {
+        return validateAll(messages, SwJsonSchema::ValidationOptions());
+    }
 
-            // -- "uri" (simplifié) --
-        } else if (formatName == "uri") {
-            // On peut aussi faire `QUrl url(value); if (!url.isValid()) ...`
-            // Pour un check plus élaboré sur tous les aspects d'une URI (RFC 3986).
-            static const QRegularExpression uriRe(
-                R"(^[A-Za-z][A-Za-z0-9+\-.]*:)"
-                R"(\/\/?([^\s/]+)(\/\S*)?$)"
-                );
-            if (!uriRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format URI est invalide.");
-            }
+    /// Membres invalides, fichiers illisibles, valeurs de routage en double (dernier load())
+    QStringList errors() const
+    {
+        return m_errors;
+    }
 
-            // -- "uuid" (RFC 4122 version 4 / standard) --
-        } else if (formatName == "uuid") {
-            // Forme : 8-4-4-4-12 hexadécimal
-            static const QRegularExpression uuidRe(
-                R"(^[0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12}$)"
-                );
-            if (!uuidRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format uuid est invalide.");
-            }
+    /// Documents chargés (membres et fichiers qu'ils référencent) et durées du dernier load()
+    SwJsonSchemaLoader::Statistics statistics() const
+    {
+        return m_loader.statistics();
+    }
 
-            // -- "phone" (exemple très général) --
-        } else if (formatName == "phone") {
-            // Ici on autorise : +, (), espace, tiret, chiffres, etc.
-            // À affiner selon le plan de numérotation international, etc.
-            static const QRegularExpression phoneRe(
-                R"(^[+\-()0-9\s]+$)"  // très permissif
-                );
-            if (!phoneRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format phone est invalide.");
-            }
+private:
+    struct Member {
+        QString routeValue;
+        QString path;
+        bool    byId;  ///< Routé par le $id du schéma
+    };
 
-            // -- "credit-card" : check via Regex + Luhn --
-        } else if (formatName == "credit-card") {
-            // Regex simple : 13 à 19 chiffres
-            static const QRegularExpression ccRe(R"(^\d{13,19}$)");
-            if (!ccRe.match(value).hasMatch()) {
-                return setError(errorMessage, "Le format credit-card est invalide (doit être 13-19 chiffres).");
-            }
-            // Vérification Luhn
-            if (!luhnCheck(value)) {
-                return setError(errorMessage, "Le numéro de carte de crédit n'est pas valide (Luhn).");
+    /// Valeur du discriminant : chaîne telle quelle, nombre et booléen en texte JSON.
+    bool routeValue(const QJsonValue &message, QString &route) const
+    {
+        QJsonValue current = message;
+        for (const QString &token : m_routeTokens) {
+            if (current.isObject()) {
+                current = current.toObject().value(token);
+            } else if (current.isArray()) {
+                bool isIndex = false;
+                const int index = token.toInt(&isIndex);
+                current = isIndex ? current.toArray().at(index) : QJsonValue(QJsonValue::Undefined);
+            } else {
+                return false;
             }
         }
+        if (current.isString()) {
+            route = current.toString();
+        } else if (current.isDouble()) {
+            const double number = current.toDouble();
+            route = number == std::floor(number) && std::fabs(number) < 1e15 ? QString::number(qint64(number))
+                                                                           : QString::number(number, 'g', 17);
+        } else if (current.isBool()) {
+            route = current.toBool() ? "true" : "false";
+        } else {
+            return false;
+        }
         return true;
     }
 
-    static bool luhnCheck(const QString &ccNumberInput)
+    /// Valeur de routage explicite d'abord, puis $id sans la casse.
+    const SwJsonSchema *lookup(const QString &route) const
     {
-        QString ccNumber = ccNumberInput;
-        ccNumber.remove(' ');
-        ccNumber.remove('-');
-        static const QRegularExpression reDigits("^[0-9]+$");
-        if (!reDigits.match(ccNumber).hasMatch()) {
-            return false;
+        const SwJsonSchema *schema = m_routes.value(route, nullptr);
+        return schema ? schema : m_idRoutes.value(route.toLower(), nullptr);
+    }
+
+    const SwJsonSchema *route(const QJsonValue &message, QString *errorMessage) const
+    {
+        QString value;
+        if (!routeValue(message, value)) {
+            if (errorMessage) {
+                *errorMessage = QString("Discriminant '%1' absent ou non scalaire").arg(m_routePointer);
+            }
+            return nullptr;
         }
-        if (ccNumber.size() < 13 || ccNumber.size() > 19) {
-            return false;
+        const SwJsonSchema *schema = lookup(value);
+        if (!schema && errorMessage) {
+            *errorMessage = QString("Aucun schéma pour '%1' = '%2'").arg(m_routePointer, value);
         }
+        return schema;
+    }
 
-        int sum = 0;
-        bool alternate = false;
-        for (int i = ccNumber.size() - 1; i >= 0; --i) {
-            int n = ccNumber.at(i).digitValue();
-            if (alternate) {
-                n *= 2;
-                if (n > 9) {
-                    n = (n % 10) + 1;
-                }
+    QString m_routePointer;
+    QStringList m_routeTokens;
+    QThreadPool *m_pool;
+    SwJsonSchemaLoader m_loader;
+    QVector<Member> m_members;
+    QHash<QString, const SwJsonSchema *> m_routes;    ///< Valeurs données à addSchema(route, path)
+    QHash<QString, const SwJsonSchema *> m_idRoutes;  ///< $id en minuscules (addSchema(path))
+    QStringList m_errors;
+};
+
+
+/**
+ * @brief Schéma rechargé à chaud depuis ses fichiers.
+ *
+ * Le document racine et tous les fichiers qu'il référence ($ref externes) sont surveillés
+ * par un QFileSystemWatcher. Après une modification (regroupées sur setReloadDelay()), une
+ * nouvelle version est compilée en tâche de fond par un SwJsonSchemaLoader, puis publiée
+ * par un échange atomique de pointeur. Une version invalide n'est pas publiée : la
+ * précédente reste en service et errors() en donne la raison.
+ *
+ * Les lecteurs (validate(), withSchema()) ne prennent aucun verrou : ils s'inscrivent sur
+ * l'un de deux compteurs d'époque et lisent la version courante. Après l'échange, le
+ * rechargement change d'époque et attend que les lecteurs de l'ancienne aient fini, puis
+ * la libère. Chaque version a ses propres registres (ceux de son chargeur) : une
+ * validation en cours termine sur la version qu'elle a commencée, $ref comprises.
+ *
+ * Le surveillant et les notifications vivent dans le thread qui construit l'objet (boucle
+ * d'événements requise). L'objet doit survivre à toutes les validations qui l'utilisent.
+ */
+class SwJsonSchemaReloader
+{
+public:
+    /// `pool` : compilation des nouvelles versions, QThreadPool::globalInstance() par défaut
+    explicit SwJsonSchemaReloader(const QString &path, QThreadPool *pool = nullptr)
+        : m_path(path), m_pool(pool)
+    {
+        m_timer.setSingleShot(true);
+        m_timer.setInterval(200);
+        QObject::connect(&m_watcher, &QFileSystemWatcher::fileChanged, &m_watcher, [this](const QString &) {
+            m_timer.start();
+        });
+        // Enregistrement par renommage : le fichier quitte le surveillant puis réapparaît
+        QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged, &m_watcher, [this](const QString &) {
+            if (watchFiles()) {
+                m_timer.start();
             }
-            sum += n;
-            alternate = !alternate;
-        }
-        return (sum % 10) == 0;
+        });
+        QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]() {
+            scheduleReload();
+        });
+        reload();
+        watchFiles();
     }
 
-    static bool setError(QString *errorMessage, const QString &msg)
+    SwJsonSchemaReloader(const SwJsonSchemaReloader &) = delete;
+    SwJsonSchemaReloader &operator=(const SwJsonSchemaReloader &) = delete;
+
+    ~SwJsonSchemaReloader()
     {
-        if (errorMessage) {
-            *errorMessage = msg;
-        }
-        return false;
+        m_timer.stop();
+        m_background.waitForFinished();
+        QMutexLocker locker(&m_reloadMutex);
+        delete m_current.fetchAndStoreOrdered(nullptr);
     }
 
-    static QString toString(SchemaType t)
+    /// Vrai si une version valide est en service
+    bool isValide() const
     {
-        switch (t) {
-        case SchemaType::String:  return "string";
-        case SchemaType::Number:  return "number";
-        case SchemaType::Integer: return "integer";
-        case SchemaType::Boolean: return "boolean";
-        case SchemaType::Object:  return "object";
-        case SchemaType::Array:   return "array";
-        case SchemaType::Null:    return "null";
-        default:                  return "invalid";
-        }
+        return m_current.loadAcquire() != nullptr;
     }
 
-    static QString toString(const QJsonValue &v)
+    /// Numéro de la version en service (1 pour le premier chargement, 0 si aucune)
+    int generation() const
     {
-        if (v.isString())  return "string";
-        if (v.isBool())    return "boolean";
-        if (v.isObject())  return "object";
-        if (v.isArray())   return "array";
-        if (v.isNull())    return "null";
-        if (v.isDouble()) {
-            double value = v.toDouble();
-            if (std::floor(value) == value) {
-                return "integer";
+        ReadGuard guard(*this);
+        return guard.version() ? guard.version()->generation : 0;
+    }
+
+    bool validate(const QJsonValue &value, QString *errorMessage = nullptr) const
+    {
+        ReadGuard guard(*this);
+        if (!guard.version()) {
+            if (errorMessage) {
+                *errorMessage = QString("Aucune version valide de '%1'").arg(m_path);
             }
-            return "number";
+            return false;
         }
-        return "undefined";
+        return guard.version()->schema->validate(value, errorMessage);
     }
 
-
-    SwJsonSchema::SchemaType parseType(const QJsonValue &val) const
+    SwJsonSchema::ValidationResult validateWithResult(const QJsonValue &value,
+                                                      const SwJsonSchema::ValidationOptions &options) const
     {
-        if (!val.isString()) {
-            return SchemaType::Invalid;
+        ReadGuard guard(*this);
+        if (!guard.version()) {
+            SwJsonSchema::ValidationResult result;
+            result.errorMessage = QString("Aucune version valide de '%1'").arg(m_path);
+            return result;
         }
-        QString typeStr = val.toString().toLower().trimmed();
-        if (typeStr == "string")  return SchemaType::String;
-        if (typeStr == "number")  return SchemaType::Number;
-        if (typeStr == "integer")  return SchemaType::Integer;
-        if (typeStr == "boolean") return SchemaType::Boolean;
-        if (typeStr == "object")  return SchemaType::Object;
-        if (typeStr == "array")   return SchemaType::Array;
-        if (typeStr == "null")    return SchemaType::Null;
-        return SchemaType::Invalid;
+        return guard.version()->schema->validateWithResult(value, options);
     }
 
-    inline QString resolveUri(const SwJsonSchema *parent, const QString &id)
+    /**
+     * @brief Appelle `function(const SwJsonSchema &)` sur la version en service, qui reste
+     *        valide pendant l'appel (validateDocument(), validateAt(), ...). Un appel long
+     *        retarde la libération de la version remplacée, pas sa publication.
+     *        Sans version valide, `function` n'est pas appelée et le résultat est construit
+     *        par défaut.
+     */
+    template <typename Function>
+    auto withSchema(Function function) const -> decltype(function(std::declval<const SwJsonSchema &>()))
     {
-        if (!parent || parent->m_baseUri.isEmpty()) {
-            return id.trimmed();
+        ReadGuard guard(*this);
+        if (!guard.version()) {
+            return decltype(function(std::declval<const SwJsonSchema &>()))();
         }
+        return function(*guard.version()->schema);
+    }
 
-        QUrl baseUrl(parent->m_baseUri);
-
-        QUrl relativeUrl(id.trimmed());
-
-        QUrl resolved = baseUrl.resolved(relativeUrl);
+    /**
+     * @brief Recompile immédiatement, sur le thread appelant, et publie la nouvelle version
+     *        si elle est valide.
+     * @return false si le document n'est pas un schéma valide (détail dans errors()).
+     */
+    bool reload()
+    {
+        QMutexLocker locker(&m_reloadMutex);
+        QScopedPointer<Version> next(new Version);
+        next->loader.reset(new SwJsonSchemaLoader(m_pool));
+        const bool ok = next->loader->load(m_path);
+        {
+            QMutexLocker stateLocker(&m_stateMutex);
+            m_errors = next->loader->errors();
+            m_files = next->loader->documents();
+            if (const Version *current = m_current.loadAcquire()) {
+                // Une version refusée garde aussi les fichiers en service sous surveillance
+                for (const QString &file : current->loader->documents()) {
+                    if (!m_files.contains(file)) {
+                        m_files << file;
+                    }
+                }
+            }
+        }
+        if (!ok) {
+            return false;  // Registres propres au chargeur : la version refusée est libérée ici
+        }
+        next->schema = next->loader->schema(m_path);
+        next->generation = ++m_lastGeneration;
 
-        return resolved.toString();
+        Version *previous = m_current.fetchAndStoreOrdered(next.take());
+        const int epoch = m_epoch.fetchAndAddOrdered(1);
+        while (m_readers[epoch & 1].fetchAndAddOrdered(0) != 0) {
+            QThread::yieldCurrentThread();
+        }
+        delete previous;
+        return true;
     }
 
-    static SwJsonSchemaRegistry *getRegistry(const QString baseUri)
+    /// Délai (ms) de regroupement des modifications avant recompilation (200 par défaut)
+    void setReloadDelay(int msec)
     {
-        static QMap<QString, SwJsonSchemaRegistry *> registryBook;
-        if(!registryBook.contains(baseUri.toLower())){
-            registryBook.insert(baseUri.toLower(), new SwJsonSchemaRegistry());
-        }
-        return registryBook.value(baseUri.toLower());
+        m_timer.setInterval(qMax(0, msec));
     }
 
-    SwJsonSchema *parent() const {
-        return m_parent;
+    /// Appelé dans le thread du surveillant après chaque rechargement déclenché par une modification.
+    void setReloadCallback(std::function<void(bool ok)> callback)
+    {
+        m_callback = std::move(callback);
     }
 
-    SwJsonSchema *findMainSchema() {
-        SwJsonSchema *seeked = this;
-        while(seeked->parent()){
-            seeked = seeked->parent();
-        }
-        return seeked;
+    /// Erreurs du dernier chargement (vide s'il a réussi)
+    QStringList errors() const
+    {
+        QMutexLocker locker(&m_stateMutex);
+        return m_errors;
     }
 
-    static QMap<QString, Validator>& getCustomKeywordRegistry() {
-        static QMap<QString, Validator> customKeywordRegistry;
-        return customKeywordRegistry;
+    /// Fichiers surveillés : document racine et documents qu'il référence
+    QStringList watchedFiles() const
+    {
+        return m_watcher.files();
     }
 
 private:
-    // -----------------------------------------------------------------------
-    //                      Données membres
-    // -----------------------------------------------------------------------
-    QString m_dollarSchema;
-    QString m_baseUri;
-    QString m_dollarAnchor;
-    QString m_dollarRef;
-
-    SchemaType  m_type           = SchemaType::Invalid;
-    QList<QJsonValue> m_enumValues;
-    QJsonValue  m_constValue     = QJsonValue(QJsonValue::Undefined);
-
-    // Numérique
-    double m_multipleOf          = 0.0;
-    bool   m_hasMultipleOf       = false;
-    double m_minimum             = 0.0;
-    double m_maximum             = 0.0;
-    bool   m_exclusiveMinimum    = false;
-    bool   m_exclusiveMaximum    = false;
-    bool   m_hasMinimum          = false;
-    bool   m_hasMaximum          = false;
-
-    // String
-    int     m_minLength          = -1;
-    int     m_maxLength          = -1;
-    QString m_pattern;
-    bool    m_hasPattern         = false;
-    QString m_format;
+    struct Version {
+        QScopedPointer<SwJsonSchemaLoader> loader;
+        const SwJsonSchema *schema = nullptr;
+        int generation = 0;
+    };
 
-    // Array
-    int     m_minItems           = -1;
-    int     m_maxItems           = -1;
-    bool    m_uniqueItems        = false;
-    QScopedPointer<SwJsonSchema> m_itemsSchema;
-    QList<SwJsonSchema*>         m_prefixItemsSchemas;
-    QScopedPointer<SwJsonSchema> m_additionalItemsSchema;
-    SwJsonSchema *m_recursiveSchema = nullptr;
+    /// Lecteur inscrit sur le compteur de l'époque courante pendant sa durée de vie.
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const SwJsonSchemaReloader &reloader)
+        {
+            while (true) {
+                const int epoch = reloader.m_epoch.fetchAndAddOrdered(0);
+                m_readers = &reloader.m_readers[epoch & 1];
+                m_readers->ref();
+                // L'époque a changé entre-temps : le rechargement n'attend peut-être pas ce compteur
+                if (reloader.m_epoch.fetchAndAddOrdered(0) == epoch) {
+                    break;
+                }
+                m_readers->deref();
+            }
+            m_version = reloader.m_current.loadAcquire();
+        }
 
-    QScopedPointer<SwJsonSchema> m_containsSchema;
-    int m_minContains            = -1;
-    int m_maxContains            = -1;
+        ~ReadGuard()
+        {
+            m_readers->deref();
+        }
 
-    // Object
-    QMap<QString, SwJsonSchema>  m_properties;
-    QMap<QString, SwJsonSchema>  m_patternProperties;
-    bool m_additionalPropertiesIsFalse = false;
-    QScopedPointer<SwJsonSchema> m_additionalPropertiesSchema;
-    QSet<QString>                m_required;
-    QMap<QString, QStringList>   m_dependentRequired;
+        const Version *version() const
+        {
+            return m_version;
+        }
 
-    // Combinaisons logiques
-    QList<SwJsonSchema> m_allOf;
-    QList<SwJsonSchema> m_anyOf;
-    QList<SwJsonSchema> m_oneOf;
-    QScopedPointer<SwJsonSchema> m_notSchema;
+    private:
+        QAtomicInt    *m_readers;
+        const Version *m_version;
+    };
 
-    // if/then/else
-    QScopedPointer<SwJsonSchema> m_ifSchema;
-    QScopedPointer<SwJsonSchema> m_thenSchema;
-    QScopedPointer<SwJsonSchema> m_elseSchema;
+    /// Ajoute au surveillant les fichiers (et leurs répertoires) absents ; vrai si un fichier est revenu.
+    bool watchFiles()
+    {
+        QStringList files;
+        {
+            QMutexLocker locker(&m_stateMutex);
+            files = m_files;
+        }
+        const QStringList watched = m_watcher.files();
+        QStringList missing;
+        QStringList directories;
+        for (const QString &file : files) {
+            if (!watched.contains(file) && QFileInfo::exists(file)) {
+                missing << file;
+            }
+            const QString directory = QFileInfo(file).absolutePath();
+            if (!directories.contains(directory) && !m_watcher.directories().contains(directory)) {
+                directories << directory;
+            }
+        }
+        if (!directories.isEmpty()) {
+            m_watcher.addPaths(directories);
+        }
+        if (missing.isEmpty()) {
+            return false;
+        }
+        m_watcher.addPaths(missing);
+        return true;
+    }
 
-    // $defs
-    QMap<QString, SwJsonSchema> m_defs;
+    /// Recompile en tâche de fond ; les demandes reçues pendant une compilation en relancent une.
+    void scheduleReload()
+    {
+#ifndef SWJSONSCHEMA_NO_CONCURRENT
+        if (m_requests.fetchAndAddOrdered(1) != 0) {
+            return;
+        }
+        QThreadPool *pool = m_pool ? m_pool : QThreadPool::globalInstance();
+        m_background = QtConcurrent::run(pool, [this]() {
+            int handled;
+            do {
+                handled = m_requests.loadAcquire();
+                const bool ok = reload();
+                QMetaObject::invokeMethod(&m_watcher, [this, ok]() { reloaded(ok); }, Qt::QueuedConnection);
+            } while (m_requests.fetchAndAddOrdered(-handled) != handled);
+        });
+#else
+        reloaded(reload());
+#endif
+    }
 
-    // if/then/else : on stocke les noms de propriétés validées
-    mutable QSet<QString> m_ifThenElsePropertyValidated;
+    void reloaded(bool ok)
+    {
+        watchFiles();
+        if (m_callback) {
+            m_callback(ok);
+        }
+    }
 
-    bool m_isValide = false;
-    SwJsonSchema *m_parent;
-    QList<KeywordJsonValidator> m_internalCustomKeywordValidator;
+    QString m_path;
+    QThreadPool *m_pool;
+    QAtomicPointer<Version> m_current;
+    mutable QAtomicInt m_epoch;
+    mutable QAtomicInt m_readers[2];
+    QMutex m_reloadMutex;                                   ///< Un rechargement à la fois
+    int m_lastGeneration = 0;
+    mutable QMutex m_stateMutex;
+    QStringList m_errors;
+    QStringList m_files;
+    QFileSystemWatcher m_watcher;
+    QTimer m_timer;
+    QAtomicInt m_requests;
+    QFuture<void> m_background;
+    std::function<void(bool)> m_callback;
 };
 
 #endif // SWJSONSCHEMA_H
@@ -1,10 +1,21 @@
+#include <QCborValue>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMutex>
+#include <QSemaphore>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
+#include <QVariant>
+#include <QXmlStreamWriter>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "SwJsonSchema.h"
 
@@ -17,6 +28,7 @@ struct ValidationResult
     QString dataFileName;  // Nom du fichier de données (ex: "validA.json")
     bool    success;       // True si le test est considéré comme OK
     QString error;         // Message d'erreur si échec
+    qint64  elapsedNs = 0; // Durée de la validation (chargement du schéma exclu)
 };
 
 //--------------------------------------------------------------------
@@ -54,6 +66,169 @@ QJsonDocument loadJsonDocument(const QString &filePath, bool *ok = nullptr, QStr
     return doc;
 }
 
+//--------------------------------------------------------------------
+// Répertoire de sortie des traces (option "--trace <dir>"), vide = désactivé
+//--------------------------------------------------------------------
+static QString g_traceDir;
+
+//--------------------------------------------------------------------
+// Cache de résultats par validation (option "--memoize") et statistiques cumulées
+//--------------------------------------------------------------------
+static bool    g_memoize = false;
+static QAtomicInteger<quint64> g_memoHits;
+static QAtomicInteger<quint64> g_memoMisses;
+
+//--------------------------------------------------------------------
+// Cache des documents déjà validés par schéma (option "--result-cache <n>"), 0 = désactivé :
+// chaque donnée est revalidée depuis le cache et doit donner le même résultat
+//--------------------------------------------------------------------
+static int g_resultCacheEntries = 0;
+static QAtomicInteger<quint64> g_resultCacheHits;
+static QAtomicInteger<quint64> g_resultCacheMisses;
+static QAtomicInteger<quint64> g_resultCacheEvictions;
+
+static void collectResultCacheStatistics(const SwJsonSchema &schema)
+{
+    const SwJsonSchemaResultCache::Statistics stats = schema.resultCacheStatistics();
+    g_resultCacheHits.fetchAndAddRelaxed(stats.hits);
+    g_resultCacheMisses.fetchAndAddRelaxed(stats.misses);
+    g_resultCacheEvictions.fetchAndAddRelaxed(stats.evictions);
+}
+
+//--------------------------------------------------------------------
+// Mémoire retenue par chaque schéma après ses validations (option "--memory")
+//--------------------------------------------------------------------
+static bool g_memory = false;
+static QMutex g_memoryMutex;
+static QMap<QString, SwJsonSchema::MemoryUsage> g_memoryUsage;
+
+//--------------------------------------------------------------------
+// Cycles chargement / validation / libération par test (option "--reload-cycles <n>", un par
+// défaut), chacun dans son SwJsonSchemaContext : les instances de SwJsonSchema, registres et
+// noeuds détenus doivent revenir à leur valeur d'avant le cycle
+//--------------------------------------------------------------------
+static int g_reloadCycles = 1;
+
+//--------------------------------------------------------------------
+// Échéance de chaque validation en ms (option "--timeout <ms>"), -1 = aucune
+//--------------------------------------------------------------------
+static qint64 g_timeoutMs = -1;
+
+//--------------------------------------------------------------------
+// Représentation des données validées (option "--document <json|variant|cbor>") :
+// les données sont converties avant la mesure, puis validées par validateDocument()
+//--------------------------------------------------------------------
+enum class DocumentKind { Json, Variant, Cbor };
+static DocumentKind g_document = DocumentKind::Json;
+
+//--------------------------------------------------------------------
+// Écrit la trace d'une validation (Chrome trace JSON + folded stacks)
+//--------------------------------------------------------------------
+static void writeTrace(const SwJsonSchemaTrace &trace, const QString &testDirName, const QString &dataFile)
+{
+    // Les noms de la suite officielle ("draft2020-12/allOf", descriptions) ne sont pas des noms de fichier
+    QString name = testDirName + "_" + QFileInfo(dataFile).completeBaseName();
+    name.replace(QRegularExpression("[^A-Za-z0-9_.-]"), "_");
+    QString baseName = QDir(g_traceDir).absoluteFilePath(name);
+
+    QFile chromeFile(baseName + ".trace.json");
+    if (chromeFile.open(QIODevice::WriteOnly)) {
+        chromeFile.write(trace.toChromeTraceJson());
+        chromeFile.close();
+    }
+    QFile foldedFile(baseName + ".folded");
+    if (foldedFile.open(QIODevice::WriteOnly)) {
+        foldedFile.write(trace.toFoldedStacks());
+        foldedFile.close();
+    }
+}
+
+//--------------------------------------------------------------------
+// Valide une donnée et compare le résultat à l'attendu
+//   dataFile : nom du fichier de données, ou du cas pour la suite officielle
+//--------------------------------------------------------------------
+static ValidationResult validateValue(
+    const SwJsonSchema &schema,
+    const QString      &testDirName,
+    const QString      &dataFile,
+    const QJsonValue   &value,
+    bool               expectedToPass)
+{
+    ValidationResult result;
+    result.testDirName  = testDirName;  // ex: "test_1"
+    result.dataFileName = dataFile;     // ex: "validA.json"
+    result.success      = true;         // on suppose "true", on ajustera ensuite
+
+    // Valider l'objet JSON
+    QString errorMsg;
+    SwJsonSchemaTrace trace;
+    SwJsonSchema::MemoStatistics memoStats;
+    SwJsonSchema::ValidationOptions options;
+    options.trace = g_traceDir.isEmpty() ? nullptr : &trace;
+    options.memoize = g_memoize;
+    options.memoStatistics = &memoStats;
+    if (g_timeoutMs >= 0) {
+        options.deadline = QDeadlineTimer(g_timeoutMs);
+    }
+    const QVariant variant = g_document == DocumentKind::Variant ? value.toVariant() : QVariant();
+    const QCborValue cbor = g_document == DocumentKind::Cbor ? QCborValue::fromJsonValue(value) : QCborValue();
+    QElapsedTimer timer;
+    timer.start();
+    SwJsonSchema::ValidationResult validation;
+    if (g_document == DocumentKind::Variant) {
+        validation = schema.validateDocumentWithResult(variant, options);
+    } else if (g_document == DocumentKind::Cbor) {
+        validation = schema.validateDocumentWithResult(cbor, options);
+    } else {
+        validation = schema.validateWithResult(value, options);
+    }
+    result.elapsedNs = timer.nsecsElapsed();
+    bool actualValidation = validation.isValid();
+    errorMsg = validation.errorMessage;
+    if (options.trace) {
+        writeTrace(trace, testDirName, dataFile);
+    }
+    g_memoHits.fetchAndAddRelaxed(memoStats.hits);
+    g_memoMisses.fetchAndAddRelaxed(memoStats.misses);
+
+    // Seconde validation servie par le cache de résultats : elle doit rendre le même verdict
+    SwJsonSchema::ValidationResult cached;
+    bool cachedDiffers = false;
+    if (g_resultCacheEntries > 0 && g_document == DocumentKind::Json && !validation.isInterrupted()) {
+        cached = schema.validateWithResult(value, options);
+        cachedDiffers = cached.status != validation.status || cached.errorMessage != validation.errorMessage;
+    }
+
+    // Une validation interrompue n'a pas de résultat : échec quel que soit l'attendu
+    if (validation.isInterrupted()) {
+        result.success = false;
+        result.error   = QString("Le JSON '%1' n'a pas pu être validé : %2").arg(dataFile).arg(errorMsg);
+    }
+    else if (cachedDiffers) {
+        result.success = false;
+        result.error   = QString("Le JSON '%1' reçoit un autre résultat depuis le cache : %2")
+                             .arg(dataFile)
+                             .arg(cached.errorMessage.isEmpty() ? "(non spécifiée)" : cached.errorMessage);
+    }
+    // On compare le résultat réel (actualValidation) à l'attendu (expectedToPass)
+    else if (actualValidation != expectedToPass) {
+        // Echec si ça ne match pas l'attendu
+        result.success = false;
+        if (actualValidation) {
+            // On a validé un JSON qu'on s'attendait à voir échouer
+            result.error = QString("Le JSON '%1' est validé alors qu'il devait échouer.")
+                               .arg(dataFile);
+        } else {
+            // On a rejeté un JSON qu'on s'attendait à voir réussir
+            result.error = QString("Le JSON '%1' est rejeté alors qu'il devait réussir. Erreur: %2")
+                               .arg(dataFile)
+                               .arg(errorMsg.isEmpty() ? "(non spécifiée)" : errorMsg);
+        }
+    }
+
+    return result;
+}
+
 //--------------------------------------------------------------------
 // Sous-fonction pour valider un répertoire
 //   ex : data_success/ => expectedToPass = true
@@ -82,45 +257,148 @@ static QList<ValidationResult> validateDataDirectory(
         QString dataParseError;
         QJsonDocument dataDoc = loadJsonDocument(dataFilePath, &dataOk, &dataParseError);
 
-        ValidationResult result;
-        result.testDirName  = testDirName;  // ex: "test_1"
-        result.dataFileName = dataFile;     // ex: "validA.json"
-        result.success      = true;         // on suppose "true", on ajustera ensuite
-
         if (!dataOk) {
             // Echec de chargement du JSON
-            result.success = false;
-            result.error   = dataParseError;
+            ValidationResult result;
+            result.testDirName  = testDirName;  // ex: "test_1"
+            result.dataFileName = dataFile;     // ex: "validA.json"
+            result.success      = false;
+            result.error        = dataParseError;
             results << result;
             continue;
         }
 
-        // Valider l'objet JSON
-        QString errorMsg;
-        bool actualValidation = schema.validate(dataDoc.object(), &errorMsg);
+        results << validateValue(schema, testDirName, dataFile, dataDoc.object(), expectedToPass);
+    }
 
-        // On compare le résultat réel (actualValidation) à l'attendu (expectedToPass)
-        if (actualValidation != expectedToPass) {
-            // Echec si ça ne match pas l'attendu
-            result.success = false;
-            if (actualValidation) {
-                // On a validé un JSON qu'on s'attendait à voir échouer
-                result.error = QString("Le JSON '%1' est validé alors qu'il devait échouer.")
-                                   .arg(dataFile);
-            } else {
-                // On a rejeté un JSON qu'on s'attendait à voir réussir
-                result.error = QString("Le JSON '%1' est rejeté alors qu'il devait réussir. Erreur: %2")
-                                   .arg(dataFile)
-                                   .arg(errorMsg.isEmpty() ? "(non spécifiée)" : errorMsg);
-            }
+    return results;
+}
+
+//--------------------------------------------------------------------
+// Répertoire de test réparti sur plusieurs fichiers (présence de "loader.json") : le schéma
+// est chargé par SwJsonSchemaLoader, dont les statistiques et les erreurs sont comparées
+// aux attendus de loader.json ("documents", "links", "errors" : fichiers cités)
+//--------------------------------------------------------------------
+static bool usesLoader(const QString &testDirPath)
+{
+    return QFileInfo::exists(QDir(testDirPath).absoluteFilePath("loader.json"));
+}
+
+static QList<ValidationResult> runLoaderDirectory(const QString &testDirPath)
+{
+    QList<ValidationResult> results;
+    const QString testDirName = QFileInfo(testDirPath).fileName();
+    const QString schemaFilePath = QDir(testDirPath).absoluteFilePath("main.json");
+
+    SwJsonSchemaLoader loader;
+    loader.load(schemaFilePath);
+
+    // 1) Phases de découverte et de liaison
+    ValidationResult r;
+    r.testDirName  = testDirName;
+    r.dataFileName = "loader.json";
+    bool expectedOk = false;
+    const QJsonObject expected = loadJsonDocument(QDir(testDirPath).absoluteFilePath("loader.json"), &expectedOk, &r.error).object();
+    QStringList mismatches;
+    const SwJsonSchemaLoader::Statistics statistics = loader.statistics();
+    if (statistics.documents != expected.value("documents").toInt()) {
+        mismatches << QString("%1 documents attendus, %2 rencontrés").arg(expected.value("documents").toInt()).arg(statistics.documents);
+    }
+    if (statistics.links != expected.value("links").toInt()) {
+        mismatches << QString("%1 $ref liées attendues, %2 obtenues").arg(expected.value("links").toInt()).arg(statistics.links);
+    }
+    const QStringList errors = loader.errors();
+    const QJsonArray expectedErrors = expected.value("errors").toArray();
+    for (const QJsonValue &file : expectedErrors) {
+        if (errors.filter(file.toString()).isEmpty()) {
+            mismatches << QString("Erreur attendue pour %1").arg(file.toString());
         }
+    }
+    if (errors.size() != expectedErrors.size()) {
+        mismatches << QString("Erreurs obtenues : %1").arg(errors.join(" ; "));
+    }
+    if (expectedOk) {
+        r.error = mismatches.join("\n");
+    }
+    r.success = expectedOk && mismatches.isEmpty();
+    results << r;
 
-        results << result;
+    // 2) Données, validées par le schéma racine lié
+    const SwJsonSchema *schema = loader.schema(schemaFilePath);
+    if (!schema) {
+        r.dataFileName = "main.json";
+        r.success      = false;
+        r.error        = "Echec du chargement par SwJsonSchemaLoader : " + errors.join(" ; ");
+        results << r;
+        return results;
     }
+    results.append( validateDataDirectory(*schema, testDirName, QDir(testDirPath).absoluteFilePath("data_success"), true) );
+    results.append( validateDataDirectory(*schema, testDirName, QDir(testDirPath).absoluteFilePath("data_fail"), false) );
 
+    if (g_memory) {
+        const SwJsonSchema::MemoryUsage usage = schema->memoryUsage();
+        QMutexLocker locker(&g_memoryMutex);
+        g_memoryUsage.insert(testDirName, usage);
+    }
     return results;
 }
 
+//--------------------------------------------------------------------
+// Recharge le schéma d'un test dans un contexte neuf, valide ses données puis le détruit,
+// g_reloadCycles fois ; rend les validations qui ne donnent pas le résultat attendu et les
+// cycles qui laissent des instances, registres ou noeuds derrière eux. Exécuté en série,
+// après les tests : les compteurs du processus ne voient que ce cycle.
+//--------------------------------------------------------------------
+static QList<ValidationResult> runReloadCycles(const QString &testDirPath, const QString &testDirName)
+{
+    QList<ValidationResult> failures;
+    const QString schemaFilePath = QDir(testDirPath).absoluteFilePath("main.json");
+    for (int cycle = 1; cycle <= g_reloadCycles; ++cycle) {
+        const int instancesBefore = SwJsonSchema::liveInstances();
+        const SwJsonSchemaContext::Statistics liveBefore = SwJsonSchemaContext::liveStatistics();
+        {
+            // Test multi-fichiers : le chargeur a son propre contexte
+            SwJsonSchemaContext context;
+            SwJsonSchemaLoader loader;
+            QScopedPointer<SwJsonSchema> owned;
+            const SwJsonSchema *schema = nullptr;
+            if (usesLoader(testDirPath)) {
+                loader.load(schemaFilePath);
+                schema = loader.schema(schemaFilePath);
+            } else {
+                owned.reset(new SwJsonSchema(context, schemaFilePath));
+                schema = owned->isValide() ? owned.data() : nullptr;
+            }
+            if (!schema) {
+                // Signalé par le chargement principal
+                break;
+            }
+            QList<ValidationResult> results;
+            results.append( validateDataDirectory(*schema, testDirName, QDir(testDirPath).absoluteFilePath("data_success"), true) );
+            results.append( validateDataDirectory(*schema, testDirName, QDir(testDirPath).absoluteFilePath("data_fail"), false) );
+            for (ValidationResult &r : results) {
+                if (!r.success) {
+                    r.dataFileName = QString("%1 (cycle %2)").arg(r.dataFileName).arg(cycle);
+                    failures << r;
+                }
+            }
+        }
+        const SwJsonSchemaContext::Statistics liveAfter = SwJsonSchemaContext::liveStatistics();
+        const int instances = SwJsonSchema::liveInstances() - instancesBefore;
+        if (instances != 0 || liveAfter.registries != liveBefore.registries || liveAfter.nodes != liveBefore.nodes) {
+            ValidationResult r;
+            r.testDirName = testDirName;
+            r.dataFileName = QString("main.json (cycle %1)").arg(cycle);
+            r.success = false;
+            r.error = QString("Non libérés avec le contexte : %1 instances de SwJsonSchema, %2 registres, %3 noeuds")
+                          .arg(instances).arg(liveAfter.registries - liveBefore.registries)
+                          .arg(liveAfter.nodes - liveBefore.nodes);
+            failures << r;
+        }
+    }
+    return failures;
+}
+
 //--------------------------------------------------------------------
 // Fonction pour traiter un répertoire de test :
 //    1) Charger le schéma "main.json"
@@ -128,11 +406,15 @@ static QList<ValidationResult> validateDataDirectory(
 //--------------------------------------------------------------------
 static QList<ValidationResult> runTestDirectory(const QString &testDirPath)
 {
+    if (usesLoader(testDirPath)) {
+        return runLoaderDirectory(testDirPath);
+    }
     QList<ValidationResult> results;
 
     // 1) Charger le schéma principal via SwJsonSchema
     QString schemaFilePath = QDir(testDirPath).absoluteFilePath("main.json");
     SwJsonSchema schema(schemaFilePath);
+    schema.setResultCache(g_resultCacheEntries);
     if (!schema.isValide()) {
         // Impossible de charger le schéma => On marque l'échec global
         ValidationResult r;
@@ -152,14 +434,1166 @@ static QList<ValidationResult> runTestDirectory(const QString &testDirPath)
     // 2b) Valider tous les fichiers dans data_fail (expectedToPass = false)
     QString dataFailDirPath = QDir(testDirPath).absoluteFilePath("data_fail");
     results.append( validateDataDirectory(schema, testDirName, dataFailDirPath, false) );
+    collectResultCacheStatistics(schema);
+
+    if (g_memory) {
+        const SwJsonSchema::MemoryUsage usage = schema.memoryUsage();
+        QMutexLocker locker(&g_memoryMutex);
+        g_memoryUsage.insert(testDirName, usage);
+    }
+
+    return results;
+}
+
+//--------------------------------------------------------------------
+// Suite officielle JSON-Schema-Test-Suite : un fichier <draft>/<mot-clé>.json contient
+// [{ "description", "schema", "tests": [{ "description", "data", "valid" }] }]
+//   testDirName = "<draft>/<fichier sans .json>", dataFileName = "<groupe> / <cas>"
+//--------------------------------------------------------------------
+static QList<ValidationResult> runSuiteFile(const QString &filePath, const QString &suiteName,
+                                            QList<QSharedPointer<SwJsonSchema>> &keepAlive)
+{
+    QList<ValidationResult> results;
+
+    bool ok = false;
+    QString parseError;
+    QJsonDocument doc = loadJsonDocument(filePath, &ok, &parseError);
+    if (!ok || !doc.isArray()) {
+        ValidationResult r;
+        r.testDirName  = suiteName;
+        r.dataFileName = QFileInfo(filePath).fileName();
+        r.success      = false;
+        r.error        = ok ? QString("Le fichier n'est pas un tableau de groupes de tests.") : parseError;
+        results << r;
+        return results;
+    }
+
+    const QJsonArray groups = doc.array();
+    for (int g = 0; g < groups.size(); ++g) {
+        const QJsonObject group = groups.at(g).toObject();
+        const QString groupName = group.value("description").toString();
+
+        // Les schémas booléens et {} deviennent des objets non vides. Sans "$id", un schéma
+        // chargé depuis un objet a pour base l'URI vide : chaque groupe reçoit la sienne,
+        // relative au fichier de la suite.
+        const QJsonValue schemaValue = group.value("schema");
+        QJsonObject schemaObject = schemaValue.toObject();
+        if (schemaValue.isBool() && !schemaValue.toBool()) {
+            schemaObject.insert("not", true);
+        }
+        if (!schemaObject.contains("$id")) {
+            const QString groupPath = QFileInfo(filePath).absolutePath() + "/" + QFileInfo(filePath).completeBaseName()
+                                      + QString("/%1.json").arg(g);
+            schemaObject.insert("$id", QUrl::fromLocalFile(groupPath).toString());
+        }
+        QSharedPointer<SwJsonSchema> schema(new SwJsonSchema(schemaObject));
+        // Conservé jusqu'à la fin de l'unité : les registres gardent l'adresse de ses noeuds
+        keepAlive << schema;
+        schema->setResultCache(g_resultCacheEntries);
+
+        for (const QJsonValue &testValue : group.value("tests").toArray()) {
+            const QJsonObject test = testValue.toObject();
+            const QString caseName = groupName + " / " + test.value("description").toString();
+            if (!schema->isValide()) {
+                ValidationResult r;
+                r.testDirName  = suiteName;
+                r.dataFileName = caseName;
+                r.success      = false;
+                r.error        = "Echec de l'initialisation du schéma (isValide() == false).";
+                results << r;
+                continue;
+            }
+            results << validateValue(*schema, suiteName, caseName, test.value("data"), test.value("valid").toBool());
+        }
+        collectResultCacheStatistics(*schema);
+    }
+    return results;
+}
+
+//--------------------------------------------------------------------
+// Unité de travail parallèle : répertoires de test (ou fichiers de la suite) exécutés
+// en série sur un même thread. Chaque schéma racine a ses propres registres de $ref ; les
+// schémas qui déclarent le même "$id" restent regroupés, comme dans un contexte partagé.
+//--------------------------------------------------------------------
+struct TestUnit
+{
+    QStringList paths;         // Répertoires de test, ou fichiers de la suite
+    QStringList names;         // testDirName de chaque chemin
+    bool        suite = false;
+};
+
+static void collectIds(const QJsonValue &value, QSet<QString> &ids)
+{
+    if (value.isArray()) {
+        for (const QJsonValue &item : value.toArray()) {
+            collectIds(item, ids);
+        }
+    } else if (value.isObject()) {
+        const QJsonObject obj = value.toObject();
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            if (it.key() == "$id" && it.value().isString()) {
+                ids.insert(it.value().toString().trimmed().toLower());
+            } else {
+                collectIds(it.value(), ids);
+            }
+        }
+    }
+}
+
+/// Regroupe les chemins qui partagent un "$id" (schéma principal, ou schémas de la suite).
+static QList<TestUnit> groupBySharedId(const QStringList &paths, const QStringList &names, bool suite)
+{
+    QVector<int> owner(paths.size());
+    for (int i = 0; i < owner.size(); ++i) {
+        owner[i] = i;
+    }
+    std::function<int(int)> find = [&](int i) {
+        return owner[i] == i ? i : (owner[i] = find(owner[i]));
+    };
+
+    QHash<QString, int> firstWithId;
+    for (int i = 0; i < paths.size(); ++i) {
+        const QString schemaPath = suite ? paths.at(i) : QDir(paths.at(i)).absoluteFilePath("main.json");
+        QJsonDocument doc = loadJsonDocument(schemaPath);
+        QSet<QString> ids;
+        collectIds(doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object()), ids);
+        for (const QString &id : ids) {
+            auto it = firstWithId.find(id);
+            if (it == firstWithId.end()) {
+                firstWithId.insert(id, i);
+            } else {
+                owner[find(i)] = find(it.value());
+            }
+        }
+    }
+
+    QList<TestUnit> units;
+    QHash<int, int> unitOfRoot;
+    for (int i = 0; i < paths.size(); ++i) {
+        const int root = find(i);
+        if (!unitOfRoot.contains(root)) {
+            unitOfRoot.insert(root, units.size());
+            TestUnit unit;
+            unit.suite = suite;
+            units << unit;
+        }
+        TestUnit &unit = units[unitOfRoot.value(root)];
+        unit.paths << paths.at(i);
+        unit.names << names.at(i);
+    }
+    return units;
+}
+
+static QList<ValidationResult> runTestUnit(const TestUnit &unit)
+{
+    QList<ValidationResult> results;
+    QList<QSharedPointer<SwJsonSchema>> keepAlive;
+    for (int i = 0; i < unit.paths.size(); ++i) {
+        if (unit.suite) {
+            results.append(runSuiteFile(unit.paths.at(i), unit.names.at(i), keepAlive));
+        } else {
+            results.append(runTestDirectory(unit.paths.at(i)));
+        }
+    }
+    return results;
+}
+
+//--------------------------------------------------------------------
+// Scénarios : vérifications de l'API qu'un répertoire de tests ne peut pas exprimer
+// (bornes, annulation, caches, rechargement...). Exécutés en série après les tests,
+// car certains modifient des réglages globaux de SwJsonSchema (qu'ils rétablissent).
+// Chaque scénario rend la liste de ses écarts, vide en cas de succès.
+//--------------------------------------------------------------------
+typedef SwJsonSchema::ValidationResult::Status ScenarioStatus;
+
+static QJsonObject scenarioObject(const char *json)
+{
+    return QJsonDocument::fromJson(QByteArray(json)).object();
+}
+
+static QJsonValue scenarioValue(const char *json)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(QByteArray(json));
+    return doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+}
+
+/// Répertoire vide propre au scénario `name`, sous le répertoire temporaire.
+static QDir scenarioDirectory(const QString &name)
+{
+    QDir dir(QDir(QDir::tempPath()).absoluteFilePath("JwJsonSchema_scenarios/" + name));
+    dir.removeRecursively();
+    dir.mkpath(".");
+    return dir;
+}
+
+/// Écrit `json` dans le fichier `fileName` de `dir` et rend son chemin absolu.
+static QString writeScenarioFile(const QDir &dir, const QString &fileName, const char *json)
+{
+    const QString path = dir.absoluteFilePath(fileName);
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(json);
+    }
+    return path;
+}
+
+/// Ajoute un écart à `failures` si la validation de `value` ne rend pas `expected`.
+static void expectStatus(QStringList &failures, const QString &label, const SwJsonSchema &schema,
+                         const QJsonValue &value, const SwJsonSchema::ValidationOptions &options,
+                         ScenarioStatus expected)
+{
+    const SwJsonSchema::ValidationResult result = schema.validateWithResult(value, options);
+    if (result.status != expected) {
+        failures << QString("%1 : statut %2 attendu, %3 obtenu (%4)")
+                        .arg(label).arg(int(expected)).arg(int(result.status)).arg(result.errorMessage);
+    }
+}
+
+// Bornes de ValidationLimits : chaque borne dépassée rend LimitExceeded, le même
+// document sans borne garde son résultat.
+static QStringList scenarioLimits()
+{
+    QStringList failures;
+    SwJsonSchema::ValidationOptions unlimited;
+
+    SwJsonSchema::ValidationOptions depth;
+    depth.limits.maxDepth = 3;
+    SwJsonSchema nested(scenarioObject(R"({ "$defs": { "liste": { "type": "array", "items": { "$ref": "#/$defs/liste" } } },
+                                              "$ref": "#/$defs/liste" })"));
+    const QJsonValue deep = scenarioValue("[[[[[[]]]]]]");
+    expectStatus(failures, "maxDepth", nested, deep, depth, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxDepth (sans borne)", nested, deep, unlimited, ScenarioStatus::Valid);
+    expectStatus(failures, "maxDepth (sous la borne)", nested, scenarioValue("[[[]]]"), depth, ScenarioStatus::Valid);
+
+    SwJsonSchema::ValidationOptions steps;
+    steps.limits.maxEvaluationSteps = 4;
+    SwJsonSchema combined(scenarioObject(R"({ "allOf": [ { "minimum": 0 }, { "maximum": 9 }, { "type": "integer" },
+                                                        { "not": { "const": 5 } }, { "multipleOf": 1 } ] })"));
+    expectStatus(failures, "maxEvaluationSteps", combined, QJsonValue(3), steps, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxEvaluationSteps (sans borne)", combined, QJsonValue(3), unlimited, ScenarioStatus::Valid);
+
+    SwJsonSchema::ValidationOptions length;
+    length.limits.maxPatternLength = 8;
+    SwJsonSchema patterns(scenarioObject(R"({
+        "type": "object",
+        "properties": {
+            "code": { "type": "string", "pattern": "^[a-z]+$" },
+            "mail": { "type": "string", "format": "email" },
+            "libre": { "type": "string" }
+        },
+        "patternProperties": { "^x-": { "type": "string" } },
+        "additionalProperties": { "type": "integer" }
+    })"));
+    expectStatus(failures, "maxPatternLength (pattern)", patterns,
+                 scenarioValue(R"({ "code": "abcdefghijkl" })"), length, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxPatternLength (format)", patterns,
+                 scenarioValue(R"({ "mail": "nom@exemple.fr" })"), length, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxPatternLength (clé de patternProperties)", patterns,
+                 scenarioValue(R"({ "x-tres-longue-cle": "v" })"), length, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxPatternLength (chaîne sans expression)", patterns,
+                 scenarioValue(R"({ "libre": "une chaîne bien plus longue", "code": "abc", "x-a": "v", "n": 1 })"),
+                 length, ScenarioStatus::Valid);
+    expectStatus(failures, "maxPatternLength (sans borne)", patterns,
+                 scenarioValue(R"({ "code": "abcdefghijkl", "mail": "nom@exemple.fr", "x-tres-longue-cle": "v" })"),
+                 unlimited, ScenarioStatus::Valid);
+
+    SwJsonSchema::ValidationOptions size;
+    size.limits.maxArrayItems = 3;
+    size.limits.maxObjectProperties = 2;
+    SwJsonSchema containers(scenarioObject(R"({ "type": ["array", "object"] })"));
+    expectStatus(failures, "maxArrayItems", containers, scenarioValue("[1, 2, 3, 4]"), size, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxObjectProperties", containers,
+                 scenarioValue(R"({ "a": 1, "b": 2, "c": 3 })"), size, ScenarioStatus::LimitExceeded);
+    expectStatus(failures, "maxArrayItems (sous la borne)", containers, scenarioValue("[1, 2, 3]"), size, ScenarioStatus::Valid);
+    expectStatus(failures, "taille (sans borne)", containers, scenarioValue("[1, 2, 3, 4]"), unlimited, ScenarioStatus::Valid);
+    return failures;
+}
+
+// Cache de résultats : servi sans bornes, contourné avec des bornes, jamais alimenté par
+// un document plus grand que maxPayloadBytes.
+static QStringList scenarioResultCache()
+{
+    QStringList failures;
+    SwJsonSchema schema(scenarioObject(R"({ "type": "array", "items": { "type": "integer" } })"));
+    schema.setResultCache(8, 64);
+    const QJsonValue small = scenarioValue("[1, 2, 3, 4]");
+
+    SwJsonSchema::MemoStatistics memo;
+    SwJsonSchema::ValidationOptions options;
+    options.memoize = true;
+    options.memoStatistics = &memo;
+    expectStatus(failures, "premier passage", schema, small, options, ScenarioStatus::Valid);
+    if (memo.misses == 0) {
+        failures << "premier passage : aucune évaluation comptée";
+    }
+    expectStatus(failures, "depuis le cache", schema, small, options, ScenarioStatus::Valid);
+    if (schema.resultCacheStatistics().hits != 1) {
+        failures << QString("depuis le cache : 1 succès attendu, %1 obtenus").arg(schema.resultCacheStatistics().hits);
+    }
+    if (memo.hits != 0 || memo.misses != 0 || memo.entries != 0) {
+        failures << "depuis le cache : memoStatistics non remis à zéro";
+    }
+
+    SwJsonSchema::ValidationOptions limited;
+    limited.limits.maxArrayItems = 2;
+    expectStatus(failures, "avec bornes", schema, small, limited, ScenarioStatus::LimitExceeded);
+    if (schema.resultCacheStatistics().hits != 1) {
+        failures << "avec bornes : le cache a été consulté";
+    }
+    limited.limits.maxArrayItems = 10;
+    expectStatus(failures, "avec bornes respectées", schema, small, limited, ScenarioStatus::Valid);
+
+    QJsonArray large;
+    for (int i = 0; i < 1000; ++i) {
+        large.append(i);
+    }
+    const int entries = schema.resultCacheStatistics().entries;
+    expectStatus(failures, "document trop grand", schema, large, SwJsonSchema::ValidationOptions(), ScenarioStatus::Valid);
+    if (schema.resultCacheStatistics().entries != entries) {
+        failures << "document trop grand : mis en cache";
+    }
+    return failures;
+}
+
+/// expectStatus() pour le même document parcouru en QJsonValue, QVariant et QCborValue.
+static void expectDocumentStatus(QStringList &failures, const QString &label, const SwJsonSchema &schema,
+                                 const QJsonValue &value, ScenarioStatus expected)
+{
+    const SwJsonSchema::ValidationOptions options;
+    const SwJsonSchema::ValidationResult results[] = {
+        schema.validateDocumentWithResult(value, options),
+        schema.validateDocumentWithResult(value.toVariant(), options),
+        schema.validateDocumentWithResult(QCborValue::fromJsonValue(value), options),
+    };
+    const char *kinds[] = { "json", "variant", "cbor" };
+    for (int i = 0; i < 3; ++i) {
+        if (results[i].status != expected) {
+            failures << QString("%1 (%2) : statut %3 attendu, %4 obtenu (%5)")
+                            .arg(label).arg(kinds[i]).arg(int(expected))
+                            .arg(int(results[i].status)).arg(results[i].errorMessage);
+        }
+    }
+}
+
+// unevaluatedProperties sur un document QVariant ou QCborValue : les annotations de
+// properties, patternProperties, additionalProperties et allOf repèrent les bonnes propriétés.
+static QStringList scenarioUnevaluatedDocuments()
+{
+    QStringList failures;
+    SwJsonSchema schema(scenarioObject(R"({
+        "type": "object",
+        "properties": { "m": { "type": "integer" } },
+        "patternProperties": { "^p": { "type": "integer" } },
+        "allOf": [ { "properties": { "b": { "type": "integer" } } } ],
+        "unevaluatedProperties": false
+    })"));
+    expectDocumentStatus(failures, "propriété hors annotations", schema,
+                         scenarioValue(R"({ "z": 0, "m": 1, "b": 2, "p1": 3 })"), ScenarioStatus::Invalid);
+    expectDocumentStatus(failures, "propriétés évaluées", schema,
+                         scenarioValue(R"({ "m": 1, "b": 2, "p1": 3, "p2": 4 })"), ScenarioStatus::Valid);
+    expectDocumentStatus(failures, "propriété non évaluée", schema,
+                         scenarioValue(R"({ "m": 1, "c": "x", "p1": 3 })"), ScenarioStatus::Invalid);
+    expectDocumentStatus(failures, "propriété déclarée invalide", schema,
+                         scenarioValue(R"({ "m": "x", "b": 2 })"), ScenarioStatus::Invalid);
+
+    // Grand objet : chaque propriété trouve son rang en temps constant
+    QJsonObject large;
+    for (int i = 0; i < 20000; ++i) {
+        large.insert(QString("p%1").arg(i, 5, 10, QChar('0')), i);
+    }
+    large.insert("m", 1);
+    expectDocumentStatus(failures, "grand objet", schema, large, ScenarioStatus::Valid);
+
+    SwJsonSchema additional(scenarioObject(R"({
+        "allOf": [ { "properties": { "m": { "type": "string" } }, "additionalProperties": { "type": "integer" } } ],
+        "unevaluatedProperties": false
+    })"));
+    expectDocumentStatus(failures, "additionalProperties", additional,
+                         scenarioValue(R"({ "a": 1, "m": "x", "z": 2 })"), ScenarioStatus::Valid);
+    expectDocumentStatus(failures, "additionalProperties invalide", additional,
+                         scenarioValue(R"({ "a": 1, "z": "x" })"), ScenarioStatus::Invalid);
+    return failures;
+}
+
+/// Ajoute un écart à `failures` si `report` n'a aucun constat `kind` de gravité `severity` à `location`.
+static void expectFinding(QStringList &failures, const SwJsonSchema::ComplexityReport &report,
+                          SwJsonSchema::ComplexityFinding::Severity severity, const QString &kind,
+                          const QString &location)
+{
+    for (const SwJsonSchema::ComplexityFinding &finding : report.findings) {
+        if (finding.severity == severity && finding.kind == kind && finding.location == location) {
+            return;
+        }
+    }
+    failures << QString("constat %1 (gravité %2) attendu à %3").arg(kind).arg(int(severity)).arg(location);
+}
 
+// analyzeComplexity() : motif catastrophique, récursions imbriquées par patternProperties
+// et additionalProperties, cycle de $ref sans progression.
+static QStringList scenarioComplexity()
+{
+    typedef SwJsonSchema::ComplexityFinding Finding;
+    QStringList failures;
+    const SwJsonSchema::RegexEngine engine = SwJsonSchema::regexEngine();
+    SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Backtracking);
+
+    SwJsonSchema nested(scenarioObject(R"({
+        "$defs": {
+            "noeud": {
+                "type": "object",
+                "properties": { "nom": { "type": "string", "pattern": "^(a+)+$" } },
+                "patternProperties": { "^enfant": { "$ref": "#/$defs/noeud" } },
+                "additionalProperties": { "$ref": "#/$defs/boucle" }
+            },
+            "boucle": { "allOf": [ { "$ref": "#/$defs/retour" } ] },
+            "retour": { "anyOf": [ { "$ref": "#/$defs/boucle" } ] }
+        },
+        "$ref": "#/$defs/noeud"
+    })"));
+    const SwJsonSchema::ComplexityReport report = nested.analyzeComplexity();
+    expectFinding(failures, report, Finding::Critical, "pattern", "#/$defs/noeud/properties/nom/pattern");
+    expectFinding(failures, report, Finding::Info, "recursion", "#/$defs/noeud/patternProperties/^enfant");
+    expectFinding(failures, report, Finding::Critical, "recursion", "#/$defs/retour/anyOf/0");
+
+    // "$ref": "#" applique aussi les patternProperties et additionalProperties de la racine
+    SwJsonSchema recursive(scenarioObject(R"({
+        "type": "object",
+        "patternProperties": { "^n": { "type": "object", "additionalProperties": { "$ref": "#" } } },
+        "additionalProperties": { "type": "object", "properties": { "c": { "$ref": "#" } } }
+    })"));
+    const SwJsonSchema::ComplexityReport recursiveReport = recursive.analyzeComplexity();
+    expectFinding(failures, recursiveReport, Finding::Info, "recursion", "#/patternProperties/^n");
+    expectFinding(failures, recursiveReport, Finding::Info, "recursion", "#/additionalProperties");
+    expectStatus(failures, "patternProperties par \"$ref\": \"#\"", recursive,
+                 scenarioValue(R"({ "n1": { "x": { "n2": 3 } } })"), SwJsonSchema::ValidationOptions(),
+                 ScenarioStatus::Invalid);
+
+    SwJsonSchema::setRegexEngine(engine);
+    return failures;
+}
+
+// Définitions différées : compilées à la première résolution (y compris après la
+// destruction du schéma qui les a déclarées), toutes par prepare(), et leurs motifs non
+// supportés signalés une fois compilées, avec le moteur d'expressions de leur chargement.
+static QStringList scenarioLazyDefinitions()
+{
+    QStringList failures;
+    const SwJsonSchema::RegexEngine engine = SwJsonSchema::regexEngine();
+    const bool lazy = SwJsonSchema::lazyDefinitions();
+    SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::LinearWithFallback);
+    SwJsonSchema::setLazyDefinitions(true);
+
+    const SwJsonSchema::DefinitionStatistics before = SwJsonSchema::definitionStatistics();
+    QScopedPointer<SwJsonSchema> declaring(new SwJsonSchema(scenarioObject(R"({
+        "$id": "https://scenarios.example/differees.json",
+        "type": "object",
+        "properties": {
+            "code": { "$ref": "#/$defs/code" },
+            "quantite": { "$ref": "#/$defs/quantite" }
+        },
+        "$defs": {
+            "code": { "type": "string", "pattern": "^(?=[A-Z])[A-Z0-9]+$" },
+            "quantite": { "type": "integer", "minimum": 1 },
+            "inutilisee": { "type": "null" }
+        }
+    })")));
+    const SwJsonSchema copy(*declaring);
+    declaring.reset();
+    // Les définitions gardent le moteur de leur chargement (LinearWithFallback), pas celui
+    // en vigueur à leur compilation
+    SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Backtracking);
+
+    SwJsonSchema::DefinitionStatistics stats = SwJsonSchema::definitionStatistics();
+    if (stats.deferred - before.deferred != 3 || stats.compiled != before.compiled) {
+        failures << QString("chargement : 3 définitions différées et aucune compilée attendues, %1 / %2 obtenues")
+                        .arg(stats.deferred - before.deferred).arg(stats.compiled - before.compiled);
+    }
+    if (!copy.unsupportedPatterns().isEmpty()) {
+        failures << "chargement : motif signalé par une définition pas encore compilée";
+    }
+
+    // Première résolution depuis plusieurs threads, schéma déclarant détruit
+    QList<int> quantities;
+    for (int i = 0; i < 64; ++i) {
+        quantities << i;
+    }
+    QAtomicInt wrong(0);
+    QtConcurrent::blockingMap(quantities, [&copy, &wrong](int quantity) {
+        const QJsonObject document{{"quantite", quantity}};
+        if (copy.validate(document) != (quantity >= 1)) {
+            wrong.ref();
+        }
+    });
+    if (wrong.loadRelaxed() != 0) {
+        failures << QString("compilation concurrente : %1 résultats faux").arg(wrong.loadRelaxed());
+    }
+    stats = SwJsonSchema::definitionStatistics();
+    if (stats.compiled - before.compiled != 1) {
+        failures << QString("première résolution : 1 compilation attendue, %1 obtenues").arg(stats.compiled - before.compiled);
+    }
+
+    const int nodes = copy.prepare();
+    stats = SwJsonSchema::definitionStatistics();
+    if (stats.compiled - before.compiled != 2) {
+        failures << QString("prepare() : 2 compilations attendues, %1 obtenues").arg(stats.compiled - before.compiled);
+    }
+    if (nodes < 5) {
+        failures << QString("prepare() : au moins 5 noeuds attendus, %1 obtenus").arg(nodes);
+    }
+    const QStringList unsupported = copy.unsupportedPatterns();
+    if (unsupported.size() != 1 || !unsupported.first().contains("#/$defs/code/pattern")) {
+        failures << QString("prepare() : motif de #/$defs/code attendu, obtenu [%1]").arg(unsupported.join(" ; "));
+    }
+    expectStatus(failures, "motif en repli", copy, scenarioValue(R"({ "code": "A12" })"),
+                 SwJsonSchema::ValidationOptions(), ScenarioStatus::Valid);
+    expectStatus(failures, "motif en repli (refusé)", copy, scenarioValue(R"({ "code": "1AB" })"),
+                 SwJsonSchema::ValidationOptions(), ScenarioStatus::Invalid);
+
+    SwJsonSchema::setLazyDefinitions(lazy);
+    SwJsonSchema::setRegexEngine(engine);
+    return failures;
+}
+
+// Schémas booléens : chaque true / false, quel que soit le mot-clé qui le porte, désigne
+// l'un des deux noeuds constants partagés ; aucune instance n'est créée par occurrence.
+static QStringList scenarioBooleanSchemas()
+{
+    QStringList failures;
+    // Crée les deux noeuds constants avant la mesure
+    SwJsonSchema warmUp(scenarioObject(R"({ "properties": { "a": false, "b": true } })"));
+
+    QJsonObject properties;
+    for (int i = 0; i < 200; ++i) {
+        properties.insert(QString("p%1").arg(i), false);
+    }
+    QJsonObject data = scenarioObject(R"({
+        "type": "object",
+        "patternProperties": { "^x-": true, "^y-": false },
+        "allOf": [true, true],
+        "anyOf": [false, true],
+        "oneOf": [true, false]
+    })");
+    data.insert("properties", properties);
+
+    const int instancesBefore = SwJsonSchema::liveInstances();
+    SwJsonSchema schema(data);
+    const int instances = SwJsonSchema::liveInstances() - instancesBefore;
+    if (instances != 1) {
+        failures << QString("%1 instances pour un schéma de 208 booléens (1 attendue : la racine)").arg(instances);
+    }
+    const SwJsonSchema::ValidationOptions options;
+    expectStatus(failures, "objet vide", schema, scenarioValue("{}"), options, ScenarioStatus::Valid);
+    expectStatus(failures, "properties false", schema, scenarioValue(R"({ "p7": 1 })"), options, ScenarioStatus::Invalid);
+    expectStatus(failures, "patternProperties true", schema, scenarioValue(R"({ "x-a": 1 })"), options, ScenarioStatus::Valid);
+    expectStatus(failures, "patternProperties false", schema, scenarioValue(R"({ "y-a": 1 })"), options, ScenarioStatus::Invalid);
+    return failures;
+}
+
+// Partage des sous-schémas : sans partage, chaque occurrence garde son emplacement ; avec,
+// les occurrences identiques réutilisent un noeud, leurs conteneurs comptent
+// une fois dans memoryUsage() et valident de même.
+static QStringList scenarioDeduplication()
+{
+    typedef SwJsonSchema::ComplexityFinding Finding;
+    QStringList failures;
+    const bool dedup = SwJsonSchema::deduplication();
+    const SwJsonSchema::RegexEngine engine = SwJsonSchema::regexEngine();
+    SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Backtracking);
+    const QJsonObject data = scenarioObject(R"({
+        "type": "object",
+        "properties": {
+            "a": { "type": "object", "required": ["x"], "properties": { "x": { "type": "string", "pattern": "^(a+)+$" } } },
+            "b": { "type": "object", "required": ["x"], "properties": { "x": { "type": "string", "pattern": "^(a+)+$" } } }
+        }
+    })");
+    const QJsonValue valid = scenarioValue(R"({ "a": { "x": "aaa" }, "b": { "x": "a" } })");
+    const QJsonValue invalid = scenarioValue(R"({ "a": { "x": "aaa" }, "b": { "x": "b" } })");
+
+    SwJsonSchema::setDeduplication(false);
+    SwJsonSchema::DeduplicationStatistics before = SwJsonSchema::deduplicationStatistics();
+    SwJsonSchema separate(data);
+    if (SwJsonSchema::deduplicationStatistics().subschemas != before.subschemas) {
+        failures << "sans partage : sous-schémas passés par la table de partage";
+    }
+    const SwJsonSchema::ComplexityReport report = separate.analyzeComplexity();
+    expectFinding(failures, report, Finding::Critical, "pattern", "#/properties/a/properties/x/pattern");
+    expectFinding(failures, report, Finding::Critical, "pattern", "#/properties/b/properties/x/pattern");
+
+    SwJsonSchema::setDeduplication(true);
+    before = SwJsonSchema::deduplicationStatistics();
+    SwJsonSchema shared(data);
+    const SwJsonSchema::DeduplicationStatistics after = SwJsonSchema::deduplicationStatistics();
+    if (after.shared - before.shared < 1) {
+        failures << QString("avec partage : au moins un noeud réutilisé attendu, %1 obtenus").arg(after.shared - before.shared);
+    }
+    const SwJsonSchema::MemoryUsage separateUsage = separate.memoryUsage();
+    const SwJsonSchema::MemoryUsage sharedUsage = shared.memoryUsage();
+    if (sharedUsage.nodes > separateUsage.nodes || sharedUsage.totalBytes() >= separateUsage.totalBytes()) {
+        failures << QString("avec partage : %1 noeuds / %2 octets, sans : %3 / %4")
+                        .arg(sharedUsage.nodes).arg(sharedUsage.totalBytes())
+                        .arg(separateUsage.nodes).arg(separateUsage.totalBytes());
+    }
+    const SwJsonSchema::ValidationOptions options;
+    expectStatus(failures, "avec partage (valide)", shared, valid, options, ScenarioStatus::Valid);
+    expectStatus(failures, "avec partage (invalide)", shared, invalid, options, ScenarioStatus::Invalid);
+    expectStatus(failures, "sans partage (invalide)", separate, invalid, options, ScenarioStatus::Invalid);
+
+    SwJsonSchema::setDeduplication(dedup);
+    SwJsonSchema::setRegexEngine(engine);
+    return failures;
+}
+
+// Ensemble routé : routage par valeur et par $id (sans la casse), discriminant absent ou
+// inconnu, valeur routée deux fois, et validateAll() appelé depuis une tâche de son
+// propre pool réduit à un thread.
+static QStringList scenarioSchemaSet()
+{
+    QStringList failures;
+    QDir dir = scenarioDirectory("ensemble");
+    writeScenarioFile(dir, "commun.json", R"({ "definitions": { "code": { "type": "string", "pattern": "^[A-Z]{3}$" } } })");
+    const QString order = writeScenarioFile(dir, "commande.json", R"({
+        "$id": "urn:Exemple:Commande",
+        "type": "object",
+        "required": ["devise"],
+        "properties": { "devise": { "type": "string", "pattern": "^[A-Z]{3}$" } }
+    })");
+    const QString delivery = writeScenarioFile(dir, "livraison.json", R"({
+        "type": "object",
+        "required": ["adresse", "pays"],
+        "properties": {
+            "adresse": { "type": "string", "minLength": 1 },
+            "pays": { "$ref": "commun.json#/definitions/code" }
+        }
+    })");
+    const QString sameId = writeScenarioFile(dir, "doublon.json", R"({ "$id": "urn:exemple:commande", "type": "object" })");
+
+    QThreadPool *pool = new QThreadPool;
+    pool->setMaxThreadCount(1);
+    {
+        SwJsonSchemaSet set("/$schema", pool);
+        set.addSchema(order);
+        set.addSchema("livraison", delivery);
+        if (!set.load()) {
+            failures << "chargement : " + set.errors().join(" ; ");
+        }
+        struct Message { const char *label; const char *json; bool valid; };
+        static const Message messages[] = {
+            { "$id, casse d'origine", R"({ "$schema": "urn:Exemple:Commande", "devise": "EUR" })", true },
+            { "$id, autre casse", R"({ "$schema": "urn:exemple:commande", "devise": "EUR" })", true },
+            { "$id, document refusé", R"({ "$schema": "URN:EXEMPLE:COMMANDE", "devise": "euro" })", false },
+            { "valeur", R"({ "$schema": "livraison", "adresse": "1 rue de la Paix", "pays": "FRA" })", true },
+            { "valeur, document refusé", R"({ "$schema": "livraison", "adresse": "1 rue de la Paix", "pays": "fr" })", false },
+            { "valeur, casse exacte exigée", R"({ "$schema": "Livraison", "adresse": "1 rue de la Paix", "pays": "FRA" })", false },
+            { "discriminant inconnu", R"({ "$schema": "urn:exemple:facture", "devise": "EUR" })", false },
+            { "discriminant absent", R"({ "devise": "EUR" })", false },
+        };
+        QVector<QJsonValue> batch;
+        QVector<ScenarioStatus> expected;
+        for (const Message &message : messages) {
+            QString error;
+            const QJsonValue value = scenarioValue(message.json);
+            if (set.validate(value, &error) != message.valid) {
+                failures << QString("%1 : %2 attendu (%3)").arg(message.label, message.valid ? "valide" : "invalide", error);
+            }
+            for (int copy = 0; copy < 40; ++copy) {
+                batch << value;
+                expected << (message.valid ? ScenarioStatus::Valid : ScenarioStatus::Invalid);
+            }
+        }
+        QString unknown;
+        set.validate(scenarioValue(R"({ "$schema": "urn:exemple:facture" })"), &unknown);
+        if (!unknown.contains("urn:exemple:facture")) {
+            failures << "discriminant inconnu : valeur absente du message (" + unknown + ")";
+        }
+        if (set.schema("URN:EXEMPLE:COMMANDE") != set.schema("urn:Exemple:Commande") || !set.schema("urn:exemple:commande")) {
+            failures << "schema($id) : recherche sensible à la casse";
+        }
+
+        // Une seule tâche possible : validateAll() ne doit pas attendre une tâche en file
+        QVector<SwJsonSchema::ValidationResult> results;
+        QtConcurrent::run(pool, [&set, &batch, &results]() { results = set.validateAll(batch); });
+        if (!pool->waitForDone(10000)) {
+            failures << "validateAll depuis une tâche du pool : bloqué";
+            return failures;  // Pool volontairement abandonné : sa tâche ne finira pas
+        }
+        for (int i = 0; i < batch.size(); ++i) {
+            if (i >= results.size() || results.at(i).status != expected.at(i)) {
+                failures << QString("validateAll : résultat %1 différent de validate()").arg(i);
+                break;
+            }
+        }
+    }
+    {
+        SwJsonSchemaSet set("/type", pool);
+        set.addSchema("livraison", delivery);
+        set.addSchema("livraison", order);
+        if (set.load() || !set.errors().join("\n").contains("déjà attribuée")) {
+            failures << "valeur routée vers deux schémas acceptée";
+        }
+        if (set.schema("livraison") == nullptr) {
+            failures << "valeur en double : la première attribution doit rester";
+        }
+    }
+    {
+        SwJsonSchemaSet set("/$schema", pool);
+        set.addSchema(order);
+        set.addSchema(sameId);
+        if (set.load() || !set.errors().join("\n").contains("déjà attribuée")) {
+            failures << "$id ne différant que par la casse routé vers deux schémas";
+        }
+    }
+    delete pool;
+    dir.removeRecursively();
+    return failures;
+}
+
+// Contextes isolés : deux schémas de même $id, puis le même fichier relu après
+// modification de sa $ref externe, chacun dans son contexte ; tout est libéré avec eux.
+// Sans contexte, chaque racine a le sien, partagé par ses copies.
+static QStringList scenarioIsolatedContexts()
+{
+    QStringList failures;
+    const int instancesBefore = SwJsonSchema::liveInstances();
+    const SwJsonSchemaContext::Statistics liveBefore = SwJsonSchemaContext::liveStatistics();
+    QDir dir = scenarioDirectory("contextes");
+    {
+        SwJsonSchemaContext first;
+        SwJsonSchemaContext second;
+        const QJsonObject shortObject = scenarioObject(R"({
+            "$id": "urn:exemple:isolation",
+            "properties": { "code": { "$ref": "#/$defs/code" } },
+            "$defs": { "code": { "type": "string", "maxLength": 2 } }
+        })");
+        const QJsonObject longObject = scenarioObject(R"({
+            "$id": "urn:exemple:isolation",
+            "properties": { "code": { "$ref": "#/$defs/code" } },
+            "$defs": { "code": { "type": "string", "minLength": 3 } }
+        })");
+        const SwJsonSchema shortCodes(first, shortObject);
+        const SwJsonSchema longCodes(second, longObject);
+        const SwJsonSchema::ValidationOptions options;
+        const QJsonValue shortCode = scenarioValue(R"({ "code": "FR" })");
+        const QJsonValue longCode = scenarioValue(R"({ "code": "FRA" })");
+        expectStatus(failures, "même $id, premier contexte (court)", shortCodes, shortCode, options, ScenarioStatus::Valid);
+        expectStatus(failures, "même $id, premier contexte (long)", shortCodes, longCode, options, ScenarioStatus::Invalid);
+        expectStatus(failures, "même $id, second contexte (court)", longCodes, shortCode, options, ScenarioStatus::Invalid);
+        expectStatus(failures, "même $id, second contexte (long)", longCodes, longCode, options, ScenarioStatus::Valid);
+
+        QScopedPointer<SwJsonSchema> ownShort(new SwJsonSchema(shortObject));
+        const SwJsonSchema ownLong(longObject);
+        const SwJsonSchema ownShortCopy(*ownShort);
+        ownShort.reset();
+        expectStatus(failures, "même $id sans contexte, copie (court)", ownShortCopy, shortCode, options, ScenarioStatus::Valid);
+        expectStatus(failures, "même $id sans contexte, copie (long)", ownShortCopy, longCode, options, ScenarioStatus::Invalid);
+        expectStatus(failures, "même $id sans contexte (court)", ownLong, shortCode, options, ScenarioStatus::Invalid);
+        expectStatus(failures, "même $id sans contexte (long)", ownLong, longCode, options, ScenarioStatus::Valid);
+
+        const QString path = writeScenarioFile(dir, "main.json", R"({
+            "type": "object",
+            "properties": { "code": { "$ref": "commun.json#/definitions/code" } }
+        })");
+        writeScenarioFile(dir, "commun.json", R"({ "definitions": { "code": { "type": "string", "maxLength": 2 } } })");
+        const SwJsonSchema before(first, path);
+        writeScenarioFile(dir, "commun.json", R"({ "definitions": { "code": { "type": "string", "minLength": 3 } } })");
+        const SwJsonSchema after(second, path);
+        expectStatus(failures, "même fichier, premier contexte", before, shortCode, options, ScenarioStatus::Valid);
+        expectStatus(failures, "même fichier, premier contexte (modifié ensuite)", before, longCode, options, ScenarioStatus::Invalid);
+        expectStatus(failures, "même fichier, second contexte", after, longCode, options, ScenarioStatus::Valid);
+        expectStatus(failures, "même fichier, second contexte (ancienne version)", after, shortCode, options, ScenarioStatus::Invalid);
+
+        if (first.statistics().registries == 0 || second.statistics().nodes == 0) {
+            failures << "contextes : registres et noeuds détenus attendus";
+        }
+    }
+    const SwJsonSchemaContext::Statistics liveAfter = SwJsonSchemaContext::liveStatistics();
+    const int instances = SwJsonSchema::liveInstances() - instancesBefore;
+    if (instances != 0 || liveAfter.registries != liveBefore.registries || liveAfter.nodes != liveBefore.nodes) {
+        failures << QString("non libérés avec les contextes : %1 instances, %2 registres, %3 noeuds")
+                        .arg(instances).arg(liveAfter.registries - liveBefore.registries)
+                        .arg(liveAfter.nodes - liveBefore.nodes);
+    }
+    dir.removeRecursively();
+    return failures;
+}
+
+/// Traite les événements (surveillant, minuterie, fin de rechargement) jusqu'à `condition`,
+/// au plus `msec` ms ; faux si le délai est écoulé.
+static bool waitUntil(const std::function<bool()> &condition, int msec)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.hasExpired(msec)) {
+            return false;
+        }
+        QCoreApplication::processEvents();
+        QThread::msleep(10);
+    }
+    return true;
+}
+
+/// Attend que le rechargeur n'ait plus de version à publier (notifications en attente traitées).
+static void settle(const SwJsonSchemaReloader &reloader)
+{
+    int generation = reloader.generation();
+    QElapsedTimer stable;
+    stable.start();
+    waitUntil([&reloader, &generation, &stable]() {
+        if (reloader.generation() != generation) {
+            generation = reloader.generation();
+            stable.restart();
+        }
+        return stable.hasExpired(300);
+    }, 5000);
+}
+
+// Rechargement à chaud : validations concurrentes pendant le rechargement de la cible d'une
+// $ref, version refusée, fichier remplacé par renommage, generation() ; tout est libéré
+// avec le rechargeur.
+static QStringList scenarioReloader()
+{
+    static const char shortCodes[] = R"({ "definitions": { "code": { "type": "string", "maxLength": 2 } } })";
+    static const char longCodes[] = R"({ "definitions": { "code": { "type": "string", "minLength": 3 } } })";
+    static const char schemaJson[] = R"({
+        "type": "object",
+        "required": ["code"],
+        "properties": { "code": { "$ref": "commun.json#/definitions/code" } }
+    })";
+    QStringList failures;
+    QDir dir = scenarioDirectory("rechargement");
+    const QString path = writeScenarioFile(dir, "main.json", schemaJson);
+    const QString common = writeScenarioFile(dir, "commun.json", shortCodes);
+    const QJsonValue shortCode = scenarioValue(R"({ "code": "FR" })");
+    const QJsonValue longCode = scenarioValue(R"({ "code": "FRA" })");
+    const int instancesBefore = SwJsonSchema::liveInstances();
+    {
+        SwJsonSchemaReloader reloader(path);
+        reloader.setReloadDelay(0);
+        if (!reloader.isValide() || reloader.generation() != 1) {
+            failures << QString("premier chargement : version 1 attendue, %1 (%2)")
+                            .arg(reloader.generation()).arg(reloader.errors().join(" ; "));
+            return failures;
+        }
+        auto isWatched = [&reloader]() {
+            for (const QString &file : reloader.watchedFiles()) {
+                if (QFileInfo(file).fileName() == "commun.json") {
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (!isWatched()) {
+            failures << "cible de la $ref non surveillée";
+        }
+
+        // Chaque lecteur valide les deux codes sur une même version : exactement un est accepté
+        const int rounds = 20;
+        QAtomicInt stop(0);
+        QAtomicInt checks(0);
+        QAtomicInt mixed(0);
+        QThreadPool readers;
+        readers.setMaxThreadCount(4);
+        for (int reader = 0; reader < 4; ++reader) {
+            QtConcurrent::run(&readers, [&]() {
+                while (!stop.loadAcquire()) {
+                    const bool consistent = reloader.withSchema([&](const SwJsonSchema &schema) {
+                        return schema.validate(shortCode) != schema.validate(longCode);
+                    });
+                    if (!consistent) {
+                        mixed.ref();
+                    }
+                    checks.ref();
+                }
+            });
+        }
+        for (int round = 1; round <= rounds; ++round) {
+            writeScenarioFile(dir, "commun.json", round % 2 ? longCodes : shortCodes);
+            if (!reloader.reload()) {
+                failures << QString("rechargement %1 refusé : %2").arg(round).arg(reloader.errors().join(" ; "));
+            }
+        }
+        stop.storeRelease(1);
+        readers.waitForDone();
+        if (checks.loadRelaxed() == 0 || mixed.loadRelaxed() != 0) {
+            failures << QString("validations concurrentes : %1 sur %2 ont mêlé deux versions")
+                            .arg(mixed.loadRelaxed()).arg(checks.loadRelaxed());
+        }
+        if (reloader.generation() != 1 + rounds) {
+            failures << QString("generation() : %1 attendu, %2 obtenu").arg(1 + rounds).arg(reloader.generation());
+        }
+        settle(reloader);
+        if (!reloader.validate(shortCode) || reloader.validate(longCode)) {
+            failures << "après les rechargements : dernière version (codes courts) attendue";
+        }
+
+        // Version refusée : la précédente reste en service
+        const int accepted = reloader.generation();
+        writeScenarioFile(dir, "main.json", "{ \"type\": ");
+        if (reloader.reload() || reloader.errors().isEmpty()) {
+            failures << "document illisible : rechargement refusé et erreurs attendus";
+        }
+        if (reloader.generation() != accepted || !reloader.validate(shortCode) || reloader.validate(longCode)) {
+            failures << "version refusée mise en service";
+        }
+        writeScenarioFile(dir, "main.json", schemaJson);
+        settle(reloader);
+
+        // Enregistrement par renommage : le fichier quitte le surveillant puis réapparaît
+        const int beforeRename = reloader.generation();
+        const QString replacement = writeScenarioFile(dir, "commun.json.tmp", longCodes);
+        QFile::remove(common);
+        QFile::rename(replacement, common);
+        const bool reloaded = waitUntil([&]() {
+            return reloader.generation() > beforeRename && reloader.validate(longCode) && isWatched();
+        }, 5000);
+        if (!reloaded) {
+            failures << QString("fichier remplacé par renommage : version %1, surveillé : %2")
+                            .arg(reloader.generation()).arg(isWatched() ? "oui" : "non");
+        }
+        settle(reloader);
+    }
+    const int instances = SwJsonSchema::liveInstances() - instancesBefore;
+    if (instances != 0) {
+        failures << QString("%1 instances de SwJsonSchema non libérées avec le rechargeur").arg(instances);
+    }
+    dir.removeRecursively();
+    return failures;
+}
+
+// Échéances et annulation : échéance déjà dépassée, échéance écoulée pendant l'attente dans
+// le pool, annulation pendant la validation et résultats de validateAsync().
+static QStringList scenarioInterruptions()
+{
+    QStringList failures;
+    QJsonArray numbers;
+    for (int i = 0; i < 100000; ++i) {
+        numbers.append(i);
+    }
+    const QJsonValue document(numbers);
+    const SwJsonSchema plain(scenarioObject(R"({ "type": "array", "items": { "type": "integer", "minimum": 0 } })"));
+
+    // Échéance dépassée avant le début : interrompue au premier point de contrôle
+    SwJsonSchema::ValidationOptions expired;
+    expired.deadline = QDeadlineTimer(0);
+    expectStatus(failures, "échéance dépassée", plain, document, expired, ScenarioStatus::TimedOut);
+    expectStatus(failures, "échéance dépassée (petit document)", plain, scenarioValue("[1, 2, 3]"), expired, ScenarioStatus::TimedOut);
+    SwJsonSchema::ValidationOptions generous;
+    generous.deadline = QDeadlineTimer(60000);
+    expectStatus(failures, "échéance large", plain, document, generous, ScenarioStatus::Valid);
+
+    // Mot-clé "x-pause" : le premier élément validé signale le début de la validation, puis
+    // attend le feu vert du scénario
+    QSharedPointer<QSemaphore> started(new QSemaphore(0));
+    QSharedPointer<QSemaphore> resume(new QSemaphore(0));
+    QSharedPointer<QAtomicInt> calls(new QAtomicInt(0));
+    SwJsonSchema::registerCustomKeyword("x-pause", [started, resume, calls](const QJsonValue &, const QJsonValue &, QString *) {
+        if (calls->fetchAndAddOrdered(1) == 0) {
+            started->release();
+            resume->acquire();
+        }
+        return true;
+    });
+    const SwJsonSchema paused(scenarioObject(R"({ "type": "array", "items": { "type": "integer", "x-pause": true } })"));
+
+    // Un seul thread : la seconde validation attend dans le pool que la première soit annulée
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    SwJsonSchemaCancelToken token;
+    SwJsonSchema::ValidationOptions cancelable;
+    cancelable.cancelToken = &token;
+    QFuture<SwJsonSchema::ValidationResult> canceled = paused.validateAsync(document, cancelable, &pool);
+    SwJsonSchema::ValidationOptions queued;
+    queued.deadline = QDeadlineTimer(50);
+    QFuture<SwJsonSchema::ValidationResult> late = plain.validateAsync(document, queued, &pool);
+    if (!started->tryAcquire(1, 10000)) {
+        failures << "validateAsync : validation jamais commencée";
+        resume->release();
+        return failures;
+    }
+    QThread::msleep(100);
+    token.cancel();
+    resume->release();
+    const SwJsonSchema::ValidationResult canceledResult = canceled.result();
+    if (canceledResult.status != ScenarioStatus::Canceled || canceledResult.errorMessage.isEmpty()) {
+        failures << QString("annulation en cours de validation : statut %1 (%2)")
+                        .arg(int(canceledResult.status)).arg(canceledResult.errorMessage);
+    }
+    if (calls->loadRelaxed() >= numbers.size()) {
+        failures << "annulation en cours de validation : tous les éléments ont été validés";
+    }
+    if (late.result().status != ScenarioStatus::TimedOut) {
+        failures << QString("échéance écoulée dans le pool : statut %1").arg(int(late.result().status));
+    }
+
+    // Résultats ordinaires de validateAsync()
+    const SwJsonSchema::ValidationResult valid = plain.validateAsync(document, &pool).result();
+    if (valid.status != ScenarioStatus::Valid) {
+        failures << QString("validateAsync (valide) : statut %1 (%2)").arg(int(valid.status)).arg(valid.errorMessage);
+    }
+    const SwJsonSchema::ValidationResult invalid = plain.validateAsync(scenarioValue("[1, -2]"), &pool).result();
+    if (invalid.status != ScenarioStatus::Invalid || invalid.errorMessage.isEmpty()) {
+        failures << QString("validateAsync (invalide) : statut %1, message '%2'").arg(int(invalid.status)).arg(invalid.errorMessage);
+    }
+    return failures;
+}
+
+struct Scenario
+{
+    const char *name;
+    QStringList (*run)();
+};
+
+static const Scenario g_scenarios[] = {
+    { "limites", scenarioLimits },
+    { "échéances et annulation", scenarioInterruptions },
+    { "cache de résultats", scenarioResultCache },
+    { "unevaluatedProperties (QVariant, QCborValue)", scenarioUnevaluatedDocuments },
+    { "analyse de complexité", scenarioComplexity },
+    { "définitions différées", scenarioLazyDefinitions },
+    { "schémas booléens", scenarioBooleanSchemas },
+    { "partage des sous-schémas", scenarioDeduplication },
+    { "ensemble routé", scenarioSchemaSet },
+    { "contextes isolés", scenarioIsolatedContexts },
+    { "rechargement à chaud", scenarioReloader },
+};
+
+static QList<ValidationResult> runScenarios()
+{
+    QList<ValidationResult> results;
+    for (const Scenario &scenario : g_scenarios) {
+        QElapsedTimer timer;
+        timer.start();
+        const QStringList failures = scenario.run();
+        ValidationResult r;
+        r.testDirName = "scenarios";
+        r.dataFileName = scenario.name;
+        r.success = failures.isEmpty();
+        r.error = failures.join("\n");
+        r.elapsedNs = timer.nsecsElapsed();
+        results << r;
+    }
     return results;
 }
 
+//--------------------------------------------------------------------
+// Rapports : JUnit XML (option "--junit <fichier>") et JSON (option "--report <fichier>")
+// Une suite par répertoire de test (ou fichier de la suite officielle), un cas par donnée.
+//--------------------------------------------------------------------
+static QList<QPair<QString, QList<ValidationResult>>> groupByTestDir(const QList<ValidationResult> &allResults)
+{
+    QList<QPair<QString, QList<ValidationResult>>> suites;
+    QHash<QString, int> index;
+    for (const ValidationResult &r : allResults) {
+        if (!index.contains(r.testDirName)) {
+            index.insert(r.testDirName, suites.size());
+            suites << qMakePair(r.testDirName, QList<ValidationResult>());
+        }
+        suites[index.value(r.testDirName)].second << r;
+    }
+    return suites;
+}
+
+static QString seconds(qint64 ns)
+{
+    return QString::number(double(ns) / 1e9, 'f', 6);
+}
+
+static bool writeJUnitReport(const QString &path, const QList<ValidationResult> &allResults, qint64 wallNs)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    int failures = 0;
+    for (const ValidationResult &r : allResults) {
+        failures += r.success ? 0 : 1;
+    }
+
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("testsuites");
+    xml.writeAttribute("name", "SwJsonSchema");
+    xml.writeAttribute("tests", QString::number(allResults.size()));
+    xml.writeAttribute("failures", QString::number(failures));
+    xml.writeAttribute("time", seconds(wallNs));
+    for (const auto &suite : groupByTestDir(allResults)) {
+        int suiteFailures = 0;
+        qint64 suiteNs = 0;
+        for (const ValidationResult &r : suite.second) {
+            suiteFailures += r.success ? 0 : 1;
+            suiteNs += r.elapsedNs;
+        }
+        xml.writeStartElement("testsuite");
+        xml.writeAttribute("name", suite.first);
+        xml.writeAttribute("tests", QString::number(suite.second.size()));
+        xml.writeAttribute("failures", QString::number(suiteFailures));
+        xml.writeAttribute("time", seconds(suiteNs));
+        for (const ValidationResult &r : suite.second) {
+            xml.writeStartElement("testcase");
+            xml.writeAttribute("classname", r.testDirName);
+            xml.writeAttribute("name", r.dataFileName);
+            xml.writeAttribute("time", seconds(r.elapsedNs));
+            if (!r.success) {
+                xml.writeStartElement("failure");
+                xml.writeAttribute("message", r.error);
+                xml.writeEndElement();
+            }
+            xml.writeEndElement();
+        }
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();
+    xml.writeEndDocument();
+    return true;
+}
+
+static bool writeJsonReport(const QString &path, const QList<ValidationResult> &allResults, qint64 wallNs)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    int failures = 0;
+    QJsonArray suites;
+    for (const auto &suite : groupByTestDir(allResults)) {
+        QJsonArray cases;
+        int suiteFailures = 0;
+        qint64 suiteNs = 0;
+        for (const ValidationResult &r : suite.second) {
+            QJsonObject c;
+            c.insert("name", r.dataFileName);
+            c.insert("success", r.success);
+            if (!r.success) {
+                c.insert("error", r.error);
+            }
+            c.insert("microseconds", double(r.elapsedNs) / 1e3);
+            cases.append(c);
+            suiteFailures += r.success ? 0 : 1;
+            suiteNs += r.elapsedNs;
+        }
+        failures += suiteFailures;
+        QJsonObject s;
+        s.insert("name", suite.first);
+        s.insert("tests", suite.second.size());
+        s.insert("failures", suiteFailures);
+        s.insert("microseconds", double(suiteNs) / 1e3);
+        s.insert("cases", cases);
+        suites.append(s);
+    }
+    QJsonObject root;
+    root.insert("tests", allResults.size());
+    root.insert("failures", failures);
+    root.insert("wallMicroseconds", double(wallNs) / 1e3);
+    root.insert("suites", suites);
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
 //--------------------------------------------------------------------
 // Fonction pour afficher un rapport d'erreur détaillé
 //--------------------------------------------------------------------
-static void reportFailures(const QList<ValidationResult> &allResults)
+static int reportFailures(const QList<ValidationResult> &allResults)
 {
     int passCount = 0;
     int failCount = 0;
@@ -183,6 +1617,7 @@ static void reportFailures(const QList<ValidationResult> &allResults)
     qDebug().noquote() << "Tests réussis :" << passCount;
     qDebug().noquote() << "Tests échoués :" << failCount;
     qDebug().noquote() << "--------------------------------\n";
+    return failCount;
 }
 
 //--------------------------------------------------------------------
@@ -214,26 +1649,226 @@ int main(int argc, char *argv[])
 
     // Si vous voulez prendre un argument (ex: chemin "tests/"),
     // vous pouvez le récupérer dans argv[1], sinon on met un chemin par défaut.
-    QString testsRoot = (argc > 1) ? QString::fromUtf8(argv[1]) : "tests";
-    QDir rootDir(testsRoot);
+    // L'option "--profile" active le profilage et affiche les points chauds.
+    // L'option "--trace <dir>" écrit la trace de chaque validation dans <dir>.
+    // L'option "--memoize" active le cache de résultats et affiche son taux de succès.
+    // L'option "--timeout <ms>" limite la durée de chaque validation.
+    // L'option "--result-cache <n>" revalide chaque donnée depuis un cache de <n> résultats par schéma.
+    // L'option "--memory" affiche la mémoire retenue par chaque schéma, par catégorie.
+    // L'option "--dedup" active le partage des sous-schémas identiques au chargement.
+    // L'option "--reload-cycles <n>" (1 par défaut, 0 pour ne pas le faire) recharge <n> fois
+    // chaque test dans un contexte neuf et vérifie que ses instances, registres et noeuds sont
+    // tous libérés.
+    // L'option "--regex-engine <backtracking|linear|fallback>" choisit le moteur des "pattern".
+    // L'option "--document <json|variant|cbor>" valide les données sous forme QVariant / QCborValue.
+    // L'option "--jobs <n>" fixe le nombre de threads (défaut : un par coeur).
+    // Les options "--junit <fichier>" et "--report <fichier>" écrivent un rapport JUnit XML / JSON.
+    // L'option "--suite <dir>" exécute la suite officielle JSON-Schema-Test-Suite (checkout local)
+    // au lieu de tests/ : "--draft <nom>" (répétable, défaut draft2020-12) choisit les drafts,
+    // "--optional" ajoute leurs tests optional/.
+    // Sans "--suite", les scénarios d'API (voir runScenarios()) sont exécutés après tests/.
+    QStringList args = app.arguments().mid(1);
+    bool profile = args.removeAll("--profile") > 0;
+    SwJsonSchemaProfiler::setEnabled(profile);
+    g_memoize = args.removeAll("--memoize") > 0;
+    g_memory = args.removeAll("--memory") > 0;
+    SwJsonSchema::setDeduplication(args.removeAll("--dedup") > 0);
+
+    int traceIdx = args.indexOf("--trace");
+    if (traceIdx >= 0 && traceIdx + 1 < args.size()) {
+        g_traceDir = args.at(traceIdx + 1);
+        QDir().mkpath(g_traceDir);
+        args.erase(args.begin() + traceIdx, args.begin() + traceIdx + 2);
+    }
+
+    int reloadCyclesIdx = args.indexOf("--reload-cycles");
+    if (reloadCyclesIdx >= 0 && reloadCyclesIdx + 1 < args.size()) {
+        g_reloadCycles = qMax(0, args.at(reloadCyclesIdx + 1).toInt());
+        args.erase(args.begin() + reloadCyclesIdx, args.begin() + reloadCyclesIdx + 2);
+    }
+
+    int timeoutIdx = args.indexOf("--timeout");
+    if (timeoutIdx >= 0 && timeoutIdx + 1 < args.size()) {
+        g_timeoutMs = args.at(timeoutIdx + 1).toLongLong();
+        args.erase(args.begin() + timeoutIdx, args.begin() + timeoutIdx + 2);
+    }
 
-    if (!rootDir.exists()) {
-        qWarning() << "Le répertoire de tests n'existe pas :" << testsRoot;
-        return -1;
+    int regexIdx = args.indexOf("--regex-engine");
+    if (regexIdx >= 0 && regexIdx + 1 < args.size()) {
+        const QString engine = args.at(regexIdx + 1);
+        if (engine == "linear") {
+            SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Linear);
+        } else if (engine == "fallback") {
+            SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::LinearWithFallback);
+        } else {
+            SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Backtracking);
+        }
+        args.erase(args.begin() + regexIdx, args.begin() + regexIdx + 2);
+    }
+
+    int resultCacheIdx = args.indexOf("--result-cache");
+    if (resultCacheIdx >= 0 && resultCacheIdx + 1 < args.size()) {
+        g_resultCacheEntries = qMax(0, args.at(resultCacheIdx + 1).toInt());
+        args.erase(args.begin() + resultCacheIdx, args.begin() + resultCacheIdx + 2);
     }
 
-    // Lister tous les sous-répertoires (chaque sous-répertoire = un test)
-    QStringList testDirs = rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    int documentIdx = args.indexOf("--document");
+    if (documentIdx >= 0 && documentIdx + 1 < args.size()) {
+        const QString document = args.at(documentIdx + 1);
+        if (document == "variant") {
+            g_document = DocumentKind::Variant;
+        } else if (document == "cbor") {
+            g_document = DocumentKind::Cbor;
+        } else {
+            g_document = DocumentKind::Json;
+        }
+        args.erase(args.begin() + documentIdx, args.begin() + documentIdx + 2);
+    }
+
+    // Options à valeur : "--option <valeur>", "--draft" peut être répété
+    auto takeValues = [&args](const QString &option) {
+        QStringList values;
+        int idx;
+        while ((idx = args.indexOf(option)) >= 0 && idx + 1 < args.size()) {
+            values << args.at(idx + 1);
+            args.erase(args.begin() + idx, args.begin() + idx + 2);
+        }
+        return values;
+    };
+    const QStringList jobs = takeValues("--jobs");
+    const QStringList junitPath = takeValues("--junit");
+    const QStringList reportPath = takeValues("--report");
+    const QStringList suiteRoot = takeValues("--suite");
+    QStringList drafts = takeValues("--draft");
+    const bool optional = args.removeAll("--optional") > 0;
+    if (!jobs.isEmpty()) {
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, jobs.last().toInt()));
+    }
+
+    QList<TestUnit> units;
+    if (!suiteRoot.isEmpty()) {
+        // Checkout de la suite : <racine>/tests/<draft>/*.json (et optional/*.json)
+        QDir suiteDir(suiteRoot.last());
+        if (suiteDir.exists("tests")) {
+            suiteDir.cd("tests");
+        }
+        if (drafts.isEmpty()) {
+            drafts << "draft2020-12";
+        }
+        QStringList paths;
+        QStringList names;
+        for (const QString &draft : drafts) {
+            QStringList subDirs{draft};
+            if (optional) {
+                subDirs << draft + "/optional";
+            }
+            for (const QString &subDir : subDirs) {
+                QDir dir(suiteDir.absoluteFilePath(subDir));
+                if (!dir.exists()) {
+                    qWarning() << "Répertoire de la suite introuvable :" << dir.absolutePath();
+                    continue;
+                }
+                for (const QString &file : dir.entryList(QStringList() << "*.json", QDir::Files)) {
+                    paths << dir.absoluteFilePath(file);
+                    names << subDir + "/" + QFileInfo(file).completeBaseName();
+                }
+            }
+        }
+        units = groupBySharedId(paths, names, true);
+    } else {
+        QString testsRoot = !args.isEmpty() ? args.first() : "tests";
+        QDir rootDir(testsRoot);
+
+        if (!rootDir.exists()) {
+            qWarning() << "Le répertoire de tests n'existe pas :" << testsRoot;
+            return -1;
+        }
+
+        // Lister tous les sous-répertoires (chaque sous-répertoire = un test)
+        QStringList paths;
+        QStringList testDirs = rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &subDir : testDirs) {
+            paths << rootDir.absoluteFilePath(subDir);
+        }
+        units = groupBySharedId(paths, testDirs, false);
+    }
+
+    // Les unités s'exécutent en parallèle ; l'ordre des résultats reste celui des répertoires
+    const SwJsonSchemaContext::Statistics liveBefore = SwJsonSchemaContext::liveStatistics();
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    const QList<QList<ValidationResult>> unitResults = QtConcurrent::blockingMapped(units, runTestUnit);
+    const qint64 wallNs = wallTimer.nsecsElapsed();
 
     QList<ValidationResult> allResults;
-    for (const QString &subDir : testDirs) {
-        QString testDirPath = rootDir.absoluteFilePath(subDir);
-        QList<ValidationResult> results = runTestDirectory(testDirPath);
+    for (const QList<ValidationResult> &results : unitResults) {
         allResults.append(results);
     }
+    if (suiteRoot.isEmpty()) {
+        for (const TestUnit &unit : units) {
+            for (int i = 0; i < unit.paths.size(); ++i) {
+                allResults.append(runReloadCycles(unit.paths.at(i), unit.names.at(i)));
+            }
+        }
+        allResults.append(runScenarios());
+    }
 
     // Générer un rapport global
-    reportFailures(allResults);
+    const int failCount = reportFailures(allResults);
+    qDebug().noquote() << QString("Durée : %1 ms (%2 unités, %3 threads)")
+                              .arg(double(wallNs) / 1e6, 0, 'f', 1)
+                              .arg(units.size())
+                              .arg(QThreadPool::globalInstance()->maxThreadCount());
+
+    if (!junitPath.isEmpty() && !writeJUnitReport(junitPath.last(), allResults, wallNs)) {
+        qWarning() << "Impossible d'écrire le rapport JUnit :" << junitPath.last();
+    }
+    if (!reportPath.isEmpty() && !writeJsonReport(reportPath.last(), allResults, wallNs)) {
+        qWarning() << "Impossible d'écrire le rapport JSON :" << reportPath.last();
+    }
+
+    if (g_memoize) {
+        qDebug().noquote() << QString("Cache de résultats : %1 succès / %2 calculs")
+                                  .arg(g_memoHits.loadRelaxed()).arg(g_memoMisses.loadRelaxed());
+    }
+
+    if (g_resultCacheEntries > 0) {
+        qDebug().noquote() << QString("Cache des documents validés : %1 succès / %2 absences / %3 évictions")
+                                  .arg(g_resultCacheHits.loadRelaxed()).arg(g_resultCacheMisses.loadRelaxed())
+                                  .arg(g_resultCacheEvictions.loadRelaxed());
+    }
+
+    if (g_memory) {
+        qDebug().noquote() << "----- Mémoire des schémas (octets) -----";
+        qDebug().noquote() << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+                                  .arg("test", -12).arg("noeuds", 8).arg("annexes", 8).arg("fixe", 9)
+                                  .arg("annexe", 9).arg("objets", 9).arg("valeurs", 9).arg("motifs", 9).arg("total", 10);
+        for (auto it = g_memoryUsage.cbegin(); it != g_memoryUsage.cend(); ++it) {
+            const SwJsonSchema::MemoryUsage &usage = it.value();
+            qDebug().noquote() << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+                                      .arg(it.key(), -12).arg(usage.nodes, 8).arg(usage.nodesWithColdKeywords, 8)
+                                      .arg(usage.nodeBytes, 9).arg(usage.coldBytes, 9).arg(usage.objectBytes, 9)
+                                      .arg(usage.valueBytes, 9).arg(usage.stringBytes, 9).arg(usage.totalBytes(), 10);
+        }
+        const SwJsonSchema::DeduplicationStatistics dedup = SwJsonSchema::deduplicationStatistics();
+        qDebug().noquote() << QString("Sous-schémas partagés au chargement : %1 / %2")
+                                  .arg(dedup.shared).arg(dedup.subschemas);
+    }
+
+    // Tous les schémas des tests sont détruits : leurs contextes aussi
+    const SwJsonSchemaContext::Statistics liveAfter = SwJsonSchemaContext::liveStatistics();
+    const bool leaked = liveAfter.registries != liveBefore.registries || liveAfter.nodes != liveBefore.nodes;
+    const int reloadCycles = suiteRoot.isEmpty() ? g_reloadCycles : 0;  // Pas de cycles pour la suite officielle
+    qDebug().noquote() << QString("Contextes de registres : %1 registres / %2 noeuds encore détenus%3")
+                              .arg(liveAfter.registries - liveBefore.registries)
+                              .arg(liveAfter.nodes - liveBefore.nodes)
+                              .arg(reloadCycles > 0 ? QString(" après %1 cycles par test").arg(reloadCycles) : QString());
+
+    if (profile) {
+        qDebug().noquote() << "----- Points chauds (profilage) -----";
+        qDebug().noquote() << SwJsonSchemaProfiler::instance().report(20);
+    }
 
-    return 0;
+    // Code de sortie non nul en cas d'échec : utilisable comme garde de non-régression
+    return (failCount == 0 && !leaked) ? 0 : 1;
 }
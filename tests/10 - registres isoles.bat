@@ -0,0 +1,97 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_11 (
+    mkdir test_11
+)
+if not exist test_11\data_success (
+    mkdir test_11\data_success
+)
+if not exist test_11\data_fail (
+    mkdir test_11\data_fail
+)
+
+rem ================================================
+rem Document externe référencé par le schéma principal
+rem ================================================
+(
+echo {
+echo   "definitions": {
+echo     "code": { "type": "string", "pattern": "^[A-Z]{3}$" },
+echo     "montant": { "type": "number", "minimum": 0 }
+echo   }
+echo }
+) > test_11\commun.json
+
+rem ================================================
+rem Génération du schéma : $defs, $anchor et $ref externe, tous enregistrés dans les
+rem registres du contexte propre au schéma
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "type": "object",
+echo   "required": ["devise", "lignes"],
+echo   "properties": {
+echo     "devise": { "$ref": "commun.json#/definitions/code" },
+echo     "lignes": {
+echo       "type": "array",
+echo       "minItems": 1,
+echo       "items": { "$ref": "#ligne" }
+echo     }
+echo   },
+echo   "$defs": {
+echo     "ligne": {
+echo       "$anchor": "ligne",
+echo       "type": "object",
+echo       "required": ["libelle", "montant"],
+echo       "properties": {
+echo         "libelle": { "$ref": "#/$defs/libelle" },
+echo         "montant": { "$ref": "commun.json#/definitions/montant" }
+echo       }
+echo     },
+echo     "libelle": { "type": "string", "minLength": 1 }
+echo   }
+echo }
+) > test_11\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Devise et lignes conformes
+(
+echo {
+echo   "devise": "EUR",
+echo   "lignes": [
+echo     { "libelle": "Abonnement", "montant": 12.5 },
+echo     { "libelle": "Option", "montant": 0 }
+echo   ]
+echo }
+) > test_11\data_success\facture.json
+
+rem Devise refusée par le document externe
+(
+echo {
+echo   "devise": "euro",
+echo   "lignes": [ { "libelle": "Abonnement", "montant": 12.5 } ]
+echo }
+) > test_11\data_fail\devise.json
+
+rem Montant négatif : $anchor puis $ref externe
+(
+echo {
+echo   "devise": "EUR",
+echo   "lignes": [ { "libelle": "Remise", "montant": -3 } ]
+echo }
+) > test_11\data_fail\montant.json
+
+rem Libellé vide : $anchor puis $defs
+(
+echo {
+echo   "devise": "EUR",
+echo   "lignes": [ { "libelle": "", "montant": 1 } ]
+echo }
+) > test_11\data_fail\libelle.json
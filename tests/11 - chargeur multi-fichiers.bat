@@ -0,0 +1,133 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_12 (
+    mkdir test_12
+)
+if not exist test_12\data_success (
+    mkdir test_12\data_success
+)
+if not exist test_12\data_fail (
+    mkdir test_12\data_fail
+)
+
+rem ================================================
+rem Schéma réparti sur plusieurs fichiers, chargé par SwJsonSchemaLoader (présence de
+rem loader.json) : a.json et b.json se référencent l'un l'autre (cycle), tous deux
+rem référencent commun.json (losange), absent.json n'existe pas et illisible.json n'est
+rem pas du JSON. Une $ref vers un fichier illisible ne contraint rien ; le chargeur le
+rem signale dans errors().
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "type": "object",
+echo   "required": ["racine"],
+echo   "properties": {
+echo     "racine": { "$ref": "a.json#/definitions/noeud" },
+echo     "annexe": { "$ref": "b.json#/definitions/noeud" },
+echo     "archive": { "$ref": "absent.json" },
+echo     "brouillon": { "$ref": "illisible.json" }
+echo   }
+echo }
+) > test_12\main.json
+
+(
+echo {
+echo   "definitions": {
+echo     "noeud": {
+echo       "type": "object",
+echo       "required": ["code"],
+echo       "properties": {
+echo         "code": { "$ref": "commun.json#/definitions/code" },
+echo         "enfants": { "type": "array", "items": { "$ref": "b.json#/definitions/noeud" } }
+echo       }
+echo     }
+echo   }
+echo }
+) > test_12\a.json
+
+(
+echo {
+echo   "definitions": {
+echo     "noeud": {
+echo       "type": "object",
+echo       "required": ["valeur"],
+echo       "properties": {
+echo         "valeur": { "type": "number", "minimum": 0 },
+echo         "devise": { "$ref": "commun.json#/definitions/code" },
+echo         "enfants": { "type": "array", "items": { "$ref": "a.json#/definitions/noeud" } }
+echo       }
+echo     }
+echo   }
+echo }
+) > test_12\b.json
+
+(
+echo {
+echo   "definitions": {
+echo     "code": { "type": "string", "pattern": "^[A-Z]{3}$" }
+echo   }
+echo }
+) > test_12\commun.json
+
+(
+echo { "type":
+) > test_12\illisible.json
+
+rem ================================================
+rem Attendus du chargement : documents rencontrés (illisibles compris), $ref liées
+rem pendant la phase de liaison, fichiers cités par errors()
+rem ================================================
+(
+echo {
+echo   "documents": 6,
+echo   "links": 6,
+echo   "errors": ["absent.json", "illisible.json"]
+echo }
+) > test_12\loader.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Trois niveaux (a, b puis a), devise du losange, archive non contrainte
+(
+echo {
+echo   "racine": {
+echo     "code": "EUR",
+echo     "enfants": [
+echo       { "valeur": 3, "devise": "USD", "enfants": [ { "code": "GBP" } ] }
+echo     ]
+echo   },
+echo   "annexe": { "valeur": 1, "devise": "CHF" },
+echo   "archive": "non contrainte"
+echo }
+) > test_12\data_success\arbre.json
+
+rem Code refusé au troisième niveau, après un tour du cycle
+(
+echo {
+echo   "racine": {
+echo     "code": "EUR",
+echo     "enfants": [ { "valeur": 3, "enfants": [ { "code": "gbp" } ] } ]
+echo   }
+echo }
+) > test_12\data_fail\cycle.json
+
+rem Devise refusée par commun.json, atteint depuis b.json
+(
+echo {
+echo   "racine": { "code": "EUR" },
+echo   "annexe": { "valeur": 1, "devise": "euro" }
+echo }
+) > test_12\data_fail\losange.json
+
+rem Valeur manquante dans un noeud de b.json
+(
+echo {
+echo   "racine": { "code": "EUR", "enfants": [ { "devise": "USD" } ] }
+echo }
+) > test_12\data_fail\valeur.json
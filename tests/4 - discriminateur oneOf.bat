@@ -0,0 +1,142 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_5 (
+    mkdir test_5
+)
+if not exist test_5\data_success (
+    mkdir test_5\data_success
+)
+if not exist test_5\data_fail (
+    mkdir test_5\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : unions discriminées par "kind"
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "type": "object",
+echo   "required": ["event"],
+echo   "properties": {
+echo     "event": {
+echo       "oneOf": [
+echo         {
+echo           "type": "object",
+echo           "required": ["kind", "user"],
+echo           "properties": {
+echo             "kind": { "const": "login" },
+echo             "user": { "type": "string", "minLength": 1 }
+echo           }
+echo         },
+echo         {
+echo           "type": "object",
+echo           "required": ["kind", "user"],
+echo           "properties": {
+echo             "kind": { "const": "logout" },
+echo             "user": { "type": "string", "minLength": 1 }
+echo           }
+echo         },
+echo         {
+echo           "type": "object",
+echo           "required": ["kind", "amount"],
+echo           "properties": {
+echo             "kind": { "enum": ["payment", "refund"] },
+echo             "amount": { "type": "number", "minimum": 0 }
+echo           }
+echo         },
+echo         {
+echo           "type": "object",
+echo           "required": ["kind", "code"],
+echo           "properties": {
+echo             "kind": { "const": "error" },
+echo             "code": { "type": "integer" }
+echo           }
+echo         }
+echo       ]
+echo     },
+echo     "source": {
+echo       "anyOf": [
+echo         {
+echo           "type": "object",
+echo           "properties": {
+echo             "channel": { "enum": ["web", "mobile"] },
+echo             "version": { "type": "string" }
+echo           }
+echo         },
+echo         {
+echo           "type": "object",
+echo           "properties": {
+echo             "channel": { "const": "batch" },
+echo             "job": { "type": "integer" }
+echo           }
+echo         }
+echo       ]
+echo     }
+echo   }
+echo }
+) > test_5\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Variante "login" valide
+(
+echo {
+echo   "event": { "kind": "login", "user": "alice" },
+echo   "source": { "channel": "web", "version": "1.2" }
+echo }
+) > test_5\data_success\login.json
+
+rem Variante "refund" (valeur d'un enum) valide
+(
+echo {
+echo   "event": { "kind": "refund", "amount": 12.5 },
+echo   "source": { "channel": "batch", "job": 42 }
+echo }
+) > test_5\data_success\refund.json
+
+rem Discriminant absent de "source" : toutes les branches anyOf sont évaluées
+(
+echo {
+echo   "event": { "kind": "error", "code": 404 },
+echo   "source": { "version": "2.0" }
+echo }
+) > test_5\data_success\source_without_channel.json
+
+rem Valeur de discriminant inconnue
+(
+echo {
+echo   "event": { "kind": "purchase", "amount": 10 }
+echo }
+) > test_5\data_fail\unknown_kind.json
+
+rem Discriminant correct mais contenu invalide pour la branche désignée
+(
+echo {
+echo   "event": { "kind": "payment", "amount": -3 }
+echo }
+) > test_5\data_fail\invalid_payload.json
+
+rem Discriminant absent : aucune branche oneOf n'est satisfaite
+(
+echo {
+echo   "event": { "user": "bob" }
+echo }
+) > test_5\data_fail\missing_kind.json
+
+rem Discriminant anyOf correct mais contenu invalide
+(
+echo {
+echo   "event": { "kind": "logout", "user": "carol" },
+echo   "source": { "channel": "batch", "job": "nightly" }
+echo }
+) > test_5\data_fail\invalid_source.json
+
+echo.
+echo [OK] Le schéma à unions discriminées et les fichiers de test ont été créés dans le dossier "test_5".
+pause
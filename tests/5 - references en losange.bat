@@ -0,0 +1,95 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_6 (
+    mkdir test_6
+)
+if not exist test_6\data_success (
+    mkdir test_6\data_success
+)
+if not exist test_6\data_fail (
+    mkdir test_6\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : $ref en losange via allOf
+rem (un même sous-schéma est atteint plusieurs fois pour la même valeur)
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "$id": "diamond",
+echo   "$defs": {
+echo     "point": {
+echo       "type": "object",
+echo       "required": ["x", "y"],
+echo       "properties": {
+echo         "x": { "type": "integer", "minimum": 0 },
+echo         "y": { "type": "integer", "minimum": 0 }
+echo       }
+echo     },
+echo     "labelled": {
+echo       "allOf": [
+echo         { "$ref": "#/$defs/point" },
+echo         { "required": ["label"] }
+echo       ]
+echo     },
+echo     "coloured": {
+echo       "allOf": [
+echo         { "$ref": "#/$defs/point" },
+echo         { "required": ["color"] }
+echo       ]
+echo     }
+echo   },
+echo   "type": "object",
+echo   "properties": {
+echo     "markers": {
+echo       "type": "array",
+echo       "items": {
+echo         "allOf": [
+echo           { "$ref": "#/$defs/labelled" },
+echo           { "$ref": "#/$defs/coloured" }
+echo         ]
+echo       }
+echo     }
+echo   }
+echo }
+) > test_6\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Marqueurs valides : "point" est validé par les deux branches
+(
+echo {
+echo   "markers": [
+echo     { "x": 1, "y": 2, "label": "A", "color": "red" },
+echo     { "x": 3, "y": 4, "label": "B", "color": "blue" }
+echo   ]
+echo }
+) > test_6\data_success\markers.json
+
+rem Coordonnée négative
+(
+echo {
+echo   "markers": [
+echo     { "x": 1, "y": -2, "label": "A", "color": "red" }
+echo   ]
+echo }
+) > test_6\data_fail\negative.json
+
+rem Branche "coloured" non satisfaite
+(
+echo {
+echo   "markers": [
+echo     { "x": 1, "y": 2, "label": "A" }
+echo   ]
+echo }
+) > test_6\data_fail\missing_color.json
+
+echo.
+echo [OK] Le schéma à références en losange et les fichiers de test ont été créés dans le dossier "test_6".
+pause
@@ -0,0 +1,140 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_7 (
+    mkdir test_7
+)
+if not exist test_7\data_success (
+    mkdir test_7\data_success
+)
+if not exist test_7\data_fail (
+    mkdir test_7\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : unevaluatedProperties / unevaluatedItems
+rem (annotations collectées à travers $ref, if/then/else, anyOf, prefixItems et contains)
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "$id": "unevaluated",
+echo   "$defs": {
+echo     "base": {
+echo       "type": "object",
+echo       "required": ["id"],
+echo       "properties": {
+echo         "id": { "type": "integer" }
+echo       }
+echo     }
+echo   },
+echo   "type": "object",
+echo   "allOf": [
+echo     { "$ref": "#/$defs/base" }
+echo   ],
+echo   "properties": {
+echo     "kind": { "enum": ["user", "group"] },
+echo     "tags": {
+echo       "type": "array",
+echo       "prefixItems": [
+echo         { "type": "string" }
+echo       ],
+echo       "contains": { "type": "integer" },
+echo       "unevaluatedItems": false
+echo     }
+echo   },
+echo   "if": {
+echo     "required": ["kind"],
+echo     "properties": { "kind": { "const": "user" } }
+echo   },
+echo   "then": {
+echo     "properties": { "email": { "type": "string" } }
+echo   },
+echo   "else": {
+echo     "properties": { "members": { "type": "array" } }
+echo   },
+echo   "anyOf": [
+echo     { "required": ["name"], "properties": { "name": { "type": "string" } } },
+echo     { "required": ["title"], "properties": { "title": { "type": "string" } } }
+echo   ],
+echo   "unevaluatedProperties": false
+echo }
+) > test_7\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Propriétés évaluées par $ref, then, anyOf ; éléments par prefixItems et contains
+(
+echo {
+echo   "id": 1,
+echo   "kind": "user",
+echo   "name": "Alice",
+echo   "email": "alice@example.com",
+echo   "tags": [
+echo     "admin",
+echo     3
+echo   ]
+echo }
+) > test_7\data_success\user.json
+
+rem Branche else
+(
+echo {
+echo   "id": 2,
+echo   "kind": "group",
+echo   "title": "Staff",
+echo   "members": []
+echo }
+) > test_7\data_success\group.json
+
+rem Propriété évaluée par aucun sous-schéma
+(
+echo {
+echo   "id": 1,
+echo   "kind": "user",
+echo   "name": "Alice",
+echo   "nickname": "Al"
+echo }
+) > test_7\data_fail\unknown_property.json
+
+rem "email" n'est évaluée que par then
+(
+echo {
+echo   "id": 2,
+echo   "kind": "group",
+echo   "title": "Staff",
+echo   "email": "staff@example.com"
+echo }
+) > test_7\data_fail\then_property_in_else.json
+
+rem Une branche anyOf en échec n'évalue pas "title"
+(
+echo {
+echo   "id": 1,
+echo   "kind": "user",
+echo   "name": "Alice",
+echo   "title": 5
+echo }
+) > test_7\data_fail\failed_anyof_branch.json
+
+rem true n'est évalué ni par prefixItems ni par contains
+(
+echo {
+echo   "id": 1,
+echo   "kind": "user",
+echo   "name": "Alice",
+echo   "tags": [
+echo     "admin",
+echo     3,
+echo     true
+echo   ]
+echo }
+) > test_7\data_fail\unevaluated_item.json
+
+echo.
+echo [OK] Le schéma unevaluatedProperties et les fichiers de test ont été créés dans le dossier "test_7".
+pause
@@ -0,0 +1,96 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_8 (
+    mkdir test_8
+)
+if not exist test_8\data_success (
+    mkdir test_8\data_success
+)
+if not exist test_8\data_fail (
+    mkdir test_8\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : "type" sous forme de tableau (champs nullables, unions)
+rem Les contraintes propres à un type ne s'appliquent qu'aux valeurs de ce type.
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "$id": "type-unions",
+echo   "type": "object",
+echo   "required": ["id", "score"],
+echo   "properties": {
+echo     "id": { "type": ["string", "integer"], "maxLength": 5, "minimum": 1 },
+echo     "nickname": { "type": ["string", "null"], "minLength": 2 },
+echo     "age": { "type": ["integer", "null"], "minimum": 0 },
+echo     "score": { "type": "number" }
+echo   }
+echo }
+) > test_8\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Champs nullables à null ; un entier est un "number"
+(
+echo {
+echo   "id": 42,
+echo   "nickname": null,
+echo   "age": null,
+echo   "score": 3
+echo }
+) > test_8\data_success\nulls.json
+
+rem Valeurs non nulles ; maxLength ne concerne que la chaîne
+(
+echo {
+echo   "id": "ab-12",
+echo   "nickname": "Al",
+echo   "age": 30,
+echo   "score": 2.5
+echo }
+) > test_8\data_success\values.json
+
+rem Type absent de l'union
+(
+echo {
+echo   "id": 42,
+echo   "nickname": 5,
+echo   "score": 1
+echo }
+) > test_8\data_fail\nickname_number.json
+
+rem "integer" n'admet pas de partie fractionnaire
+(
+echo {
+echo   "id": 42,
+echo   "age": 30.5,
+echo   "score": 1
+echo }
+) > test_8\data_fail\age_not_integer.json
+
+rem minLength s'applique à la chaîne de l'union
+(
+echo {
+echo   "id": 42,
+echo   "nickname": "A",
+echo   "score": 1
+echo }
+) > test_8\data_fail\nickname_too_short.json
+
+rem minimum s'applique à l'entier de l'union
+(
+echo {
+echo   "id": 0,
+echo   "score": 1
+echo }
+) > test_8\data_fail\id_below_minimum.json
+
+echo.
+echo [OK] Le schéma des unions de types et les fichiers de test ont été créés dans le dossier "test_8".
+pause
@@ -0,0 +1,128 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_9 (
+    mkdir test_9
+)
+if not exist test_9\data_success (
+    mkdir test_9\data_success
+)
+if not exist test_9\data_fail (
+    mkdir test_9\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : schémas booléens (true / false) à la place d'un sous-schéma
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "$id": "boolean-schemas",
+echo   "$defs": {
+echo     "anything": true,
+echo     "nothing": false
+echo   },
+echo   "type": "object",
+echo   "required": ["point"],
+echo   "properties": {
+echo     "legacy": false,
+echo     "extra": true,
+echo     "meta": { "$ref": "#/$defs/anything" },
+echo     "removed": { "$ref": "#/$defs/nothing" },
+echo     "point": {
+echo       "type": "array",
+echo       "prefixItems": [
+echo         { "type": "number" },
+echo         { "type": "number" }
+echo       ],
+echo       "items": false
+echo     },
+echo     "tags": {
+echo       "type": "array",
+echo       "items": true,
+echo       "contains": true,
+echo       "unevaluatedItems": false
+echo     },
+echo     "settings": {
+echo       "type": "object",
+echo       "additionalProperties": true,
+echo       "unevaluatedProperties": false
+echo     }
+echo   },
+echo   "patternProperties": {
+echo     "^x-": true
+echo   },
+echo   "additionalProperties": false,
+echo   "allOf": [true],
+echo   "anyOf": [false, { "required": ["point"] }],
+echo   "not": false
+echo }
+) > test_9\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Propriétés acceptées par true, $ref vers true et patternProperties true
+(
+echo {
+echo   "point": [1, 2],
+echo   "extra": { "any": "thing" },
+echo   "meta": [null],
+echo   "x-debug": true,
+echo   "tags": ["a", 1, null],
+echo   "settings": { "theme": "dark" }
+echo }
+) > test_9\data_success\accepted.json
+
+rem items: false n'exige rien des tableaux courts
+(
+echo {
+echo   "point": [1]
+echo }
+) > test_9\data_success\short_point.json
+
+rem Propriété interdite par false
+(
+echo {
+echo   "point": [1, 2],
+echo   "legacy": 1
+echo }
+) > test_9\data_fail\false_property.json
+
+rem Propriété interdite par un $ref vers false
+(
+echo {
+echo   "point": [1, 2],
+echo   "removed": null
+echo }
+) > test_9\data_fail\ref_to_false.json
+
+rem items: false au-delà de prefixItems
+(
+echo {
+echo   "point": [1, 2, 3]
+echo }
+) > test_9\data_fail\items_false.json
+
+rem additionalProperties: false
+(
+echo {
+echo   "point": [1, 2],
+echo   "unknown": 1
+echo }
+) > test_9\data_fail\additional_property.json
+
+rem contains: true échoue sur un tableau vide
+(
+echo {
+echo   "point": [1, 2],
+echo   "tags": []
+echo }
+) > test_9\data_fail\empty_contains.json
+
+echo.
+echo [OK] Le schéma des schémas booléens et les fichiers de test ont été créés dans le dossier "test_9".
+pause
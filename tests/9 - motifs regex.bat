@@ -0,0 +1,83 @@
+@echo off
+
+rem ================================================
+rem Création des répertoires pour le test
+rem ================================================
+if not exist test_10 (
+    mkdir test_10
+)
+if not exist test_10\data_success (
+    mkdir test_10\data_success
+)
+if not exist test_10\data_fail (
+    mkdir test_10\data_fail
+)
+
+rem ================================================
+rem Génération du schéma : motifs du sous-ensemble ECMA-262 (identiques avec les deux moteurs)
+rem ================================================
+(
+echo {
+echo   "$schema": "https://json-schema.org/draft/2020-12/schema",
+echo   "$id": "regex-patterns",
+echo   "type": "object",
+echo   "required": ["version", "code"],
+echo   "properties": {
+echo     "version": { "type": "string", "pattern": "^(?<major>\\d+)\\.(?<minor>\\d{1,3})(?:-[a-z]+)?$" },
+echo     "code": { "type": "string", "pattern": "^(a+)+$" },
+echo     "word": { "type": "string", "pattern": "\\bfoo\\b" },
+echo     "lazy": { "type": "string", "pattern": "^<.+?>$" },
+echo     "hex": { "type": "string", "pattern": "^\\x41[\\x42-\\x44]\\W$" }
+echo   },
+echo   "patternProperties": {
+echo     "^x-[a-z]{2,}$": { "type": "integer" }
+echo   },
+echo   "additionalProperties": false
+echo }
+) > test_10\main.json
+
+rem ================================================
+rem Données de test
+rem ================================================
+
+rem Groupes nommés, \b, quantificateur non gourmand, \x et patternProperties
+(
+echo {
+echo   "version": "2.10-beta",
+echo   "code": "aaaa",
+echo   "word": "a foo b",
+echo   "lazy": "<tag>",
+echo   "hex": "AC!",
+echo   "x-trace": 1
+echo }
+) > test_10\data_success\all_patterns.json
+
+rem Motif ReDoS "(a+)+" sur un texte adverse : échec rapide avec le moteur linéaire
+(
+echo {
+echo   "version": "1.0",
+echo   "code": "aaaaaaaaaaaaaaaaaaaa!"
+echo }
+) > test_10\data_fail\redos_code.json
+
+rem \b : "foo" doit être un mot entier
+(
+echo {
+echo   "version": "1.0",
+echo   "code": "a",
+echo   "word": "foobar"
+echo }
+) > test_10\data_fail\word_boundary.json
+
+rem patternProperties ne couvre que x- suivi d'au moins deux lettres
+(
+echo {
+echo   "version": "1.0",
+echo   "code": "a",
+echo   "x-1": 1
+echo }
+) > test_10\data_fail\pattern_property.json
+
+echo.
+echo [OK] Le schéma des motifs regex et les fichiers de test ont été créés dans le dossier "test_10".
+pause
@@ -0,0 +1,96 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QStringList>
+
+#include "SwJsonSchema.h"
+
+//--------------------------------------------------------------------
+// SwJsonSchemaAnalyze <schema.json>... [--fail-on <info|warning|critical>]
+//                     [--regex-engine <backtracking|linear|fallback>]
+//                     [--fan-out <avertissement> <critique>]
+//
+// Analyse statique des coûts au pire cas (SwJsonSchema::analyzeComplexity()) avant
+// d'accepter un schéma : motifs sujets au retour arrière, éventail des anyOf / oneOf,
+// uniqueItems non borné, cycles de $ref, patternProperties nombreux.
+//
+//   --fail-on       gravité à partir de laquelle le code de sortie vaut 1 (défaut : critical)
+//   --regex-engine  moteur des "pattern" supposé à la validation (défaut : backtracking) ;
+//                   avec le moteur linéaire, les motifs à risque ne sont plus que signalés
+//   --fan-out       seuils d'éventail (branches évaluées par position de l'instance)
+//
+// Code de sortie : 0 sans constat bloquant, 1 sinon (ou schéma illisible), 2 si usage incorrect.
+//--------------------------------------------------------------------
+
+static QString severityName(SwJsonSchema::ComplexityFinding::Severity severity)
+{
+    switch (severity) {
+    case SwJsonSchema::ComplexityFinding::Critical: return "critique";
+    case SwJsonSchema::ComplexityFinding::Warning:  return "avertissement";
+    default:                                        return "info";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    QString failOn = "critical";
+    QString regexEngine;
+    SwJsonSchema::ComplexityThresholds thresholds;
+    bool usageError = false;
+    for (int i = 0; i < args.size();) {
+        if ((args.at(i) == "--fail-on" || args.at(i) == "--regex-engine") && i + 1 < args.size()) {
+            (args.at(i) == "--fail-on" ? failOn : regexEngine) = args.at(i + 1);
+            args.erase(args.begin() + i, args.begin() + i + 2);
+        } else if (args.at(i) == "--fan-out" && i + 2 < args.size()) {
+            bool okWarning = false;
+            bool okCritical = false;
+            thresholds.fanOutWarning = args.at(i + 1).toLongLong(&okWarning);
+            thresholds.fanOutCritical = args.at(i + 2).toLongLong(&okCritical);
+            usageError = usageError || !okWarning || !okCritical;
+            args.erase(args.begin() + i, args.begin() + i + 3);
+        } else {
+            ++i;
+        }
+    }
+    const QStringList severities = {"info", "warning", "critical"};
+    if (args.isEmpty() || usageError || !severities.contains(failOn)) {
+        qWarning().noquote() << "Usage : SwJsonSchemaAnalyze <schema.json>... [--fail-on <info|warning|critical>]"
+                                " [--regex-engine <backtracking|linear|fallback>] [--fan-out <avertissement> <critique>]";
+        return 2;
+    }
+    const auto blocking = SwJsonSchema::ComplexityFinding::Severity(severities.indexOf(failOn));
+
+    if (regexEngine == "linear") {
+        SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Linear);
+    } else if (regexEngine == "fallback") {
+        SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::LinearWithFallback);
+    }
+
+    int failed = 0;
+    for (const QString &schemaPath : args) {
+        SwJsonSchema schema(schemaPath);
+        if (!schema.isValide()) {
+            qWarning().noquote() << "Schéma invalide ou illisible :" << schemaPath;
+            ++failed;
+            continue;
+        }
+        const SwJsonSchema::ComplexityReport report = schema.analyzeComplexity(thresholds);
+        qDebug().noquote() << QString("%1 : %2 noeuds, au pire %3 évaluations d'un même noeud par position, "
+                                      "%4 critiques, %5 avertissements")
+                                  .arg(schemaPath).arg(report.nodes).arg(report.maxNodeEvaluations)
+                                  .arg(report.count(SwJsonSchema::ComplexityFinding::Critical))
+                                  .arg(report.count(SwJsonSchema::ComplexityFinding::Warning)
+                                       - report.count(SwJsonSchema::ComplexityFinding::Critical));
+        for (const SwJsonSchema::ComplexityFinding &finding : report.findings) {
+            qDebug().noquote() << QString("  [%1] %2 %3 (%4) : %5")
+                                      .arg(severityName(finding.severity), finding.kind, finding.location)
+                                      .arg(finding.cost, finding.message);
+        }
+        if (report.count(blocking) > 0) {
+            ++failed;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,1003 @@
+#pragma once
+
+#include "SwJsonSchema.h"
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Génère un validateur C++ spécialisé à partir d'un schéma chargé.
+ *
+ * Le générateur parcourt l'arbre compilé de SwJsonSchema (mêmes noeuds, mêmes $ref
+ * résolues, même ordre d'évaluation) et émet une fonction par noeud : noms de propriétés,
+ * bornes, enum / const et expressions régulières deviennent des constantes, la récursion
+ * et l'aiguillage par type de validateInternal() sont déroulés. Le code produit rend le
+ * même verdict et les mêmes messages d'erreur que la validation interprétée.
+ *
+ * Le fichier généré est un en-tête autonome :
+ * @code
+ *   inline bool <nom>(const QJsonValue &value, QString *errorMessage = nullptr);
+ * @endcode
+ * Les mots-clés personnalisés enregistrés avant le chargement du schéma sont conservés :
+ * le code généré appelle SwJsonSchema::validateCustomKeyword() à l'exécution.
+ */
+class SwJsonSchemaCodeGenerator
+{
+public:
+    explicit SwJsonSchemaCodeGenerator(const SwJsonSchema &schema)
+        : m_root(&schema)
+    {
+    }
+
+    /// Source du schéma, reprise dans l'en-tête du fichier généré.
+    void setSourceName(const QString &sourceName)
+    {
+        m_sourceName = sourceName;
+    }
+
+    /**
+     * @brief Génère l'en-tête du validateur.
+     * @param functionName  Nom de la fonction de validation (identifiant C++)
+     */
+    QString generate(const QString &functionName)
+    {
+        m_ids.clear();
+        m_order.clear();
+        collect(m_root);
+        computeCycles();
+
+        const QString ns = functionName + "_generated";
+        QString out;
+        out += "// Fichier généré par SwJsonSchemaCodegen";
+        if (!m_sourceName.isEmpty()) {
+            out += " à partir de \"" + m_sourceName + "\"";
+        }
+        out += " : ne pas modifier.\n";
+        out += "#pragma once\n\n";
+        out += "#include \"SwJsonSchema.h\"\n\n";
+        out += "#include <QBitArray>\n#include <QHash>\n#include <QJsonArray>\n#include <QJsonDocument>\n"
+               "#include <QJsonObject>\n#include <QJsonValue>\n"
+               "#include <QSet>\n#include <QtMath>\n#include <cmath>\n\n";
+        out += "namespace " + ns + " {\n\n";
+        out += runtimeSupport();
+        for (const SwJsonSchema *node : m_order) {
+            out += "inline bool " + fn(node) + "(const QJsonValue &value, Context &ctx, QString *errorMessage);\n";
+        }
+        out += "\n";
+        for (const SwJsonSchema *node : m_order) {
+            out += emitNode(node);
+        }
+        out += "} // namespace " + ns + "\n\n";
+        out += "/**\n * @brief Valide `value` (validateur généré";
+        if (!m_sourceName.isEmpty()) {
+            out += " pour \"" + m_sourceName + "\"";
+        }
+        out += ").\n */\n";
+        out += "inline bool " + functionName + "(const QJsonValue &value, QString *errorMessage = nullptr)\n{\n"
+               "    " + ns + "::Context ctx;\n"
+               "    return " + ns + "::" + fn(m_root) + "(value, ctx, errorMessage);\n}\n";
+        return out;
+    }
+
+    /// Nombre de noeuds (fonctions) émis par le dernier appel à generate().
+    int nodeCount() const
+    {
+        return m_order.size();
+    }
+
+    /// Identifiant C++ dérivé d'un nom de fichier ("order-v2.json" -> "validate_order_v2").
+    static QString functionNameFor(const QString &baseName)
+    {
+        QString name = "validate_";
+        for (const QChar c : baseName) {
+            name += (c.isLetterOrNumber() && c.unicode() < 128) ? c : QChar('_');
+        }
+        return name;
+    }
+
+private:
+    using Step = SwJsonSchema::EvaluationStep;
+    using Type = SwJsonSchema::SchemaType;
+
+    // -----------------------------------------------------------------------
+    //                   Parcours de l'arbre compilé
+    // -----------------------------------------------------------------------
+    void collect(const SwJsonSchema *node)
+    {
+        if (!node || m_ids.contains(node)) {
+            return;
+        }
+        m_ids.insert(node, m_order.size());
+        m_order << node;
+        if (node->isReference()) {
+            collect(node->resolveReference());
+            return;
+        }
+        for (const SwJsonSchema *child : sameInstanceChildren(node)) {
+            collect(child);
+        }
+        for (auto it = node->m_properties.cbegin(); it != node->m_properties.cend(); ++it) {
+            collect(it.value().data());
+        }
+        for (auto it = node->cold().patternProperties.cbegin(); it != node->cold().patternProperties.cend(); ++it) {
+            collect(it.value().data());
+        }
+        collect(node->m_additionalPropertiesSchema.data());
+        collect(node->m_itemsSchema.data());
+        for (const QSharedPointer<SwJsonSchema> &prefix : node->m_prefixItemsSchemas) {
+            collect(prefix.data());
+        }
+        collect(node->cold().additionalItemsSchema.data());
+        collect(node->cold().containsSchema.data());
+        collect(node->cold().unevaluatedPropertiesSchema.data());
+        collect(node->cold().unevaluatedItemsSchema.data());
+        collect(node->m_recursiveSchema);
+    }
+
+    /// Sous-schémas appliqués à la même instance (sans descente).
+    static QVector<const SwJsonSchema*> sameInstanceChildren(const SwJsonSchema *node)
+    {
+        QVector<const SwJsonSchema*> children;
+        if (node->isReference()) {
+            if (const SwJsonSchema *target = node->resolveReference()) {
+                children << target;
+            }
+            return children;
+        }
+        for (const QSharedPointer<SwJsonSchema> &branch : node->m_allOf) children << branch.data();
+        for (const QSharedPointer<SwJsonSchema> &branch : node->cold().anyOf) children << branch.data();
+        for (const QSharedPointer<SwJsonSchema> &branch : node->cold().oneOf) children << branch.data();
+        if (node->cold().notSchema) children << node->cold().notSchema.data();
+        if (node->cold().ifSchema) children << node->cold().ifSchema.data();
+        if (node->cold().thenSchema) children << node->cold().thenSchema.data();
+        if (node->cold().elseSchema) children << node->cold().elseSchema.data();
+        return children;
+    }
+
+    /// Noeuds pouvant se rappeler sans descendre dans l'instance : seuls à garder la détection de récursion.
+    void computeCycles()
+    {
+        m_cyclic.clear();
+        for (const SwJsonSchema *start : m_order) {
+            QSet<const SwJsonSchema*> seen;
+            QVector<const SwJsonSchema*> stack = sameInstanceChildren(start);
+            while (!stack.isEmpty()) {
+                const SwJsonSchema *node = stack.takeLast();
+                if (node == start) {
+                    m_cyclic.insert(start);
+                    break;
+                }
+                if (seen.contains(node)) {
+                    continue;
+                }
+                seen.insert(node);
+                stack << sameInstanceChildren(node);
+            }
+        }
+    }
+
+    QString fn(const SwJsonSchema *node) const
+    {
+        return "n" + QString::number(m_ids.value(node));
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Littéraux
+    // -----------------------------------------------------------------------
+    /// Déclaration d'un motif compilé une fois, avec le moteur retenu au chargement du schéma.
+    static QString regexDecl(const QString &name, const SwJsonSchemaRegex &regex)
+    {
+        return "static const SwJsonSchemaRegex " + name + "(" + str(regex.pattern()) + ", SwJsonSchemaRegex::"
+               + (regex.engine() == SwJsonSchemaRegex::Linear ? "Linear" : "Backtracking") + ");\n";
+    }
+
+    static QString str(const QString &text)
+    {
+        QString out = "QStringLiteral(\"";
+        for (const QChar c : text) {
+            const ushort u = c.unicode();
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else if (u < 0x20 || u == 0x7f) {
+                out += QString("\\%1").arg(u, 3, 8, QChar('0'));
+            } else if (c == '?') {
+                out += "\\?";  // pas de trigraphes
+            } else {
+                out += c;
+            }
+        }
+        return out + "\")";
+    }
+
+    static QString num(double value)
+    {
+        return QString::number(value, 'g', 17);
+    }
+
+    /// Valeur JSON reconstruite une fois (variable statique), forme texte compacte.
+    static QString json(const QJsonValue &value)
+    {
+        const QByteArray compact = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+        return "jsonValue(" + str(QString::fromUtf8(compact)) + ")";
+    }
+
+    /// Masque de types (SwJsonSchema::typeBit) sous forme de littéral.
+    static QString mask(SwJsonSchema::TypeMask types)
+    {
+        return QString::number(uint(types));
+    }
+
+    static QString stepName(Step step)
+    {
+        switch (step) {
+        case Step::Conditional:  return "conditional";
+        case Step::Not:          return "not";
+        case Step::AllOf:        return "allOf";
+        case Step::AnyOf:        return "anyOf";
+        case Step::OneOf:        return "oneOf";
+        case Step::Enum:         return "enum";
+        case Step::Const:        return "const";
+        case Step::Type:         return "type";
+        case Step::TypeSpecific: return "typeSpecific";
+        case Step::Custom:       return "custom";
+        case Step::Unevaluated:  return "unevaluated";
+        }
+        return QString();
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Support d'exécution (commun aux noeuds)
+    // -----------------------------------------------------------------------
+    static QString runtimeSupport()
+    {
+        return QStringLiteral(R"(struct Context {
+    int depth = 0;                  // profondeur dans l'instance
+    QBitArray *evaluated = nullptr; // annotations unevaluated* en cours
+};
+
+inline bool setError(QString *errorMessage, const QString &msg)
+{
+    if (errorMessage) {
+        *errorMessage = msg;
+    }
+    return false;
+}
+
+inline QJsonValue jsonValue(const QString &compactArray)
+{
+    return QJsonDocument::fromJson(compactArray.toUtf8()).array().at(0);
+}
+
+inline QString typeName(const QJsonValue &v)
+{
+    if (v.isString())  return QStringLiteral("string");
+    if (v.isBool())    return QStringLiteral("boolean");
+    if (v.isObject())  return QStringLiteral("object");
+    if (v.isArray())   return QStringLiteral("array");
+    if (v.isNull())    return QStringLiteral("null");
+    if (v.isDouble()) {
+        double value = v.toDouble();
+        return std::floor(value) == value ? QStringLiteral("integer") : QStringLiteral("number");
+    }
+    return QStringLiteral("undefined");
+}
+
+inline QByteArray canonical(const QJsonValue &value)
+{
+    return QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+}
+
+// Descente dans l'instance : annotations du parent suspendues
+struct Descent {
+    explicit Descent(Context &ctx) : m_ctx(ctx), m_evaluated(ctx.evaluated)
+    {
+        m_ctx.evaluated = nullptr;
+        ++m_ctx.depth;
+    }
+    ~Descent()
+    {
+        m_ctx.evaluated = m_evaluated;
+        --m_ctx.depth;
+    }
+    Context &m_ctx;
+    QBitArray *m_evaluated;
+};
+
+// Noeud actif à cette profondeur : un nouvel appel sans descente est une récursion
+struct RecursionGuard {
+    RecursionGuard(int &active, int depth) : m_active(active), m_previous(active)
+    {
+        m_active = depth;
+    }
+    ~RecursionGuard()
+    {
+        m_active = m_previous;
+    }
+    int &m_active;
+    int m_previous;
+};
+
+// Branche dont l'échec n'invalide pas le noeud : annotations retenues seulement en cas de succès
+template <typename F>
+inline bool isolated(F validate, const QJsonValue &value, Context &ctx, QString *errorMessage)
+{
+    if (!ctx.evaluated) {
+        return validate(value, ctx, errorMessage);
+    }
+    QBitArray *outer = ctx.evaluated;
+    QBitArray branch(outer->size());
+    ctx.evaluated = &branch;
+    bool ok = validate(value, ctx, errorMessage);
+    ctx.evaluated = outer;
+    if (ok) {
+        *outer |= branch;
+    }
+    return ok;
+}
+
+// Évaluation collectant les propriétés / éléments évalués (unevaluated*)
+template <typename F>
+inline bool annotated(F steps, const QJsonValue &value, Context &ctx)
+{
+    QBitArray *outer = ctx.evaluated;
+    QBitArray evaluated(value.isObject() ? value.toObject().size() : value.toArray().size());
+    ctx.evaluated = &evaluated;
+    bool ok = steps();
+    ctx.evaluated = outer;
+    if (ok && outer) {
+        *outer |= evaluated;
+    }
+    return ok;
+}
+
+)");
+    }
+
+    // -----------------------------------------------------------------------
+    //                   Émission d'un noeud
+    // -----------------------------------------------------------------------
+    QString emitNode(const SwJsonSchema *node)
+    {
+        QString out;
+        const QString name = fn(node);
+        QVector<Step> steps = node->m_steps;
+        if (!node->isReference()) {
+            for (Step step : steps) {
+                out += "inline bool " + name + "_" + stepName(step)
+                       + "(const QJsonValue &value, SwJsonSchema::SchemaType type, Context &ctx, QString *errorMessage)\n{\n"
+                       + "    Q_UNUSED(type);\n" + emitStep(node, step) + "}\n\n";
+            }
+        }
+
+        out += "inline bool " + name + "(const QJsonValue &value, Context &ctx, QString *errorMessage)\n{\n";
+        if (node->m_constant != SwJsonSchema::Constant::None) {
+            // Schéma booléen : résultat constant
+            out += "    Q_UNUSED(value); Q_UNUSED(ctx);\n";
+            out += node->acceptsAll() ? QString("    Q_UNUSED(errorMessage);\n    return true;\n}\n\n")
+                                      : "    return setError(errorMessage, " + str(SwJsonSchema::falseSchemaError()) + ");\n}\n\n";
+            return out;
+        }
+        if (m_cyclic.contains(node)) {
+            out += "    static thread_local int active = -1;\n"
+                   "    if (active == ctx.depth) {\n"
+                   "        return setError(errorMessage, " + str("Récursion de schémas détectée.") + ");\n"
+                   "    }\n"
+                   "    RecursionGuard guard(active, ctx.depth);\n";
+        }
+        if (node->isReference()) {
+            const SwJsonSchema *target = node->resolveReference();
+            if (!target) {
+                out += "    Q_UNUSED(value); Q_UNUSED(ctx);\n";
+                out += "    return setError(errorMessage, "
+                       + str(QString("Impossible de résoudre la référence '%1'.").arg(node->m_dollarRef)) + ");\n}\n\n";
+            } else {
+                out += "    return " + fn(target) + "(value, ctx, errorMessage);\n}\n\n";
+            }
+            return out;
+        }
+        if (steps.isEmpty()) {
+            out += "    Q_UNUSED(value); Q_UNUSED(ctx); Q_UNUSED(errorMessage);\n    return true;\n}\n\n";
+            return out;
+        }
+
+        auto chain = [&](const QVector<Step> &order) {
+            QStringList calls;
+            for (Step step : order) {
+                calls << name + "_" + stepName(step) + "(value, type, ctx, errorMessage)";
+            }
+            return calls.join("\n            && ");
+        };
+        const QString body = "errorMessage\n        ? (" + chain(node->m_steps) + ")\n        : (" + chain(node->m_costOrderedSteps) + ")";
+        // Type de l'instance calculé une fois pour toutes les étapes du noeud
+        out += "    const SwJsonSchema::SchemaType type = SwJsonSchema::instanceType(value);\n";
+        QStringList collects;
+        if (node->cold().unevaluatedPropertiesSchema) collects << "value.isObject()";
+        if (node->cold().unevaluatedItemsSchema) collects << "value.isArray()";
+        if (!collects.isEmpty()) {
+            out += "    if (Q_UNLIKELY(" + collects.join(" || ") + ")) {\n"
+                   "        return annotated([&]() { return " + body + "; }, value, ctx);\n    }\n";
+        }
+        out += "    return " + body + ";\n}\n\n";
+        return out;
+    }
+
+    QString emitStep(const SwJsonSchema *node, Step step)
+    {
+        switch (step) {
+        case Step::Conditional: return emitConditional(node);
+        case Step::Not:         return emitNot(node);
+        case Step::AllOf:       return emitAllOf(node);
+        case Step::AnyOf:       return emitAnyOf(node);
+        case Step::OneOf:       return emitOneOf(node);
+        case Step::Enum:        return emitEnum(node);
+        case Step::Const:
+            return "    Q_UNUSED(ctx);\n"
+                   "    static const QJsonValue expected = " + json(node->cold().constValue) + ";\n"
+                   "    if (expected != value) {\n"
+                   "        return setError(errorMessage, " + str("Valeur différente de 'const'.") + ");\n"
+                   "    }\n    return true;\n";
+        case Step::Type:
+            return "    Q_UNUSED(ctx);\n"
+                   "    if (!(" + mask(node->m_types) + " & SwJsonSchema::typeBit(type))) {\n"
+                   "        return setError(errorMessage, QString(" + str("Type invalide. Attendu: %1, reçu: %2") + ")\n"
+                   "                                          .arg(" + str(SwJsonSchema::toString(node->m_types)) + ")\n"
+                   "                                          .arg(typeName(value)));\n"
+                   "    }\n    return true;\n";
+        case Step::TypeSpecific: return emitTypeSpecific(node);
+        case Step::Custom:       return emitCustom(node);
+        case Step::Unevaluated:  return emitUnevaluated(node);
+        }
+        return "    return true;\n";
+    }
+
+    // -- combinateurs --
+    QString emitConditional(const SwJsonSchema *node)
+    {
+        QString out = "    if (isolated(" + fn(node->cold().ifSchema.data()) + ", value, ctx, nullptr)) {\n";
+        if (node->cold().thenSchema) {
+            out += "        return " + fn(node->cold().thenSchema.data()) + "(value, ctx, errorMessage);\n";
+        } else {
+            out += "        return true;\n";
+        }
+        out += "    }\n";
+        if (node->cold().elseSchema) {
+            out += "    return " + fn(node->cold().elseSchema.data()) + "(value, ctx, errorMessage);\n";
+        } else {
+            out += "    return true;\n";
+        }
+        return out;
+    }
+
+    QString emitNot(const SwJsonSchema *node)
+    {
+        return "    QBitArray *outer = ctx.evaluated;\n"
+               "    ctx.evaluated = nullptr;\n"
+               "    bool satisfied = " + fn(node->cold().notSchema.data()) + "(value, ctx, nullptr);\n"
+               "    ctx.evaluated = outer;\n"
+               "    if (satisfied) {\n"
+               "        return setError(errorMessage, " + str("Le schéma 'not' est satisfait, ce qui est interdit.") + ");\n"
+               "    }\n    return true;\n";
+    }
+
+    QString emitAllOf(const SwJsonSchema *node)
+    {
+        QString out;
+        for (int i = 0; i < node->m_allOf.size(); ++i) {
+            out += "    if (!" + fn(node->m_allOf.at(i).data()) + "(value, ctx, errorMessage)) {\n"
+                   "        return setError(errorMessage, QString(" + str("Echec de allOf[%1]. %2") + ")\n"
+                   "                                          .arg(" + QString::number(i) + ")\n"
+                   "                                          .arg(errorMessage ? *errorMessage : QString()));\n"
+                   "    }\n";
+        }
+        return out + "    return true;\n";
+    }
+
+    /// Table discriminant -> branches candidates (variable statique) ; vide si pas de discriminant.
+    QString emitDiscriminator(const SwJsonSchema::Discriminator &discriminator)
+    {
+        if (discriminator.property.isEmpty()) {
+            return "    const QVector<int> *candidates = nullptr;\n";
+        }
+        QString out = "    static const QHash<QByteArray, QVector<int>> table = []() {\n"
+                      "        QHash<QByteArray, QVector<int>> t;\n";
+        QList<QByteArray> keys = discriminator.branches.keys();
+        std::sort(keys.begin(), keys.end());
+        for (const QByteArray &key : keys) {
+            QStringList indices;
+            for (int i : discriminator.branches.value(key)) {
+                indices << QString::number(i);
+            }
+            out += "        t.insert(" + str(QString::fromUtf8(key)) + ".toUtf8(), QVector<int>{ " + indices.join(", ") + " });\n";
+        }
+        out += "        return t;\n    }();\n"
+               "    static const QVector<int> none;\n"
+               "    const QVector<int> *candidates = nullptr;\n"
+               "    if (value.isObject()) {\n"
+               "        const QJsonObject obj = value.toObject();\n"
+               "        auto it = obj.constFind(" + str(discriminator.property) + ");\n"
+               "        if (it != obj.constEnd()) {\n"
+               "            auto bit = table.constFind(canonical(it.value()));\n"
+               "            candidates = (bit == table.constEnd()) ? &none : &bit.value();\n"
+               "        }\n"
+               "    }\n";
+        return out;
+    }
+
+    QString branchTable(const QList<QSharedPointer<SwJsonSchema>> &branches)
+    {
+        QStringList fns;
+        for (const QSharedPointer<SwJsonSchema> &branch : branches) {
+            fns << fn(branch.data());
+        }
+        return "    using Branch = bool (*)(const QJsonValue &, Context &, QString *);\n"
+               "    static const Branch branches[] = { " + fns.join(", ") + " };\n";
+    }
+
+    QString emitAnyOf(const SwJsonSchema *node)
+    {
+        QString out = branchTable(node->cold().anyOf) + emitDiscriminator(node->cold().anyOfDiscriminator);
+        out += "    const int count = candidates ? int(candidates->size()) : " + QString::number(node->cold().anyOf.size()) + ";\n"
+               "    bool matched = false;\n"
+               "    for (int c = 0; c < count; ++c) {\n"
+               "        const int i = candidates ? candidates->at(c) : c;\n"
+               "        QString localErr;\n"
+               "        if (isolated(branches[i], value, ctx, errorMessage ? &localErr : nullptr)) {\n"
+               "            matched = true;\n"
+               "            if (!ctx.evaluated) {\n"
+               "                return true;\n"
+               "            }\n"
+               "        }\n"
+               "    }\n"
+               "    if (matched) {\n        return true;\n    }\n"
+               "    return setError(errorMessage, " + str("Aucun schéma dans 'anyOf' n'est satisfait.") + ");\n";
+        return out;
+    }
+
+    QString emitOneOf(const SwJsonSchema *node)
+    {
+        const SwJsonSchema::Discriminator &discriminator = node->cold().oneOfDiscriminator;
+        QString out = branchTable(node->cold().oneOf) + emitDiscriminator(discriminator);
+        out += "    int countValid = 0;\n"
+               "    QString lastError;\n";
+        if (!discriminator.property.isEmpty()) {
+            out += "    if (candidates && candidates->isEmpty()) {\n"
+                   "        lastError = " + str(QString("Valeur de '%1' ne correspondant à aucune branche.").arg(discriminator.property)) + ";\n"
+                   "    }\n";
+        }
+        out += "    const int count = candidates ? int(candidates->size()) : " + QString::number(node->cold().oneOf.size()) + ";\n"
+               "    for (int c = 0; c < count; ++c) {\n"
+               "        const int i = candidates ? candidates->at(c) : c;\n"
+               "        QString localErr;\n"
+               "        if (isolated(branches[i], value, ctx, errorMessage ? &localErr : nullptr)) {\n"
+               "            countValid++;\n"
+               "            if (countValid > 1) {\n"
+               "                return setError(errorMessage, " + str("Plus d'un schéma dans 'oneOf' est satisfait.") + ");\n"
+               "            }\n"
+               "        } else {\n"
+               "            lastError = localErr;\n"
+               "        }\n"
+               "    }\n"
+               "    if (countValid == 1) {\n        return true;\n    }\n"
+               "    return setError(errorMessage, QString(" + str("Aucun schéma dans 'oneOf' n'est satisfait. Dernière erreur: %1") + ").arg(lastError));\n";
+        return out;
+    }
+
+    QString emitEnum(const SwJsonSchema *node)
+    {
+        QJsonArray values;
+        for (const QJsonValue &v : node->cold().enumValues) {
+            values.append(v);
+        }
+        return "    Q_UNUSED(ctx);\n"
+               "    static const QJsonArray values = jsonValue(" + str(QString::fromUtf8(QJsonDocument(QJsonArray{QJsonValue(values)}).toJson(QJsonDocument::Compact))) + ").toArray();\n"
+               "    for (const QJsonValue &ev : values) {\n"
+               "        if (ev == value) {\n            return true;\n        }\n"
+               "    }\n"
+               "    return setError(errorMessage, " + str("Valeur non listée dans 'enum'.") + ");\n";
+    }
+
+    QString emitCustom(const SwJsonSchema *node)
+    {
+        QString out = "    Q_UNUSED(ctx);\n";
+        int i = 0;
+        for (const KeywordJsonValidator &custom : node->cold().internalCustomKeywordValidator) {
+            const QString rules = "rules" + QString::number(i++);
+            out += "    {\n"
+                   "        static const QJsonValue " + rules + " = " + json(custom.rules()) + ";\n"
+                   "        QString localErr;\n"
+                   "        if (!SwJsonSchema::validateCustomKeyword(" + str(custom.keyword()) + ", " + rules + ", value, &localErr)) {\n"
+                   "            return setError(errorMessage, QString(" + str("Validation failed with error: %1") + ").arg(localErr));\n"
+                   "        }\n"
+                   "    }\n";
+        }
+        return out + "    return true;\n";
+    }
+
+    // -- contraintes propres au type --
+    QString emitTypeSpecific(const SwJsonSchema *node)
+    {
+        // Aiguillage sur le type de l'instance, limité aux types admis ayant des contraintes
+        const SwJsonSchema::TypeMask types = node->m_types;
+        auto allowed = [&](Type type) {
+            return types == 0 || (types & SwJsonSchema::typeBit(type));
+        };
+        QString out = "    Q_UNUSED(ctx); Q_UNUSED(errorMessage);\n";
+        if (allowed(Type::String) && hasStringConstraints(node)) {
+            out += "    if (type == SwJsonSchema::SchemaType::String) {\n" + indent(emitString(node)) + "    }\n";
+        }
+        QStringList numbers;
+        if (allowed(Type::Number)) numbers << "type == SwJsonSchema::SchemaType::Number";
+        if (allowed(Type::Integer)) numbers << "type == SwJsonSchema::SchemaType::Integer";
+        if (!numbers.isEmpty() && hasNumberConstraints(node)) {
+            out += "    if (" + numbers.join(" || ") + ") {\n" + indent(emitNumber(node)) + "    }\n";
+        }
+        if (allowed(Type::Object) && hasObjectConstraints(node)) {
+            out += "    if (type == SwJsonSchema::SchemaType::Object) {\n" + indent(emitObject(node)) + "    }\n";
+        }
+        if (allowed(Type::Array) && hasArrayConstraints(node)) {
+            out += "    if (type == SwJsonSchema::SchemaType::Array) {\n" + indent(emitArray(node)) + "    }\n";
+        }
+        return out + "    return true;\n";
+    }
+
+    static bool hasStringConstraints(const SwJsonSchema *node)
+    {
+        return node->m_minLength >= 0 || node->m_maxLength >= 0 || node->cold().hasPattern || !node->cold().format.isEmpty();
+    }
+
+    static bool hasNumberConstraints(const SwJsonSchema *node)
+    {
+        return (node->cold().hasMultipleOf && !qFuzzyIsNull(node->cold().multipleOf)) || node->m_hasMinimum || node->m_hasMaximum;
+    }
+
+    static bool hasObjectConstraints(const SwJsonSchema *node)
+    {
+        return !node->m_required.isEmpty() || !node->cold().dependentRequired.isEmpty() || !node->m_properties.isEmpty()
+               || !node->cold().patternProperties.isEmpty() || node->m_additionalPropertiesSchema || node->m_recursiveSchema;
+    }
+
+    static bool hasArrayConstraints(const SwJsonSchema *node)
+    {
+        return node->m_minItems >= 0 || node->m_maxItems >= 0 || node->m_uniqueItems || !node->m_prefixItemsSchemas.isEmpty()
+               || node->m_itemsSchema || node->cold().containsSchema;
+    }
+
+    static QString indent(const QString &code)
+    {
+        QStringList lines = code.split('\n');
+        for (QString &line : lines) {
+            if (!line.isEmpty()) {
+                line.prepend("    ");
+            }
+        }
+        return lines.join('\n');
+    }
+
+    QString emitString(const SwJsonSchema *node)
+    {
+        QString out = "    {\n    const QString str = value.toString();\n";
+        if (node->m_minLength >= 0) {
+            out += "    if (str.size() < " + QString::number(node->m_minLength) + ") {\n"
+                   "        return setError(errorMessage, QString(" + str("Longueur trop petite: %1 < %2") + ").arg(str.size()).arg("
+                   + QString::number(node->m_minLength) + "));\n    }\n";
+        }
+        if (node->m_maxLength >= 0) {
+            out += "    if (str.size() > " + QString::number(node->m_maxLength) + ") {\n"
+                   "        return setError(errorMessage, QString(" + str("Longueur trop grande: %1 > %2") + ").arg(str.size()).arg("
+                   + QString::number(node->m_maxLength) + "));\n    }\n";
+        }
+        if (node->cold().hasPattern) {
+            out += "    " + regexDecl("pattern", node->cold().patternRegex)
+                   + "    if (!pattern.match(str)) {\n"
+                   "        return setError(errorMessage, " + str(QString("Ne correspond pas au pattern: %1").arg(node->cold().pattern)) + ");\n"
+                   "    }\n";
+        }
+        if (!node->cold().format.isEmpty()) {
+            out += "    if (!SwJsonSchema::validateFormat(str, " + str(node->cold().format) + ", errorMessage)) {\n"
+                   "        return false;\n    }\n";
+        }
+        return out + "    return true;\n    }\n";
+    }
+
+    QString emitNumber(const SwJsonSchema *node)
+    {
+        QString out = "    {\n";
+        out += "    const double d = value.toDouble();\n"
+               "    Q_UNUSED(d);\n";
+        if (node->cold().hasMultipleOf && !qFuzzyIsNull(node->cold().multipleOf)) {
+            out += "    {\n"
+                   "        double ratio = d / " + num(node->cold().multipleOf) + ";\n"
+                   "        double frac = ratio - qFloor(ratio);\n"
+                   "        if (qAbs(frac) > 1e-12 && qAbs(frac - 1.0) > 1e-12) {\n"
+                   "            return setError(errorMessage, QString(" + str("%1 n'est pas multiple de %2") + ").arg(d).arg(" + num(node->cold().multipleOf) + "));\n"
+                   "        }\n"
+                   "    }\n";
+        }
+        if (node->m_hasMinimum) {
+            if (node->m_exclusiveMinimum) {
+                out += "    if (!(d > " + num(node->m_minimum) + ")) {\n"
+                       "        return setError(errorMessage, QString(" + str("Doit être > %1 (exclusiveMinimum)") + ").arg(" + num(node->m_minimum) + "));\n    }\n";
+            } else {
+                out += "    if (d < " + num(node->m_minimum) + ") {\n"
+                       "        return setError(errorMessage, QString(" + str("Doit être >= %1") + ").arg(" + num(node->m_minimum) + "));\n    }\n";
+            }
+        }
+        if (node->m_hasMaximum) {
+            if (node->m_exclusiveMaximum) {
+                out += "    if (!(d < " + num(node->m_maximum) + ")) {\n"
+                       "        return setError(errorMessage, QString(" + str("Doit être < %1 (exclusiveMaximum)") + ").arg(" + num(node->m_maximum) + "));\n    }\n";
+            } else {
+                out += "    if (d > " + num(node->m_maximum) + ") {\n"
+                       "        return setError(errorMessage, QString(" + str("Doit être <= %1") + ").arg(" + num(node->m_maximum) + "));\n    }\n";
+            }
+        }
+        return out + "    return true;\n    }\n";
+    }
+
+    /// Appel d'un sous-schéma sur un enfant de l'instance ; `message` reçoit localErr en %N final.
+    QString childCheck(const SwJsonSchema *child, const QString &valueExpr, const QString &message,
+                       const QString &args, const QString &pad) const
+    {
+        // true : rien à valider
+        if (child->acceptsAll()) {
+            return QString();
+        }
+        return pad + "{\n"
+             + pad + "    Descent descent(ctx);\n"
+             + pad + "    QString localErr;\n"
+             + pad + "    if (!" + fn(child) + "(" + valueExpr + ", ctx, errorMessage ? &localErr : nullptr)) {\n"
+             + pad + "        return setError(errorMessage, QString(" + str(message) + ")" + args + ".arg(localErr));\n"
+             + pad + "    }\n"
+             + pad + "}\n";
+    }
+
+    /// properties de `owner` (noeud courant ou racine récursive).
+    QString emitProperties(const SwJsonSchema *owner)
+    {
+        QString out;
+        for (auto it = owner->m_properties.cbegin(); it != owner->m_properties.cend(); ++it) {
+            out += "    {\n"
+                   "        auto found = obj.constFind(" + str(it.key()) + ");\n"
+                   "        if (found != obj.constEnd()) {\n"
+                   "            if (evaluated) evaluated->setBit(int(found - obj.constBegin()));\n"
+                   + childCheck(it.value().data(), "found.value()", "Propriété '%1' invalide: %2",
+                                ".arg(" + str(it.key()) + ")", "            ")
+                   + "        }\n"
+                   "    }\n";
+        }
+        return out;
+    }
+
+    /// patternProperties de `owner` (cf. SwJsonSchema::validatePatternProperties).
+    QString emitPatternProperties(const SwJsonSchema *owner)
+    {
+        QString out;
+        int p = 0;
+        for (auto pit = owner->cold().patternProperties.cbegin(); pit != owner->cold().patternProperties.cend(); ++pit, ++p) {
+            out += "    {\n"
+                   "        " + regexDecl("re", owner->cold().patternPropertyRegexes.at(p))
+                   + "        for (auto it = obj.begin(); it != obj.end(); ++it) {\n"
+                   "            if (re.match(it.key())) {\n"
+                   "                if (evaluated) evaluated->setBit(int(it - obj.begin()));\n"
+                   + childCheck(pit.value().data(), "it.value()", "Propriété '%1' invalide (patternProperties / %2): %3",
+                                ".arg(it.key()).arg(" + str(pit.key()) + ")", "                ")
+                   + "            }\n"
+                   "        }\n"
+                   "    }\n";
+        }
+        return out;
+    }
+
+    /// additionalProperties de `owner` (cf. SwJsonSchema::validateAdditionalProperties).
+    QString emitAdditional(const SwJsonSchema *owner)
+    {
+        const SwJsonSchema *additional = owner->m_additionalPropertiesSchema.data();
+        if (!additional) {
+            return QString();
+        }
+        QStringList names;
+        for (auto it = owner->m_properties.cbegin(); it != owner->m_properties.cend(); ++it) {
+            names << str(it.key());
+        }
+        QString out = "    {\n";
+        out += "        static const QSet<QString> declared = { " + names.join(", ") + " };\n";
+        QStringList patterns;
+        int p = 0;
+        for (auto it = owner->cold().patternProperties.cbegin(); it != owner->cold().patternProperties.cend(); ++it, ++p) {
+            out += "        " + regexDecl("declaredPattern" + QString::number(p), owner->cold().patternPropertyRegexes.at(p));
+            patterns << "declaredPattern" + QString::number(p) + ".match(it.key())";
+        }
+        // true : seules les annotations sont à produire
+        out += QString(additional->acceptsAll() ? "        for (auto it = obj.begin(); evaluated && it != obj.end(); ++it) {\n"
+                                                : "        for (auto it = obj.begin(); it != obj.end(); ++it) {\n")
+               + "            if (declared.contains(it.key())";
+        for (const QString &pattern : patterns) {
+            out += " || " + pattern;
+        }
+        out += ") {\n                continue;\n            }\n";
+        if (additional->rejectsAll()) {
+            out += "            return setError(errorMessage, QString(" + str("Propriété '%1' non autorisée (additionalProperties=false).")
+                   + ").arg(it.key()));\n";
+        } else {
+            out += "            if (evaluated) evaluated->setBit(int(it - obj.begin()));\n"
+                   + childCheck(additional, "it.value()",
+                                "Propriété '%1' invalide (additionalProperties): %2", ".arg(it.key())", "            ");
+        }
+        out += "        }\n    }\n";
+        return out;
+    }
+
+    QString emitObject(const SwJsonSchema *node)
+    {
+        QString out = "    {\n";
+        out += "    const QJsonObject obj = value.toObject();\n"
+               "    QBitArray *evaluated = ctx.evaluated;\n"
+               "    Q_UNUSED(evaluated);\n";
+        QStringList required = node->m_required.values();
+        std::sort(required.begin(), required.end());
+        for (const QString &req : required) {
+            out += "    if (!obj.contains(" + str(req) + ")) {\n"
+                   "        return setError(errorMessage, " + str(QString("La propriété requise '%1' est manquante.").arg(req)) + ");\n    }\n";
+        }
+        for (auto it = node->cold().dependentRequired.cbegin(); it != node->cold().dependentRequired.cend(); ++it) {
+            out += "    if (obj.contains(" + str(it.key()) + ")) {\n";
+            for (const QString &dep : it.value()) {
+                out += "        if (!obj.contains(" + str(dep) + ")) {\n"
+                       "            return setError(errorMessage, "
+                       + str(QString("La propriété '%1' est requise car '%2' est présent.").arg(dep).arg(it.key())) + ");\n        }\n";
+            }
+            out += "    }\n";
+        }
+        out += emitProperties(node);
+        out += emitPatternProperties(node);
+        out += emitAdditional(node);
+        if (node->m_recursiveSchema) {
+            out += emitProperties(node->m_recursiveSchema);
+            out += emitPatternProperties(node->m_recursiveSchema);
+            out += emitAdditional(node->m_recursiveSchema);
+        }
+        return out + "    return true;\n    }\n";
+    }
+
+    QString emitArray(const SwJsonSchema *node)
+    {
+        QString out = "    {\n";
+        out += "    const QJsonArray arr = value.toArray();\n"
+               "    QBitArray *evaluated = ctx.evaluated;\n"
+               "    Q_UNUSED(evaluated);\n";
+        if (node->m_minItems >= 0) {
+            out += "    if (arr.size() < " + QString::number(node->m_minItems) + ") {\n"
+                   "        return setError(errorMessage, QString(" + str("Trop peu d'éléments: %1 < %2") + ").arg(arr.size()).arg("
+                   + QString::number(node->m_minItems) + "));\n    }\n";
+        }
+        if (node->m_maxItems >= 0) {
+            out += "    if (arr.size() > " + QString::number(node->m_maxItems) + ") {\n"
+                   "        return setError(errorMessage, QString(" + str("Trop d'éléments: %1 > %2") + ").arg(arr.size()).arg("
+                   + QString::number(node->m_maxItems) + "));\n    }\n";
+        }
+        if (node->m_uniqueItems) {
+            out += "    for (int i = 0; i < arr.size(); ++i) {\n"
+                   "        for (int j = i + 1; j < arr.size(); ++j) {\n"
+                   "            if (arr[i] == arr[j]) {\n"
+                   "                return setError(errorMessage, " + str("Doublon trouvé alors que uniqueItems=true.") + ");\n"
+                   "            }\n"
+                   "        }\n"
+                   "    }\n";
+        }
+        out += "    int i = 0;\n    Q_UNUSED(i);\n";
+        for (int p = 0; p < node->m_prefixItemsSchemas.size(); ++p) {
+            out += "    if (i < arr.size()) {\n"
+                   "        if (evaluated) evaluated->setBit(i);\n"
+                   + childCheck(node->m_prefixItemsSchemas.at(p).data(), "arr[i]", "Element [%1] invalide (prefixItems): %2", ".arg(i)", "        ")
+                   + "        ++i;\n"
+                   "    }\n";
+        }
+        const SwJsonSchema *rest = node->m_itemsSchema.data();
+        QString restLabel;
+        if (!node->m_prefixItemsSchemas.isEmpty() && node->cold().additionalItemsSchema) {
+            rest = node->cold().additionalItemsSchema.data();
+            restLabel = " (additionalItems)";
+        }
+        if (rest && rest->rejectsAll()) {
+            // false : simple contrôle de longueur
+            out += "    if (i < arr.size()) {\n"
+                   "        return setError(errorMessage, QString(" + str("Element [%1] invalide" + restLabel + ": %2") + ").arg(i).arg("
+                   + str(SwJsonSchema::falseSchemaError()) + "));\n    }\n";
+        } else if (rest && rest->acceptsAll()) {
+            out += "    if (evaluated) evaluated->fill(true, i, qMax(i, int(arr.size())));\n";
+        } else if (rest) {
+            out += "    for (; i < arr.size(); ++i) {\n"
+                   "        if (evaluated) evaluated->setBit(i);\n"
+                   + childCheck(rest, "arr[i]", "Element [%1] invalide" + restLabel + ": %2", ".arg(i)", "        ")
+                   + "    }\n";
+        }
+        if (node->cold().containsSchema) {
+            out += "    {\n";
+            if (node->cold().containsSchema->acceptsAll()) {
+                out += "        const int count = arr.size();\n"
+                       "        if (evaluated) evaluated->fill(true);\n";
+            } else if (node->cold().containsSchema->rejectsAll()) {
+                out += "        const int count = 0;\n";
+            } else {
+                out += "        int count = 0;\n"
+                       "        for (int k = 0; k < arr.size(); ++k) {\n"
+                       "            Descent descent(ctx);\n"
+                       "            if (" + fn(node->cold().containsSchema.data()) + "(arr[k], ctx, nullptr)) {\n"
+                       "                count++;\n"
+                       "                if (evaluated) evaluated->setBit(k);\n"
+                       "            }\n"
+                       "        }\n";
+            }
+            if (node->cold().minContains >= 0) {
+                out += "        if (count < " + QString::number(node->cold().minContains) + ") {\n"
+                       "            return setError(errorMessage, QString(" + str("Pas assez d'éléments correspondant à 'contains': %1 < %2.")
+                       + ").arg(count).arg(" + QString::number(node->cold().minContains) + "));\n        }\n";
+            }
+            if (node->cold().maxContains >= 0) {
+                out += "        if (count > " + QString::number(node->cold().maxContains) + ") {\n"
+                       "            return setError(errorMessage, QString(" + str("Trop d'éléments correspondant à 'contains': %1 > %2.")
+                       + ").arg(count).arg(" + QString::number(node->cold().maxContains) + "));\n        }\n";
+            }
+            if (node->cold().minContains < 0 && node->cold().maxContains < 0) {
+                out += "        if (count == 0) {\n"
+                       "            return setError(errorMessage, " + str("Aucun élément ne satisfait 'contains'.") + ");\n        }\n";
+            }
+            out += "    }\n";
+        }
+        return out + "    return true;\n    }\n";
+    }
+
+    QString emitUnevaluated(const SwJsonSchema *node)
+    {
+        QString out = "    QBitArray *evaluated = ctx.evaluated;\n"
+                      "    if (!evaluated) {\n        return true;\n    }\n";
+        if (node->cold().unevaluatedPropertiesSchema) {
+            out += "    if (value.isObject()) {\n"
+                   "        const QJsonObject obj = value.toObject();\n"
+                   "        for (auto it = obj.begin(); it != obj.end(); ++it) {\n"
+                   "            if (evaluated->testBit(int(it - obj.begin()))) {\n                continue;\n            }\n";
+            if (node->cold().unevaluatedPropertiesSchema->rejectsAll()) {
+                out += "            return setError(errorMessage, QString(" + str("Propriété '%1' non autorisée (unevaluatedProperties=false).")
+                       + ").arg(it.key()));\n";
+            } else {
+                out += childCheck(node->cold().unevaluatedPropertiesSchema.data(), "it.value()",
+                                  "Propriété '%1' invalide (unevaluatedProperties): %2", ".arg(it.key())", "            ");
+            }
+            out += "        }\n"
+                   "        evaluated->fill(true);\n"
+                   "        return true;\n"
+                   "    }\n";
+        }
+        if (node->cold().unevaluatedItemsSchema) {
+            out += "    if (value.isArray()) {\n"
+                   "        const QJsonArray arr = value.toArray();\n"
+                   "        for (int i = 0; i < arr.size(); ++i) {\n"
+                   "            if (evaluated->testBit(i)) {\n                continue;\n            }\n";
+            if (node->cold().unevaluatedItemsSchema->rejectsAll()) {
+                out += "            return setError(errorMessage, QString(" + str("Element [%1] non autorisé (unevaluatedItems=false).")
+                       + ").arg(i));\n";
+            } else {
+                out += childCheck(node->cold().unevaluatedItemsSchema.data(), "arr[i]",
+                                  "Element [%1] invalide (unevaluatedItems): %2", ".arg(i)", "            ");
+            }
+            out += "        }\n"
+                   "        evaluated->fill(true);\n"
+                   "        return true;\n"
+                   "    }\n";
+        }
+        return out + "    return true;\n";
+    }
+
+    const SwJsonSchema *m_root;
+    QString m_sourceName;
+    QHash<const SwJsonSchema*, int> m_ids;
+    QVector<const SwJsonSchema*> m_order;
+    QSet<const SwJsonSchema*> m_cyclic;
+};
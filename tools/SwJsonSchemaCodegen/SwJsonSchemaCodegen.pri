@@ -0,0 +1,26 @@
+# Génération des validateurs C++ à la compilation.
+#
+# Dans le .pro de l'application :
+#
+#   SWJSONSCHEMA_CODEGEN = /chemin/vers/SwJsonSchemaCodegen   # exécutable compilé (SwJsonSchemaCodegen.pro)
+#   JSON_SCHEMAS += schemas/order.json schemas/customer.json
+#   include(/chemin/vers/tools/SwJsonSchemaCodegen/SwJsonSchemaCodegen.pri)
+#
+# Chaque schéma produit <nom>_validator.h (fonction validate_<nom>) dans le répertoire
+# de compilation, régénéré dès que le .json, un fichier atteint par ses $ref externes
+# (depend_command, "SwJsonSchemaCodegen --deps"), SwJsonSchema.h ou le générateur change.
+# SWJSONSCHEMA_CODEGEN_FLAGS transmet des options (ex: --keyword dividedBy --regex-engine linear).
+
+isEmpty(SWJSONSCHEMA_CODEGEN): SWJSONSCHEMA_CODEGEN = SwJsonSchemaCodegen
+
+INCLUDEPATH += $$PWD/../.. $$OUT_PWD
+
+swjsonschema_codegen.input = JSON_SCHEMAS
+swjsonschema_codegen.output = ${QMAKE_FILE_BASE}_validator.h
+swjsonschema_codegen.commands = $$shell_path($$SWJSONSCHEMA_CODEGEN) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT} $$SWJSONSCHEMA_CODEGEN_FLAGS
+swjsonschema_codegen.depends = $$SWJSONSCHEMA_CODEGEN $$PWD/../../SwJsonSchema.h
+swjsonschema_codegen.depend_command = $$shell_path($$SWJSONSCHEMA_CODEGEN) --deps ${QMAKE_FILE_IN} $$SWJSONSCHEMA_CODEGEN_FLAGS
+swjsonschema_codegen.variable_out = HEADERS
+swjsonschema_codegen.CONFIG += no_link target_predeps
+swjsonschema_codegen.name = SwJsonSchemaCodegen ${QMAKE_FILE_IN}
+QMAKE_EXTRA_COMPILERS += swjsonschema_codegen
@@ -0,0 +1,16 @@
+QT       += core concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = SwJsonSchemaCodegen
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    SwJsonSchemaCodeGenerator.h \
+    ../../SwJsonSchema.h
@@ -0,0 +1,152 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+
+#include "SwJsonSchemaCodeGenerator.h"
+
+//--------------------------------------------------------------------
+// SwJsonSchemaCodegen <schema.json> <sortie.h> [--name <fonction>] [--keyword <mot-clé>]...
+//                     [--regex-engine <backtracking|linear|fallback>] [--depfile <fichier.d>]
+// SwJsonSchemaCodegen --deps <schema.json>
+//
+//   --name          nom de la fonction générée (défaut : validate_<nom du fichier>)
+//   --keyword       mot-clé personnalisé à conserver ; le validateur généré appelle la
+//                   lambda enregistrée par SwJsonSchema::registerCustomKeyword()
+//   --regex-engine  moteur des "pattern" / "patternProperties" du code généré
+//                   (défaut : backtracking, voir SwJsonSchema::setRegexEngine())
+//   --depfile       écrit aussi "<sortie.h>: <fichiers référencés>" (format Makefile,
+//                   DEPFILE de CMake / Ninja)
+//   --deps          affiche, un par ligne, les fichiers atteints par des $ref externes
+//                   (depend_command de qmake) ; n'écrit rien
+//--------------------------------------------------------------------
+
+/// Fichiers existants atteints depuis `schemaPath` par des $ref externes, racine exclue.
+static QStringList externalDocuments(const QString &schemaPath)
+{
+    SwJsonSchemaLoader loader;
+    loader.load(QStringList() << schemaPath);
+    QStringList documents;
+    // La racine est le premier document rencontré
+    for (const QString &path : loader.documents().mid(1)) {
+        if (QFileInfo::exists(path)) {
+            documents << QFileInfo(path).absoluteFilePath();
+        }
+    }
+    return documents;
+}
+
+static QString escapeMakePath(QString path)
+{
+    return path.replace(' ', "\\ ");
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    QString functionName;
+    QStringList keywords;
+    QString regexEngine;
+    QString depfilePath;
+    bool depsOnly = false;
+    for (int i = 0; i < args.size();) {
+        if (args.at(i) == "--deps") {
+            depsOnly = true;
+            args.removeAt(i);
+        } else if ((args.at(i) == "--name" || args.at(i) == "--keyword" || args.at(i) == "--regex-engine"
+                    || args.at(i) == "--depfile") && i + 1 < args.size()) {
+            if (args.at(i) == "--name") {
+                functionName = args.at(i + 1);
+            } else if (args.at(i) == "--regex-engine") {
+                regexEngine = args.at(i + 1);
+            } else if (args.at(i) == "--depfile") {
+                depfilePath = args.at(i + 1);
+            } else {
+                keywords << args.at(i + 1);
+            }
+            args.erase(args.begin() + i, args.begin() + i + 2);
+        } else {
+            ++i;
+        }
+    }
+    if (args.size() != (depsOnly ? 1 : 2)) {
+        qWarning().noquote() << "Usage : SwJsonSchemaCodegen <schema.json> <sortie.h> [--name <fonction>] [--keyword <mot-clé>]..."
+                                " [--regex-engine <backtracking|linear|fallback>] [--depfile <fichier.d>]\n"
+                                "        SwJsonSchemaCodegen --deps <schema.json>";
+        return 2;
+    }
+    const QString schemaPath = args.at(0);
+    const QString outputPath = depsOnly ? QString() : args.at(1);
+
+    // Les mots-clés doivent être connus au chargement pour que leurs règles soient lues ;
+    // la lambda effective est celle enregistrée par l'application qui utilise le validateur.
+    for (const QString &keyword : keywords) {
+        SwJsonSchema::registerCustomKeyword(keyword, [](const QJsonValue &, const QJsonValue &, QString *) {
+            return true;
+        });
+    }
+
+    if (regexEngine == "linear") {
+        SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::Linear);
+    } else if (regexEngine == "fallback") {
+        SwJsonSchema::setRegexEngine(SwJsonSchema::RegexEngine::LinearWithFallback);
+    }
+
+    if (depsOnly) {
+        QTextStream out(stdout);
+        for (const QString &path : externalDocuments(schemaPath)) {
+            out << path << '\n';
+        }
+        return 0;
+    }
+
+    SwJsonSchema schema(schemaPath);
+    for (const QString &unsupported : schema.unsupportedPatterns()) {
+        qWarning().noquote() << "Motif hors du moteur linéaire :" << unsupported;
+    }
+    if (!schema.isValide()) {
+        qWarning().noquote() << "Schéma invalide ou illisible :" << schemaPath;
+        return 1;
+    }
+
+    if (functionName.isEmpty()) {
+        functionName = SwJsonSchemaCodeGenerator::functionNameFor(QFileInfo(schemaPath).completeBaseName());
+    }
+
+    SwJsonSchemaCodeGenerator generator(schema);
+    generator.setSourceName(QFileInfo(schemaPath).fileName());
+    const QByteArray code = generator.generate(functionName).toUtf8();
+
+    // Toujours réécrit : make compare les dates, une sortie laissée plus ancienne que
+    // SwJsonSchema.h ou que le générateur relancerait la génération à chaque compilation.
+    QDir().mkpath(QFileInfo(outputPath).absolutePath());
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning().noquote() << "Impossible d'écrire :" << outputPath;
+        return 1;
+    }
+    output.write(code);
+    output.close();
+
+    if (!depfilePath.isEmpty()) {
+        QStringList rule(escapeMakePath(outputPath) + ":");
+        rule << escapeMakePath(QFileInfo(schemaPath).absoluteFilePath());
+        for (const QString &path : externalDocuments(schemaPath)) {
+            rule << escapeMakePath(path);
+        }
+        QFile depfile(depfilePath);
+        if (!depfile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning().noquote() << "Impossible d'écrire :" << depfilePath;
+            return 1;
+        }
+        depfile.write(rule.join(" \\\n    ").toUtf8() + '\n');
+    }
+
+    qDebug().noquote() << QString("%1 : %2 noeuds -> %3").arg(functionName).arg(generator.nodeCount()).arg(outputPath);
+    return 0;
+}
@@ -0,0 +1,55 @@
+QT       += core concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = SwJsonSchemaCodegenCheck
+
+# Génère un validateur par répertoire tests/test_<n> (produit par les .bat de tests/),
+# puis compare chacun à l'interpréteur sur les data_success / data_fail du test.
+#
+#   SWJSONSCHEMA_CODEGEN = /chemin/vers/SwJsonSchemaCodegen   # exécutable compilé
+#   SWJSONSCHEMA_TESTS   = /chemin/vers/tests                 # défaut : tests/ du dépôt
+#
+# Les répertoires chargés par SwJsonSchemaLoader (loader.json, $ref cycliques entre
+# fichiers) sont ignorés : le générateur charge le schéma avec SwJsonSchema.
+
+isEmpty(SWJSONSCHEMA_CODEGEN): SWJSONSCHEMA_CODEGEN = SwJsonSchemaCodegen
+isEmpty(SWJSONSCHEMA_TESTS): SWJSONSCHEMA_TESTS = $$PWD/../../tests
+
+INCLUDEPATH += $$PWD/../.. $$OUT_PWD
+
+TEST_DIRS = $$files($$SWJSONSCHEMA_TESTS/test_*)
+isEmpty(TEST_DIRS): error("Aucun répertoire test_* dans $$SWJSONSCHEMA_TESTS : exécuter d'abord les .bat de tests/")
+
+VALIDATOR_INCLUDES =
+VALIDATOR_TABLE =
+for(dir, TEST_DIRS) {
+    exists($$dir/loader.json): next()
+    test = $$basename(dir)
+    compiler = codegen_$$test
+
+    SCHEMA_$${test} = $$dir/main.json
+    $${compiler}.input = SCHEMA_$${test}
+    $${compiler}.output = $${test}_validator.h
+    $${compiler}.commands = $$shell_path($$SWJSONSCHEMA_CODEGEN) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT} --name validate_$$test --keyword dividedBy
+    $${compiler}.depends = $$SWJSONSCHEMA_CODEGEN $$PWD/../../SwJsonSchema.h
+    $${compiler}.depend_command = $$shell_path($$SWJSONSCHEMA_CODEGEN) --deps ${QMAKE_FILE_IN}
+    $${compiler}.variable_out = HEADERS
+    $${compiler}.CONFIG += no_link target_predeps
+    $${compiler}.name = SwJsonSchemaCodegen $$test
+    QMAKE_EXTRA_COMPILERS += $$compiler
+
+    VALIDATOR_INCLUDES += "$${LITERAL_HASH}include <$${test}_validator.h>"
+    VALIDATOR_TABLE += "SWJSONSCHEMA_GENERATED_VALIDATOR($$test)"
+}
+
+write_file($$OUT_PWD/generated_validators.h, VALIDATOR_INCLUDES)
+write_file($$OUT_PWD/generated_validators_table.h, VALIDATOR_TABLE)
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../SwJsonSchema.h
@@ -0,0 +1,174 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <cmath>
+
+#include "SwJsonSchema.h"
+#include "generated_validators.h"
+
+//--------------------------------------------------------------------
+// SwJsonSchemaCodegenCheck [répertoire de tests] [--iterations <n>]
+//
+// Pour chaque tests/test_<n> compilé par SwJsonSchemaCodegenCheck.pro :
+//   - valide les data_success / data_fail avec le validateur généré et avec
+//     SwJsonSchema::validate() : résultat attendu, même résultat, même message d'erreur ;
+//   - mesure le débit des deux (sans message d'erreur, `iterations` passes sur les données).
+// Affiche le temps moyen par validation et l'accélération ; code de sortie 1 si le
+// validateur généré s'écarte de l'interpréteur ou du résultat attendu.
+//--------------------------------------------------------------------
+
+struct GeneratedValidator
+{
+    const char *test;
+    bool (*validate)(const QJsonValue &value, QString *errorMessage);
+};
+
+#define SWJSONSCHEMA_GENERATED_VALIDATOR(test) { #test, validate_##test },
+static const GeneratedValidator generatedValidators[] = {
+#include "generated_validators_table.h"
+};
+#undef SWJSONSCHEMA_GENERATED_VALIDATOR
+
+struct Sample
+{
+    QString    fileName;
+    QJsonValue value;
+    bool       expected;
+};
+
+static QJsonValue readJson(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonValue();
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    return doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+}
+
+static QList<Sample> readSamples(const QDir &testDir)
+{
+    QList<Sample> samples;
+    for (const QString &dataDir : {QString("data_success"), QString("data_fail")}) {
+        QDir dir(testDir.absoluteFilePath(dataDir));
+        for (const QString &file : dir.entryList(QStringList() << "*.json", QDir::Files)) {
+            samples << Sample{dataDir + "/" + file, readJson(dir.absoluteFilePath(file)), dataDir == "data_success"};
+        }
+    }
+    return samples;
+}
+
+static QString outcome(bool valid)
+{
+    return valid ? "valide" : "invalide";
+}
+
+/// Temps moyen (ns) d'une validation sans message d'erreur, sur `iterations` passes.
+template <typename Validate>
+static double nsPerValidation(const QList<Sample> &samples, int iterations, Validate validate)
+{
+    int valid = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        for (const Sample &sample : samples) {
+            valid += validate(sample.value) ? 1 : 0;
+        }
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    Q_UNUSED(valid);
+    return samples.isEmpty() ? 0.0 : double(elapsed) / (double(iterations) * samples.size());
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    int iterations = 2000;
+    int iterIdx = args.indexOf("--iterations");
+    if (iterIdx >= 0 && iterIdx + 1 < args.size()) {
+        iterations = qMax(1, args.at(iterIdx + 1).toInt());
+        args.erase(args.begin() + iterIdx, args.begin() + iterIdx + 2);
+    }
+    const QString testsRoot = !args.isEmpty() ? args.first() : "tests";
+
+    // Même mot-clé personnalisé que le lanceur de tests : le code généré appelle cette lambda
+    SwJsonSchema::registerCustomKeyword("dividedBy", [](const QJsonValue& rules, const QJsonValue& data, QString* error) -> bool {
+        if(!data.isDouble()){
+            *error = "Value is not a number";
+            return false;
+        }
+        if(!rules.isObject() || !rules.toObject().contains("operator")){
+            *error = "Schema is wrong: shall contain \"dividedBy\":{\"operator\": number}";
+            return false;
+        }
+        int multiple = rules.toObject()["operator"].toInt();
+        double value = data.toDouble();
+
+        if (multiple != 0 && std::fmod(value, multiple) == 0) {
+            return true;
+        }
+        *error = QString("value %1 is not a multiple of %2").arg(value).arg(multiple);
+        return false;
+    });
+
+    int checked = 0;
+    int mismatches = 0;
+    double totalInterpreted = 0.0;
+    double totalGenerated = 0.0;
+    qDebug().noquote() << QString("%1  %2  %3  %4  %5").arg("test", -10).arg("données", 8)
+                              .arg("interpréteur", 14).arg("généré", 14).arg("accélération");
+    for (const GeneratedValidator &generated : generatedValidators) {
+        const QDir testDir(QDir(testsRoot).absoluteFilePath(generated.test));
+        SwJsonSchema schema(testDir.absoluteFilePath("main.json"));
+        if (!schema.isValide()) {
+            ++mismatches;
+            qDebug().noquote() << QString("%1  schéma illisible : %2").arg(generated.test, -10).arg(testDir.absoluteFilePath("main.json"));
+            continue;
+        }
+
+        const QList<Sample> samples = readSamples(testDir);
+        for (const Sample &sample : samples) {
+            QString interpretedError;
+            QString generatedError;
+            const bool interpreted = schema.validate(sample.value, &interpretedError);
+            const bool result = generated.validate(sample.value, &generatedError);
+            const bool fast = generated.validate(sample.value, nullptr);
+            ++checked;
+            if (result != interpreted || fast != result || result != sample.expected
+                || (!result && generatedError != interpretedError)) {
+                ++mismatches;
+                qDebug().noquote() << QString("  écart sur %1/%2 : interpréteur %3 \"%4\", généré %5 \"%6\", attendu %7")
+                                          .arg(generated.test, sample.fileName)
+                                          .arg(outcome(interpreted), interpretedError)
+                                          .arg(outcome(result), generatedError, outcome(sample.expected));
+            }
+        }
+
+        const double nsInterpreted = nsPerValidation(samples, iterations, [&schema](const QJsonValue &value) {
+            return schema.validate(value);
+        });
+        const double nsGenerated = nsPerValidation(samples, iterations, [&generated](const QJsonValue &value) {
+            return generated.validate(value, nullptr);
+        });
+        totalInterpreted += nsInterpreted;
+        totalGenerated += nsGenerated;
+        qDebug().noquote() << QString("%1  %2  %3 ns  %4 ns  x%5").arg(generated.test, -10).arg(samples.size(), 8)
+                                  .arg(nsInterpreted, 11, 'f', 0).arg(nsGenerated, 11, 'f', 0)
+                                  .arg(nsGenerated > 0.0 ? nsInterpreted / nsGenerated : 0.0, 0, 'f', 1);
+    }
+    qDebug().noquote() << QString("%1 validateurs, %2 données, %3 écarts ; somme des moyennes : "
+                                  "interpréteur %4 ns, généré %5 ns")
+                              .arg(int(sizeof(generatedValidators) / sizeof(generatedValidators[0])))
+                              .arg(checked).arg(mismatches)
+                              .arg(totalInterpreted, 0, 'f', 0).arg(totalGenerated, 0, 'f', 0);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+QT       += core concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = SwJsonSchemaRegexBench
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../SwJsonSchema.h
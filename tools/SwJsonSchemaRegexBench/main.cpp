@@ -0,0 +1,226 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include "SwJsonSchema.h"
+
+//--------------------------------------------------------------------
+// SwJsonSchemaRegexBench [répertoire de tests] [--iterations <n>]
+//
+// Compare les deux moteurs de SwJsonSchemaRegex (QRegularExpression et automate
+// linéaire) sur :
+//   - les motifs "pattern" / "patternProperties" des tests/<n>/main.json, appliqués
+//     aux chaînes et clés des data_success / data_fail du même test ;
+//   - des motifs usuels de "format" ;
+//   - des motifs ReDoS classiques sur des textes adverses de longueur croissante.
+// Affiche le temps moyen par recherche et les désaccords ; code de sortie 1 si les deux
+// moteurs divergent sur un texte.
+//--------------------------------------------------------------------
+
+struct BenchCase
+{
+    QString     source;
+    QString     pattern;
+    QStringList subjects;
+};
+
+static void collectPatterns(const QJsonValue &value, QStringList &patterns)
+{
+    if (value.isArray()) {
+        for (const QJsonValue &item : value.toArray()) {
+            collectPatterns(item, patterns);
+        }
+        return;
+    }
+    if (!value.isObject()) {
+        return;
+    }
+    const QJsonObject obj = value.toObject();
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        if (it.key() == "pattern" && it.value().isString()) {
+            patterns << it.value().toString();
+        } else if (it.key() == "patternProperties" && it.value().isObject()) {
+            patterns << it.value().toObject().keys();
+        }
+        collectPatterns(it.value(), patterns);
+    }
+}
+
+static void collectStrings(const QJsonValue &value, QStringList &strings)
+{
+    if (value.isString()) {
+        strings << value.toString();
+    } else if (value.isArray()) {
+        for (const QJsonValue &item : value.toArray()) {
+            collectStrings(item, strings);
+        }
+    } else if (value.isObject()) {
+        const QJsonObject obj = value.toObject();
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            strings << it.key();
+            collectStrings(it.value(), strings);
+        }
+    }
+}
+
+static QJsonValue readJson(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonValue();
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    return doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+}
+
+static QList<BenchCase> testCorpus(const QString &testsRoot)
+{
+    QList<BenchCase> cases;
+    QDir rootDir(testsRoot);
+    for (const QString &subDir : rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QDir testDir(rootDir.absoluteFilePath(subDir));
+        QStringList patterns;
+        collectPatterns(readJson(testDir.absoluteFilePath("main.json")), patterns);
+        if (patterns.isEmpty()) {
+            continue;
+        }
+        QStringList subjects;
+        for (const QString &dataDir : {QString("data_success"), QString("data_fail")}) {
+            QDir dir(testDir.absoluteFilePath(dataDir));
+            for (const QString &file : dir.entryList(QStringList() << "*.json", QDir::Files)) {
+                collectStrings(readJson(dir.absoluteFilePath(file)), subjects);
+            }
+        }
+        subjects.removeDuplicates();
+        patterns.removeDuplicates();
+        for (const QString &pattern : patterns) {
+            cases << BenchCase{subDir, pattern, subjects};
+        }
+    }
+    return cases;
+}
+
+static QList<BenchCase> formatCorpus()
+{
+    const QStringList subjects = {
+        "user@example.com", "not an email", "2024-02-29T12:30:00Z", "2024-02-29", "12:30:00+01:00",
+        "api.example.com", "-bad-.host", "550e8400-e29b-41d4-a716-446655440000", "+33 (0)1 23 45 67 89",
+        "https://example.com/path?q=1", "4111111111111111", QString(200, 'a') + "@" + QString(200, 'b')
+    };
+    QList<BenchCase> cases;
+    const QStringList patterns = {
+        R"(^[a-zA-Z0-9._%+\-]+@[a-zA-Z0-9.\-]+\.[a-zA-Z]{2,}$)",
+        R"(^(?<year>\d{4})-(?<month>\d{2})-(?<day>\d{2})T(?<hour>\d{2}):(?<min>\d{2}):(?<sec>\d{2})(\.\d+)?(Z|[+\-]\d{2}:\d{2})$)",
+        R"(^(?<hour>\d{2}):(?<min>\d{2})(:(?<sec>\d{2})(\.\d+)?)?(Z|[+\-]\d{2}:\d{2})?$)",
+        R"(^([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?)(\.([a-zA-Z0-9](?:[a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?))*$)",
+        R"(^[0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12}$)",
+        R"(^[A-Za-z][A-Za-z0-9+\-.]*:\/\/?([^\s/]+)(\/\S*)?$)",
+        R"(^[+\-()0-9\s]+$)",
+        R"(^\d{13,19}$)"
+    };
+    for (const QString &pattern : patterns) {
+        cases << BenchCase{"format", pattern, subjects};
+    }
+    return cases;
+}
+
+static QList<BenchCase> redosCorpus()
+{
+    QStringList subjects;
+    for (int length : {8, 12, 16, 20, 24}) {
+        subjects << QString(length, 'a') + "!";
+    }
+    QList<BenchCase> cases;
+    const QStringList patterns = {
+        R"(^(a+)+$)",
+        R"(^(a|aa)*$)",
+        R"(^(a|a?)+$)",
+        R"(^(\w+\s?)*$)",
+        R"(^([a-zA-Z0-9]+)*@)",
+        R"((a*)*b)"
+    };
+    for (const QString &pattern : patterns) {
+        cases << BenchCase{"redos", pattern, subjects};
+    }
+    return cases;
+}
+
+/// Temps moyen (ns) d'une recherche de `regex` sur chacun des `subjects`.
+static double nsPerMatch(const SwJsonSchemaRegex &regex, const QStringList &subjects, int iterations)
+{
+    int found = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        for (const QString &subject : subjects) {
+            found += regex.match(subject) ? 1 : 0;
+        }
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    Q_UNUSED(found);
+    return subjects.isEmpty() ? 0.0 : double(elapsed) / (double(iterations) * subjects.size());
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    int iterations = 200;
+    int iterIdx = args.indexOf("--iterations");
+    if (iterIdx >= 0 && iterIdx + 1 < args.size()) {
+        iterations = qMax(1, args.at(iterIdx + 1).toInt());
+        args.erase(args.begin() + iterIdx, args.begin() + iterIdx + 2);
+    }
+    const QString testsRoot = !args.isEmpty() ? args.first() : "tests";
+
+    QList<BenchCase> cases = testCorpus(testsRoot);
+    cases += formatCorpus();
+    cases += redosCorpus();
+
+    int rejected = 0;
+    int disagreements = 0;
+    double totalBacktracking = 0.0;
+    double totalLinear = 0.0;
+    qDebug().noquote() << QString("%1  %2  %3  %4  %5").arg("source", -8).arg("motif", -48)
+                              .arg("backtracking", 14).arg("linéaire", 14).arg("automate");
+    for (const BenchCase &bench : cases) {
+        const SwJsonSchemaRegex backtracking(bench.pattern, SwJsonSchemaRegex::Backtracking);
+        const SwJsonSchemaRegex linear(bench.pattern, SwJsonSchemaRegex::Linear);
+        QString shown = bench.pattern;
+        if (shown.size() > 48) {
+            shown = shown.left(45) + "...";
+        }
+        if (!linear.isValid()) {
+            ++rejected;
+            qDebug().noquote() << QString("%1  %2  refusé : %3").arg(bench.source, -8).arg(shown, -48).arg(linear.errorString());
+            continue;
+        }
+        // Les textes ReDoS ne sont mesurés qu'une fois : c'est le pire cas qui compte
+        const int rounds = bench.source == "redos" ? 1 : iterations;
+        for (const QString &subject : bench.subjects) {
+            if (backtracking.isValid() && backtracking.match(subject) != linear.match(subject)) {
+                ++disagreements;
+                qDebug().noquote() << QString("  désaccord sur /%1/ : \"%2\"").arg(bench.pattern, subject.left(60));
+            }
+        }
+        const double nsBacktracking = nsPerMatch(backtracking, bench.subjects, rounds);
+        const double nsLinear = nsPerMatch(linear, bench.subjects, rounds);
+        totalBacktracking += nsBacktracking;
+        totalLinear += nsLinear;
+        qDebug().noquote() << QString("%1  %2  %3 ns  %4 ns  %5").arg(bench.source, -8).arg(shown, -48)
+                                  .arg(nsBacktracking, 11, 'f', 0).arg(nsLinear, 11, 'f', 0)
+                                  .arg(linear.isDeterministic() ? "DFA" : "NFA");
+    }
+    qDebug().noquote() << QString("%1 motifs, %2 refusés par le moteur linéaire, %3 désaccords ; "
+                                  "somme des moyennes : backtracking %4 ns, linéaire %5 ns")
+                              .arg(cases.size()).arg(rejected).arg(disagreements)
+                              .arg(totalBacktracking, 0, 'f', 0).arg(totalLinear, 0, 'f', 0);
+    return disagreements == 0 ? 0 : 1;
+}